@@ -1,11 +1,17 @@
 #include "anemone/anemone.hpp"
 
+#include <signal.h>
+#include <pthread.h>
+
 #include <spdlog/spdlog.h>
 
+#include "anemone/util/realtime.hpp"
+
 
 Anemone::Anemone(std::string config_path,
                  std::shared_ptr<GridDevice> grid_device,
-                 std::shared_ptr<MidiDeviceFactory> midi_device_factory)
+                 std::shared_ptr<MidiDeviceFactory> midi_device_factory,
+                 std::shared_ptr<ClockDevice> clock_device)
 {
   spdlog::set_level(spdlog::level::info);
   spdlog::set_pattern("[%H:%M:%S:%e] [thread %t] %^[%l]%$ %v");
@@ -26,7 +32,7 @@ Anemone::Anemone(std::string config_path,
 
   // initialize io
   spdlog::info("  initializing \tio");
-  io = std::make_shared<IO>(IO(config, grid_device, midi_device_factory, state));
+  io = std::make_shared<IO>(config, grid_device, midi_device_factory, clock_device, state);
 
   // initialize controllers
   spdlog::info("  initializing \tcontrollers");
@@ -40,16 +46,44 @@ Anemone::Anemone(std::string config_path,
 void Anemone::run() {
   spdlog::info("============= connecting ================");
 
+  // block SIGUSR1 before spawning any threads (they inherit the mask), so that it is
+  // only ever picked up by the loop below.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGUSR1);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
   state->connect();
 
+  // from now on, state is mutated by the store's writer thread only.
+  state->store->start();
+
+  // lock memory & reserve heap before spinning up the real-time threads.
+  if (config->at("realtime")["enabled"].as<bool>(false)) {
+    lock_memory(config->at("realtime")["heap_reserve"].as<std::size_t>(16) * 1024 * 1024);
+  }
+
   io->connect();
 
   controllers->connect();
 
   ui->connect();
 
+  // report the clock timing stats on SIGUSR1 and/or periodically.
+  auto stats_interval = config->at("clock")["stats_interval"].as<unsigned int>(0);
+
   // TODO deal with threads....
   while (true) {
-    std::this_thread::sleep_for(std::chrono::minutes(5));
+    struct timespec timeout = { .tv_sec = stats_interval > 0 ? stats_interval : 300, .tv_nsec = 0 };
+
+    int signal = sigtimedwait(&signals, nullptr, &timeout);
+
+    if (signal == SIGUSR1) {
+      io->log_stats(false);
+      ui->log_stats();
+    } else if (stats_interval > 0) {
+      io->log_stats(true);
+      ui->log_stats();
+    }
   }
 }
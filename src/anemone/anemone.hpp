@@ -18,7 +18,8 @@ class Anemone {
 public:
   Anemone(std::string config_path,
           std::shared_ptr<GridDevice>,
-          std::shared_ptr<MidiDeviceFactory>);
+          std::shared_ptr<MidiDeviceFactory>,
+          std::shared_ptr<ClockDevice>);
   
   void run();
 
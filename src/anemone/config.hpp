@@ -97,6 +97,15 @@ public:
     return yml.as<T>();
   };
 
+  /// @brief same as `as`, but returns the provided fallback if the field is undefined.
+  ///
+  /// @param fallback   the value to return if this field is not configured.
+  ///
+  template<typename T>
+  T as(const T& fallback) {
+    return yml.as<T>(fallback);
+  };
+
   /// @brief given a name of a layout section within the config, returns a parsed
   /// grid_region_t struct.
   ///
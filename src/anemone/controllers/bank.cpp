@@ -1,4 +1,5 @@
 #include "anemone/controllers/bank.hpp"
+#include "anemone/controllers/part.hpp"
 
 
 BankController::BankController(std::shared_ptr<IO> io, std::shared_ptr<State> state) {
@@ -14,7 +15,7 @@ BankController::BankController(std::shared_ptr<IO> io, std::shared_ptr<State> st
 
   // TODO subscribe to combines observables
   selected_bank_index.subscribe
-    ([state] (unsigned int selected_bank_idx) {
+    (state->store->dispatching<unsigned int>([state] (unsigned int selected_bank_idx) {
        auto rendered_instrument = state->instruments->rendered.get_value();
        auto current_part_idx = rendered_instrument->status.part.under_edit.get_value()->id;
        
@@ -25,5 +26,7 @@ BankController::BankController(std::shared_ptr<IO> io, std::shared_ptr<State> st
 
        rendered_instrument->status.part.under_edit.get_subscriber().on_next(part);
        rendered_instrument->status.bank.under_edit.get_subscriber().on_next(selected_bank_idx);
-     });
+
+       play_at_end_of_sequence(state, rendered_instrument, part, selected_bank_idx);
+     }));
 }
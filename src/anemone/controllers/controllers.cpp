@@ -14,6 +14,7 @@ void Controllers::connect() {
   shift             = std::make_unique<ShiftController>(io, state);
   step              = std::make_unique<StepController>(io, state);
   play_pause        = std::make_unique<PlayPauseController>(io, state);
+  transport         = std::make_unique<TransportController>(io, state);
   page              = std::make_unique<PageController>(io, state);
   part              = std::make_unique<PartController>(io, state);
   bank              = std::make_unique<BankController>(io, state);
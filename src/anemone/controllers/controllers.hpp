@@ -20,6 +20,7 @@
 #include "anemone/controllers/shift.hpp"
 #include "anemone/controllers/step.hpp"
 #include "anemone/controllers/play_pause.hpp"
+#include "anemone/controllers/transport.hpp"
 #include "anemone/controllers/page.hpp"
 #include "anemone/controllers/part.hpp"
 #include "anemone/controllers/bank.hpp"
@@ -60,6 +61,7 @@ private:
   std::unique_ptr<ShiftController>            shift;
   std::unique_ptr<StepController>             step;
   std::unique_ptr<PlayPauseController>        play_pause;
+  std::unique_ptr<TransportController>        transport;
   std::unique_ptr<PageController>             page;
   std::unique_ptr<PartController>             part;
   std::unique_ptr<BankController>             bank;
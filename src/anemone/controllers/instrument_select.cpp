@@ -13,8 +13,8 @@ InstrumentSelectController::InstrumentSelectController(std::shared_ptr<IO> io, s
               });
 
   selection_events
-    .subscribe([state] (unsigned int idx) {
+    .subscribe(state->store->dispatching<unsigned int>([state] (unsigned int idx) {
                  auto selected_instrument = state->instruments->by_index[idx];
                  state->instruments->render(selected_instrument->name);
-               });
+               }));
 }
@@ -18,7 +18,7 @@ LastStepController::LastStepController(std::shared_ptr<IO> io, std::shared_ptr<S
                      e.type    == GridEvent::Unpressed;
                  });
   
-  last_step_press_events.subscribe([state] (grid_event_t e) {
+  last_step_press_events.subscribe(state->store->dispatching<grid_event_t>([state] (grid_event_t e) {
                         auto rendered_instrument = state->instruments->rendered.get_value();
                         auto rendered_part = rendered_instrument->status.part.under_edit.get_value();
                         auto last_page = rendered_part->page.last.get_value();
@@ -35,8 +35,7 @@ LastStepController::LastStepController(std::shared_ptr<IO> io, std::shared_ptr<S
                             follow_cursor.get_subscriber().on_next(true);
 
                             // make playing, rendered, and under edit page equal
-                            auto page_size = state->layouts->sequencer->steps->size();
-                            auto page_in_playback = granular_to_paged_step(rendered_part->step.current.get_value(), page_size).page;
+                            auto page_in_playback = rendered_part->page.in_playback.get();
                             rendered_part->page.under_edit.get_subscriber().on_next(page_in_playback);
                             rendered_part->page.rendered.get_subscriber().on_next(page_in_playback);
                           }
@@ -47,9 +46,9 @@ LastStepController::LastStepController(std::shared_ptr<IO> io, std::shared_ptr<S
                           // make show last step true
                           rendered_part->step.show_last.get_subscriber().on_next(true);  
                         }
-                      });
+                      }));
 
-  last_step_unpress_events.subscribe([state] (grid_event_t e) {
+  last_step_unpress_events.subscribe(state->store->dispatching<grid_event_t>([state] (grid_event_t e) {
                                        auto rendered_instrument = state->instruments->rendered.get_value();
                                        auto rendered_part = rendered_instrument->status.part.under_edit.get_value();
                                        auto page_under_edit = rendered_part->page.under_edit.get_value();
@@ -62,5 +61,5 @@ LastStepController::LastStepController(std::shared_ptr<IO> io, std::shared_ptr<S
                                          // make show last step false.
                                          rendered_part->step.show_last.get_subscriber().on_next(false); 
                                        }
-                                     });
+                                     }));
 }
@@ -1,9 +1,21 @@
 #include "anemone/controllers/part.hpp"
 
 
-PartController::PartController(std::shared_ptr<IO> io, std::shared_ptr<State> state) {
-  // TODO support "wait for end of sequence"
+namespace {
+  /// @brief the bank & part in playback, posted from the tick thread.
+  ///
+  /// @param bank_and_part   the part, and its bank (in the upper half).
+  ///
+  void in_playback(Instrument* instrument, std::uint64_t bank_and_part) {
+    auto part = instrument->parts[static_cast<part_idx_t>(bank_and_part)];
+    auto bank = static_cast<bank_idx_t>(bank_and_part >> 32);
+
+    instrument->status.bank.in_playback.get_subscriber().on_next(bank);
+    instrument->status.part.in_playback.get_subscriber().on_next(part);
+  }
+}
 
+PartController::PartController(std::shared_ptr<IO> io, std::shared_ptr<State> state) {
   auto selected_part_index = io->grid_events
     | rx::filter([] (grid_event_t e) {
                    return
@@ -16,7 +28,7 @@ PartController::PartController(std::shared_ptr<IO> io, std::shared_ptr<State> st
 
   // TODO subscribe to combines observables
   selected_part_index.subscribe
-    ([state] (unsigned int selected_part_idx) {
+    (state->store->dispatching<unsigned int>([state] (unsigned int selected_part_idx) {
        auto rendered_instrument = state->instruments->rendered.get_value();
        auto current_bank = rendered_instrument->status.bank.under_edit.get_value();
        
@@ -26,5 +38,31 @@ PartController::PartController(std::shared_ptr<IO> io, std::shared_ptr<State> st
        auto part = rendered_instrument->parts[part_idx];
 
        rendered_instrument->status.part.under_edit.get_subscriber().on_next(part);
-     });
+
+       play_at_end_of_sequence(state, rendered_instrument, part, current_bank);
+     }));
+}
+
+void play_at_end_of_sequence(std::shared_ptr<State> state,
+                             std::shared_ptr<Instrument> instrument,
+                             std::shared_ptr<Part> part,
+                             bank_idx_t bank)
+{
+  auto part_in_playback = instrument->part_in_playback();
+  if (part_in_playback == part) return;
+
+  auto play = [state, instrument, part, bank] {
+                // the part starts from the top.
+                part->step.update_current(0);
+
+                instrument->playback.bank.store(bank, std::memory_order_release);
+                instrument->playback.part.store(part->id, std::memory_order_release);
+
+                state->store->post<&in_playback>(instrument.get(), (static_cast<std::uint64_t>(bank) << 32) | part->id);
+              };
+
+  // when the instrument is playing, the part in playback plays to the end of its
+  // sequence before handing over. otherwise, it hands over on the next tick.
+  auto quantize = instrument->is_playing() ? Quantize::Sequence : Quantize::Tick;
+  state->deferred->defer(part_in_playback, quantize, play);
 }
@@ -24,4 +24,21 @@ public:
   PartController(std::shared_ptr<IO>, std::shared_ptr<State>);
 };
 
+/// @brief hands playback of an instrument over to a part.
+///
+/// @details
+/// when the instrument is playing, its part in playback plays to the end of its
+/// sequence first and the new part starts from the top. otherwise, the new part is
+/// put in playback on the next tick.
+///
+/// @param state        the state.
+/// @param instrument   the instrument.
+/// @param part         the part to play.
+/// @param bank         the bank of the part.
+///
+void play_at_end_of_sequence(std::shared_ptr<State>,
+                             std::shared_ptr<Instrument>,
+                             std::shared_ptr<Part>,
+                             bank_idx_t);
+
 #endif
@@ -1,6 +1,35 @@
 #include "anemone/controllers/play_pause.hpp"
 
 
+namespace {
+  /// @brief the paused part's status, posted from the tick thread.
+  void paused(Instrument* instrument, part_idx_t part) {
+    instrument->status.is_playing.get_subscriber().on_next(false);
+    instrument->parts[part]->transport.is_paused.get_subscriber().on_next(true);
+    instrument->parts[part]->transport.is_playing.get_subscriber().on_next(false);
+  }
+
+  /// @brief the played part's status, posted from the tick thread.
+  ///
+  /// @param part_and_paused   the part, and whether it was paused (in the upper half).
+  ///
+  void played(Instrument* instrument, std::uint64_t part_and_paused) {
+    auto part           = instrument->parts[static_cast<part_idx_t>(part_and_paused)];
+    auto part_is_paused = (part_and_paused >> 32) != 0;
+
+    instrument->status.is_playing.get_subscriber().on_next(true);
+
+    if (part_is_paused) {
+      // TODO lets prepare to unpause
+
+      // for nnow lets just unpause
+      part->transport.is_paused.get_subscriber().on_next(false);
+    }
+
+    part->transport.is_playing.get_subscriber().on_next(true);
+  }
+}
+
 PlayPauseController::PlayPauseController(std::shared_ptr<IO> io, std::shared_ptr<State> state) {
   auto press_events = io->grid_events
     | rx::filter([] (grid_event_t e) {
@@ -16,33 +45,54 @@ PlayPauseController::PlayPauseController(std::shared_ptr<IO> io, std::shared_ptr
   //                    e.type    == GridEvent::Unpressed;
   //                });
     
-  press_events.subscribe([state] (grid_event_t e) {
+  press_events.subscribe(state->store->dispatching<grid_event_t>([state] (grid_event_t e) {
                         auto rendered_instrument = state->instruments->rendered.get_value();
                         auto rendered_part = rendered_instrument->status.part.under_edit.get_value();
-                        
+
                         auto rendered_part_is_playing = rendered_part->transport.is_playing.get_value();
-                        auto rendered_part_is_paused = rendered_part->transport.is_paused.get_value();
-                        auto rendered_part_is_stopped = rendered_part->transport.is_stopped.get_value();
-
-                        if (rendered_part_is_playing) {
-                          // lets pause
-                          rendered_part->transport.is_paused.get_subscriber().on_next(true);
-                          rendered_part->transport.is_playing.get_subscriber().on_next(false);
-                          rendered_instrument->status.is_playing.get_subscriber().on_next(false);
-                        } else if (rendered_part_is_paused) {
-                          // TODO lets prepare to unpause
-
-                          // for nnow lets just unpause
-                          rendered_part->transport.is_paused.get_subscriber().on_next(false);
-                          rendered_part->transport.is_playing.get_subscriber().on_next(true);
-                          rendered_instrument->status.is_playing.get_subscriber().on_next(true);
-                        } else {
-                          // lets play
-                          rendered_part->transport.is_playing.get_subscriber().on_next(true);
-                          rendered_instrument->status.is_playing.get_subscriber().on_next(true);
-                        }
-                      });
+
+                        play_pause(state, rendered_instrument, rendered_part, !rendered_part_is_playing);
+                      }));
   // off_events.subscribe([state] (grid_event_t e) {
   //                        state->controls->set_shift(false);
   //                      });
 }
+
+void play_pause(std::shared_ptr<State> state,
+                std::shared_ptr<Instrument> instrument,
+                std::shared_ptr<Part> part,
+                bool playing)
+{
+  auto part_in_playback = instrument->part_in_playback();
+
+  if (!playing) {
+    // lets pause, once the cursor is on a step so that we resume in time.
+    state->deferred->defer(part_in_playback, Quantize::Step,
+                           [state, instrument, part] {
+                             instrument->playback.playing.store(false, std::memory_order_release);
+
+                             state->store->post<&paused>(instrument.get(), part->id);
+                           });
+    return;
+  }
+
+  auto part_is_paused = part->transport.is_paused.get_value();
+
+  // are any instruments playing for us to keep in time with?
+  bool any_playing = false;
+  for (auto& itr : state->instruments->by_name) {
+    any_playing = any_playing || itr.second->is_playing();
+  }
+
+  auto play = [state, instrument, part, part_is_paused] {
+                instrument->playback.playing.store(true, std::memory_order_release);
+
+                auto played_part = static_cast<std::uint64_t>(part->id) | (static_cast<std::uint64_t>(part_is_paused) << 32);
+                state->store->post<&played>(instrument.get(), played_part);
+              };
+
+  // lets play, on the next beat if other instruments are playing. if nothing is,
+  // there is nothing to keep time with (and the clock may be idle), so play on the
+  // next tick.
+  state->deferred->defer(part_in_playback, any_playing ? Quantize::Beat : Quantize::Tick, play);
+}
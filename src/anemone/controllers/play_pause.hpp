@@ -24,4 +24,22 @@ public:
   PlayPauseController(std::shared_ptr<IO>, std::shared_ptr<State>);
 };
 
+/// @brief plays or pauses a part, as the play/pause button does.
+///
+/// @details
+/// pausing waits until the cursor of the part in playback is on a step, so that it
+/// resumes in time. playing waits for the next beat when other instruments are playing,
+/// to keep in time with them. otherwise, there is nothing to keep time with (and the
+/// clock may be idle) so the part plays on the next tick.
+///
+/// @param state        the state.
+/// @param instrument   the instrument.
+/// @param part         the part to play or pause.
+/// @param playing      whether to play or pause the part.
+///
+void play_pause(std::shared_ptr<State>,
+                std::shared_ptr<Instrument>,
+                std::shared_ptr<Part>,
+                bool playing);
+
 #endif
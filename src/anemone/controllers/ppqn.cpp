@@ -1,6 +1,14 @@
 #include "anemone/controllers/ppqn.hpp"
 
 
+namespace {
+  /// @brief the ppqn the part changed to, posted from the tick thread.
+  void changed_ppqn(Part* part, PPQN ppqn) {
+    part->ppqn.current.get_subscriber().on_next(ppqn);
+    part->ppqn.pending_change.get_subscriber().on_next(false);
+  }
+}
+
 PPQNController::PPQNController(std::shared_ptr<IO> io, std::shared_ptr<State> state)
   : index_to_ppqn({ { 0, PPQN::One },
                     { 1, PPQN::Two },
@@ -19,7 +27,7 @@ PPQNController::PPQNController(std::shared_ptr<IO> io, std::shared_ptr<State> st
                      e.type    == GridEvent::Pressed;
                  });
 
-  on_events.subscribe([this, state] (grid_event_t e) {
+  on_events.subscribe(state->store->dispatching<grid_event_t>([this, state] (grid_event_t e) {
                         auto rendered_instrument = state->instruments->rendered.get_value();
                         auto rendered_part = rendered_instrument->status.part.under_edit.get_value();
 
@@ -28,12 +36,24 @@ PPQNController::PPQNController(std::shared_ptr<IO> io, std::shared_ptr<State> st
                         // comments in the sequencer step controller for more details). we need to
                         // ensure that the change in PPQN occurs when the `granular_step_idx` of the
                         // part is on a multiple of PPQN::Max. So, here we will set the next ppqn and
-                        // a flag that inndicates that there is a pending change. the sequence step
-                        // controller will handle the actual transition.
-
-                        // set the previous & next ppqn and set the pending ppqn-change flag to true
-                        rendered_part->ppqn.previous.get_subscriber().on_next(rendered_part->ppqn.current.get_value());
-                        rendered_part->ppqn.next.get_subscriber().on_next(index_to_ppqn[e.index]);
-                        rendered_part->ppqn.pending_change.get_subscriber().on_next(true);
-                      });
+                        // a flag that inndicates that there is a pending change, and defer the actual
+                        // transition until the part is on a step.
+
+                        change_ppqn(state, rendered_part, index_to_ppqn[e.index]);
+                      }));
+}
+
+void change_ppqn(std::shared_ptr<State> state, std::shared_ptr<Part> part, PPQN ppqn) {
+  // set the previous & next ppqn and set the pending ppqn-change flag to true
+  part->ppqn.previous.get_subscriber().on_next(part->ppqn.current.get_value());
+  part->ppqn.next.get_subscriber().on_next(ppqn);
+  part->ppqn.pending_change.get_subscriber().on_next(true);
+
+  // if the ppqn is changed again before the change is made, the latest one wins.
+  state->deferred->defer(part, Quantize::Step, [state, part] {
+                           auto next = part->ppqn.next.get_value();
+                           part->ppqn.in_playback.store(next, std::memory_order_relaxed);
+
+                           state->store->post<&changed_ppqn>(part.get(), next);
+                         });
 }
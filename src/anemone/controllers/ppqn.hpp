@@ -28,4 +28,17 @@ private:
   std::map<unsigned int, PPQN> index_to_ppqn;
 };
 
+/// @brief changes the ppqn of a part, as the ppqn buttons do.
+///
+/// @details
+/// the change only takes effect once the cursor of the part is on a step (see
+/// `Quantize::Step`), meanwhile the part shows the ppqn as pending. if the ppqn is
+/// changed again before then, the latest one wins.
+///
+/// @param state   the state.
+/// @param part    the part whose ppqn to change.
+/// @param ppqn    the new ppqn.
+///
+void change_ppqn(std::shared_ptr<State>, std::shared_ptr<Part>, PPQN);
+
 #endif
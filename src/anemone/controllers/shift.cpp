@@ -16,10 +16,10 @@ ShiftController::ShiftController(std::shared_ptr<IO> io, std::shared_ptr<State>
                      e.type    == GridEvent::Unpressed;
                  });
     
-  on_events.subscribe([state] (grid_event_t e) {
+  on_events.subscribe(state->store->dispatching<grid_event_t>([state] (grid_event_t e) {
                         state->controls->set_shift(true);
-                      });
-  off_events.subscribe([state] (grid_event_t e) {
+                      }));
+  off_events.subscribe(state->store->dispatching<grid_event_t>([state] (grid_event_t e) {
                          state->controls->set_shift(false);
-                       });
+                       }));
 }
@@ -1,91 +1,314 @@
 #include "anemone/controllers/step.hpp"
 
 
+namespace {
+  /// @brief follows the cursor onto the page it is playing, posted from the tick thread.
+  void follow_cursor(Part* part, page_idx_t playing_page) {
+    if (part->page.follow_cursor.get_value() && !part->step.show_last.get_value()) {
+      part->page.rendered.get_subscriber().on_next(playing_page);
+      part->page.under_edit.get_subscriber().on_next(playing_page);
+    }
+  }
+}
+
 StepController::StepController(std::shared_ptr<IO> io, std::shared_ptr<State> state) {
-  // TODO NOTE: this subscription raises CPU usage from 0.5 -> 2.0 (we might want to investigate to
-  // optimize this a little perhaps...)
-  
+  // re-render a part's lookahead window whenever its sequence is edited, or whenever
+  // the way its cursor moves changes (its ppqn is checked on every tick, see `render`).
+  for (auto& itr : state->instruments->by_name) {
+    for (auto part : itr.second->parts) {
+      part->sequence.added_steps.get_observable()
+        .subscribe([this, part] (paged_step_idx_t) { invalidate(part); });
+      part->sequence.removed_steps.get_observable()
+        .subscribe([this, part] (paged_step_idx_t) { invalidate(part); });
+      part->step.last.get_observable()
+        .subscribe([this, part] (paged_step_idx_t) { invalidate(part, true); });
+    }
+  }
+
   // subscribe to clock ticks
   auto tick_events = io->clock_events
     .subscribe
     ([this, io, state]
      (tick_t t) {
-       // iterate over instruments
-       for (auto itr : state->instruments->by_name) {
-         auto instrument = itr.second;
+       // make the changes which were waiting for this tick, before any part moves.
+       state->deferred->apply(t);
 
-         // if this instrument is not playing, continue
-         if ( !instrument->status.is_playing.get_value() ) continue;
+       // iterate over instruments, gathering the parts to advance.
+       advancing.clear();
+       for (auto& itr : state->instruments->by_name) {
+         auto instrument = itr.second;
 
          // get the part in playback
-         auto part = instrument->status.part.in_playback.get_value();
+         auto part = instrument->part_in_playback();
+
+         // if the part in playback was switched, stop the previous one.
+         auto& previous_part = parts_in_playback[instrument.get()];
+         if (previous_part != part.get()) {
+           if (previous_part != nullptr) {
+             previous_part->step.advancing.store(false, std::memory_order_relaxed);
+             stop_rendering(io, instrument, previous_part, t);
+           }
+           previous_part = part.get();
+         }
+
+         // if this instrument is not playing, drop whatever was rendered ahead and continue
+         if ( !instrument->is_playing() ) {
+           part->step.advancing.store(false, std::memory_order_relaxed);
+           stop_rendering(io, instrument, part.get(), t);
+           continue;
+         }
 
          // get step section size.
          // TODO idea: conntrollers (and ui eventually) can be organized by specific layout
          // and we can have these controllers store the sizes of relevant sections.
          auto page_size = state->layouts->sequencer->steps->size();
          
-         // get granular cursor step
-         auto current_granular_step = part->step.current.get_value();
-         
          // get current last step (non-granular)
          auto last_step = part->step.last.get_value().to_absolute_idx(page_size);
-         
-         // get the midi events at the current step
-         auto step_events = part->sequence.get_events_at(current_granular_step);
-         
-         // increment current cursor step
-         auto next_granular_step = current_granular_step + part->ppqn.current.get_value();
-         
-         // the current step is now greater than the last step, cycle back to first step.
-         if (current_granular_step > (last_step * PPQN::Max) - 1 ) {
-           // this is eht "end-of-sequence"
-           next_granular_step = 0;
-           
-           // TODO update stuff that needs updating on "end-of-sequence".
-         }
-         
-         // update current granular step
-         part->step.update_current(next_granular_step);
-         
-         // check if the next granular step is a multiple of PPQN::Max, which
-         // means that this step is "on beat".
-         if ( (next_granular_step % PPQN::Max) == 0 ) {
-           // make all state changes for this part which need to happen "on beat"
-           
-           // if there is a pending PPQN change, do it!
-           if ( part->ppqn.pending_change.get_value() ) {
-             part->ppqn.current.get_subscriber().on_next(part->ppqn.next.get_value());
-             part->ppqn.pending_change.get_subscriber().on_next(false);
-           }
-         }
-         
-         // if we are following the cursor, update the rendered/under-edit pages
-         if (part->page.follow_cursor.get_value() && !part->step.show_last.get_value()) {
+
+         // get the part's cursor in the bank, picking up where it was moved to (if it was
+         // moved since the last tick, e.g. back to the top).
+         auto slot = cursor_of(part.get());
+         auto current_granular_step = part->step.cursor.load(std::memory_order_relaxed);
+         if (cursors.at(slot) != current_granular_step) cursors.move(slot, current_granular_step);
+
+         cursors.set_stride(slot, part->ppqn.in_playback.load(std::memory_order_relaxed));
+         cursors.set_end(slot, last_step * PPQN::Max);
+
+         advancing.push_back({ .instrument = instrument,
+                               .part       = part,
+                               .slot       = slot,
+                               .step       = current_granular_step,
+                               .last       = last_step * PPQN::Max,
+           });
+       } // end instrument loop
+
+       // increment all cursors at once.
+       cursors.advance();
+
+       for (auto& advanced : advancing) {
+         auto& part = advanced.part;
+         auto next_granular_step = cursors.at(advanced.slot);
+
+         // update the cursor, and the current step only if the cursor landed on a new one.
+         part->step.cursor.store(next_granular_step, std::memory_order_relaxed);
+         part->step.advancing.store(true, std::memory_order_relaxed);
+         if (cursors.moved(advanced.slot)) {
+           part->step.current.set(next_granular_step);
+
            // compute current playing page from granular step
+           auto page_size    = state->layouts->sequencer->steps->size();
            auto playing_page = granular_to_paged_step(next_granular_step, page_size).page;
-           
-           if (previous.playing_page != playing_page) {
-             // if the page has changed, update the rendered/under_edit pages
-             part->page.rendered.get_subscriber().on_next(playing_page);
-             part->page.under_edit.get_subscriber().on_next(playing_page);
-           }
 
-           previous.playing_page = playing_page;
+           if (part->page.in_playback.get() != playing_page) {
+             part->page.in_playback.set(playing_page);
+
+             // if we are following the cursor, update the rendered/under-edit pages
+             // (which are low frequency state, so this is posted to the store).
+             state->store->post<&follow_cursor>(part.get(), playing_page);
+           }
          }
 
-         // emit midi_events from step_events
-         // TODO either we should consolidate these types or figure out a principled
-         // way top use them! add better support for them.
-         for (auto step_event : step_events) {
-           midi_event_t midi_event = { .source = "", .destination = "", .data = step_event.data };
-
-           // stream these notes on the midi event playback for this instrument.
-           instrument->playback_midi_events.get_subscriber().on_next(midi_event);
-           
-           // emit to midi out device(s)
-           io->midi->emit(midi_event);
-         }         
-       } // end instrument loop
+         // render the events due within the lookahead window.
+         render(io, advanced.instrument, part, t, advanced.step, advanced.last);
+       }
      });
+  // when following an external clock, (re)start parts in playback from the top
+  // whenever the external transport starts.
+  io->transport_events
+    .filter([] (ClockTransport t) {
+              return t == ClockTransport::Start;
+            })
+    .subscribe([this, state] (ClockTransport) {
+                 // this runs on the midi in thread, so the cursors are moved on the next
+                 // tick, by the tick thread which is their only writer.
+                 for (auto& itr : state->instruments->by_name) {
+                   auto part = itr.second->part_in_playback();
+                   state->deferred->defer(part, Quantize::Tick, [this, part] {
+                                                                  part->step.update_current(0);
+                                                                  invalidate(part);
+                                                                });
+                 }
+               });
+}
+
+granular_step_idx_t StepController::next_step(granular_step_idx_t step, granular_step_idx_t last, PPQN ppqn) {
+  // the current step is greater than the last step, cycle back to first step.
+  if (step > last - 1) {
+    // this is eht "end-of-sequence"
+    // TODO update stuff that needs updating on "end-of-sequence".
+    return 0;
+  }
+
+  return step + ppqn;
+}
+
+CursorBank::slot_t StepController::cursor_of(const Part *part) {
+  auto itr = cursor_slots.find(part);
+  if (itr == cursor_slots.end()) {
+    itr = cursor_slots.insert({ part, cursors.add(part->step.cursor.load(std::memory_order_relaxed)) }).first;
+  }
+
+  return itr->second;
+}
+
+void StepController::render(std::shared_ptr<IO> io,
+                            std::shared_ptr<Instrument> instrument,
+                            std::shared_ptr<Part> part,
+                            tick_t tick,
+                            granular_step_idx_t step,
+                            granular_step_idx_t last)
+{
+  auto ppqn = part->ppqn.in_playback.load(std::memory_order_relaxed);
+
+  // find how far this part has been rendered (if at all).
+  auto itr = playbacks.find(part.get());
+  if (itr == playbacks.end()) {
+    itr = playbacks.insert({ part.get(), { .until = tick.index - 1, .step = step, .cursor = {}, .period = tick.period, .ppqn = ppqn } }).first;
+  }
+  auto& playback = itr->second;
+
+  // the note offs due on the ticks which have been rendered & played are done with.
+  playback.note_offs.advance(std::min(playback.until, tick.index), [] (long, const note_off_t&) {});
+
+  // if the sequence was edited, throw away what was rendered ahead and render it again.
+  bool edited = false, flush = false;
+  {
+    std::lock_guard<std::mutex> guard(edited_parts_mutex);
+    auto edit = edited_parts.find(part.get());
+    if (edit != edited_parts.end()) {
+      edited = true;
+      flush  = edit->second;
+      edited_parts.erase(edit);
+    }
+  }
+
+  // the events ahead are due at the wrong times once the tempo or the part's ppqn
+  // changes, so they are rendered again too.
+  if (tick.period != playback.period || ppqn != playback.ppqn) {
+    edited          = true;
+    playback.period = tick.period;
+    playback.ppqn   = ppqn;
+  }
+
+  if (edited && playback.until >= tick.index) {
+    // the events of this tick may already be out, so only re-render the ticks after it.
+    // the note offs cancelled along with them are rendered again from the wheel, except
+    // for the ones of the cancelled notes.
+    io->scheduler->cancel(part.get(), tick.time);
+    playback.note_offs.remove_if([&tick] (long, const note_off_t& note_off) { return note_off.on > tick.index; });
+    playback.until = tick.index;
+    playback.step  = next_step(step, last, ppqn);
+    playback.cursor.reset();
+  } else if (playback.until < tick.index) {
+    // we've fallen behind (i.e. ticks were dropped), pick up from the cursor.
+    if (edited || playback.until < tick.index - 1) playback.cursor.reset();
+
+    // end the notes which were due to end on the dropped ticks right away.
+    playback.note_offs.advance(tick.index - 1, [&] (long, const note_off_t& note_off) {
+                                 play(io, instrument, part.get(), tick.time, note_off.event);
+                               });
+    playback.until = tick.index - 1;
+    playback.step  = step;
+  }
+
+  // the sounding notes may never reach their note offs in the new loop, end them now.
+  if (flush) flush_note_offs(io, instrument, part.get(), playback, tick);
+
+  // the last tick within the lookahead window.
+  long until = tick.index;
+  if (tick.period.count() > 0) until += io->scheduler->lookahead() / tick.period;
+
+  // render the ticks of the window which haven't been rendered yet.
+  auto schedule = part->sequence.schedule();
+  auto audible  = part->layers.audible();
+  for (long i = playback.until + 1; i <= until; i++) {
+    auto due = tick.time + (tick.period * (i - tick.index));
+
+    // end the notes which are due to end on this tick, before any new ones start.
+    playback.note_offs.visit(i, [&] (long, const note_off_t& note_off) {
+                               play(io, instrument, part.get(), due, note_off.event);
+                             });
+
+    for (auto& step_event : playback.cursor.advance(*schedule, playback.step)) {
+      // skip the muted (or not soloed) layers.
+      if (!((audible >> step_event.layer) & 1)) continue;
+
+      play(io, instrument, part.get(), due, step_event);
+
+      // schedule the note off, however long the note is at the current ppqn.
+      if (step_event.is_note_on()) {
+        auto note_off = step_event;
+        note_off.data[0] -= 16;
+
+        playback.note_offs.schedule(i + std::max(1u, step_event.duration / ppqn), { .on = i, .event = note_off });
+      }
+    }
+
+    playback.step  = next_step(playback.step, last, ppqn);
+    playback.until = i;
+  }
+}
+
+void StepController::play(std::shared_ptr<IO> io,
+                          std::shared_ptr<Instrument> instrument,
+                          const void *owner,
+                          std::chrono::steady_clock::time_point due,
+                          const compiled_step_event_t& step_event)
+{
+  // TODO either we should consolidate these types or figure out a principled
+  // way top use them! add better support for them.
+  midi_event_t midi_event = { .source      = "",
+                              .destination = "",
+                              .data        = step_event.data,
+  };
+
+  // schedule for the midi out device(s), and stream it on the midi event playback for
+  // this instrument once it is sent.
+  io->scheduler->schedule({ .due    = due,
+                            .event  = midi_event,
+                            .owner  = owner,
+                            .played = &instrument->playback_midi_events,
+    });
+}
+
+void StepController::flush_note_offs(std::shared_ptr<IO> io,
+                                     std::shared_ptr<Instrument> instrument,
+                                     const Part *part,
+                                     playback_t& playback,
+                                     tick_t tick)
+{
+  // the note offs due up to this tick have been played, and the notes rendered after it
+  // have been cancelled, so they have nothing to end.
+  playback.note_offs.advance(std::min(playback.until, tick.index), [] (long, const note_off_t&) {});
+  playback.note_offs.flush([&] (long, const note_off_t& note_off) {
+                             if (note_off.on <= tick.index) play(io, instrument, part, tick.time, note_off.event);
+                           });
+}
+
+void StepController::stop_rendering(std::shared_ptr<IO> io,
+                                    std::shared_ptr<Instrument> instrument,
+                                    const Part *part,
+                                    tick_t tick)
+{
+  // the part's cursor stays where it is until it plays again.
+  auto slot = cursor_slots.find(part);
+  if (slot != cursor_slots.end()) {
+    cursors.remove(slot->second);
+    cursor_slots.erase(slot);
+  }
+
+  auto itr = playbacks.find(part);
+  if (itr == playbacks.end()) return;
+
+  // drop the notes which were rendered ahead, and end the ones which are sounding.
+  io->scheduler->cancel(part, tick.time);
+  flush_note_offs(io, instrument, part, itr->second, tick);
+
+  playbacks.erase(itr);
+}
+
+void StepController::invalidate(std::shared_ptr<Part> part, bool flush) {
+  std::lock_guard<std::mutex> guard(edited_parts_mutex);
+  edited_parts[part.get()] |= flush;
 }
@@ -9,24 +9,150 @@
 #ifndef ANEMONE_CONTROLLERS_STEP_H
 #define ANEMONE_CONTROLLERS_STEP_H
 
+#include <map>
+#include <mutex>
+#include <chrono>
 #include <memory>
+#include <vector>
 
 #include "anemone/rx.hpp"
 #include "anemone/io.hpp"
 #include "anemone/types.hpp"
 #include "anemone/state.hpp"
+#include "anemone/util/cursor_bank.hpp"
+#include "anemone/util/timing_wheel.hpp"
 
 
 /// @brief An controller for updating playing part steps.
 ///
+/// @details
+/// on each tick, the cursors of playing parts are advanced (all at once, see
+/// `CursorBank`) and the events of the upcoming steps are rendered ahead of time into
+/// the midi scheduler, stamped with when they are due. this way, emitting midi doesn't
+/// depend on how long the tick subscribers take. when a part's sequence is edited, or
+/// the tempo changes (including on every tick of a ramp), its pending events are
+/// cancelled and rendered again on the next tick.
+///
 class StepController {
 public:
   StepController(std::shared_ptr<IO>, std::shared_ptr<State>);
 private:
-  /// @brief previous values
-  struct {
-    page_idx_t playing_page = 0;
-  } previous;
+  /// @brief a pending note off.
+  struct note_off_t {
+    /// @brief the tick its note on was rendered on.
+    long on;
+
+    /// @brief the note off event.
+    compiled_step_event_t event;
+  };
+
+  /// @brief how far a part has been rendered.
+  struct playback_t {
+    /// @brief index of the last tick rendered.
+    long until;
+
+    /// @brief the granular step played on the tick after `until`.
+    granular_step_idx_t step;
+
+    /// @brief the part's position in its compiled schedule.
+    schedule_cursor_t cursor;
+
+    /// @brief the tick period the events ahead were rendered with.
+    std::chrono::nanoseconds period;
+
+    /// @brief the ppqn the events ahead were rendered with.
+    PPQN ppqn;
+
+    /// @brief the note offs of the rendered notes, keyed by the tick they are due on.
+    /// they stay in the wheel until that tick is played, so that the ones rendered
+    /// ahead can be rendered again along with the rest of the part.
+    TimingWheel<note_off_t> note_offs = TimingWheel<note_off_t>();
+  };
+
+  /// @brief the cursors of the playing parts.
+  CursorBank cursors { PPQN::Max };
+
+  /// @brief the slot of each playing part's cursor in the bank.
+  std::map<const Part*, CursorBank::slot_t> cursor_slots;
+
+  /// @brief a part advanced on the current tick.
+  struct advancing_t {
+    std::shared_ptr<Instrument> instrument;
+    std::shared_ptr<Part>       part;
+    CursorBank::slot_t          slot;
+
+    /// @brief the granular step the cursor was at before advancing.
+    granular_step_idx_t step;
+
+    /// @brief the granular step at the end of the sequence.
+    granular_step_idx_t last;
+  };
+
+  /// @brief the parts advanced on the current tick (kept to reuse its storage).
+  std::vector<advancing_t> advancing;
+
+  /// @brief how far each playing part has been rendered.
+  std::map<const Part*, playback_t> playbacks;
+
+  /// @brief the part each instrument last played back.
+  std::map<const Instrument*, Part*> parts_in_playback;
+
+  /// @brief parts whose sequence has been edited since they were last rendered, and
+  /// whether their sounding notes should be ended.
+  std::map<const Part*, bool> edited_parts;
+  std::mutex edited_parts_mutex;
+
+  /// @brief the cursor step following the provided step.
+  ///
+  /// @param step   the current granular step.
+  /// @param last   the granular step at the end of the sequence.
+  /// @param ppqn   the part's ppqn.
+  ///
+  granular_step_idx_t next_step(granular_step_idx_t, granular_step_idx_t, PPQN);
+
+  /// @brief the slot of a part's cursor in the bank, adding it if it isn't there.
+  CursorBank::slot_t cursor_of(const Part*);
+
+  /// @brief renders the events of a part which are due within the lookahead window.
+  ///
+  /// @param step   the granular step the cursor is at on the provided tick.
+  /// @param last   the granular step at the end of the sequence.
+  ///
+  void render(std::shared_ptr<IO>,
+              std::shared_ptr<Instrument>,
+              std::shared_ptr<Part>,
+              tick_t,
+              granular_step_idx_t step,
+              granular_step_idx_t last);
+
+  /// @brief plays a step event, i.e. schedules it for the midi out device(s). it is
+  /// streamed on the instrument's playback events once it is sent.
+  ///
+  /// @param owner        the owner of the scheduled event.
+  /// @param due          when the event is due.
+  /// @param step_event   the event.
+  ///
+  void play(std::shared_ptr<IO>,
+            std::shared_ptr<Instrument>,
+            const void *owner,
+            std::chrono::steady_clock::time_point due,
+            const compiled_step_event_t&);
+
+  /// @brief plays all of a part's pending note offs on the provided tick.
+  ///
+  /// @pre the events the part has rendered after the tick have been cancelled.
+  ///
+  void flush_note_offs(std::shared_ptr<IO>, std::shared_ptr<Instrument>, const Part*, playback_t&, tick_t);
+
+  /// @brief cancels the events which were rendered ahead for a part, and ends its
+  /// sounding notes.
+  void stop_rendering(std::shared_ptr<IO>, std::shared_ptr<Instrument>, const Part*, tick_t);
+
+  /// @brief marks a part as edited, so its lookahead window is rendered again.
+  ///
+  /// @param flush   whether the part's sounding notes should be ended.
+  ///
+  void invalidate(std::shared_ptr<Part>, bool flush = false);
 };
 
 #endif
@@ -0,0 +1,32 @@
+#include "anemone/controllers/transport.hpp"
+
+
+TransportController::TransportController(std::shared_ptr<IO> io, std::shared_ptr<State> state) {
+  for (auto itr : state->instruments->by_name) {
+    itr.second->status.is_playing.get_observable()
+      .subscribe([this, io, state] (bool) {
+                   bool any_playing = false;
+                   bool from_top    = true;
+
+                   for (auto itr : state->instruments->by_name) {
+                     auto instrument = itr.second;
+                     if ( !instrument->is_playing() ) continue;
+
+                     any_playing = true;
+
+                     auto part = instrument->part_in_playback();
+                     if (part->step.cursor.load(std::memory_order_relaxed) != 0) from_top = false;
+                   }
+
+                   if (is_playing.exchange(any_playing) == any_playing) return;
+
+                   if (!any_playing) {
+                     io->clock->stop();
+                   } else if (from_top) {
+                     io->clock->start();
+                   } else {
+                     io->clock->resume();
+                   }
+                 });
+  }
+}
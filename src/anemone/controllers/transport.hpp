@@ -0,0 +1,37 @@
+/**
+ * @file   controllers/transport.hpp
+ * @brief  Transport Controller
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef ANEMONE_CONTROLLERS_TRANSPORT_H
+#define ANEMONE_CONTROLLERS_TRANSPORT_H
+
+#include <atomic>
+#include <memory>
+
+#include "anemone/rx.hpp"
+#include "anemone/io.hpp"
+#include "anemone/types.hpp"
+#include "anemone/state.hpp"
+
+
+/// @brief A controller for the outgoing (midi clock) transport.
+///
+/// @details
+/// the transport is playing whenever any instrument is playing. when it starts
+/// playing with all playing parts at their first step, the clock starts the
+/// transport from the top, otherwise it resumes from where it was stopped.
+///
+class TransportController {
+public:
+  TransportController(std::shared_ptr<IO>, std::shared_ptr<State>);
+private:
+  /// @brief whether the transport is playing (updated from whichever thread an
+  /// instrument starts or stops on).
+  std::atomic<bool> is_playing = { false };
+};
+
+#endif
@@ -12,15 +12,24 @@
 // io 
 #include "anemone/io/io.hpp"
 
+// clock
+#include "anemone/io/clock/clock.hpp"
+#include "anemone/io/clock/device/clock.hpp"
+#include "anemone/io/clock/device/system.hpp"
+#include "anemone/io/clock/device/virtual.hpp"
+
 // grid
 #include "anemone/io/grid/grid.hpp"
 #include "anemone/io/grid/device/grid.hpp"
 #include "anemone/io/grid/device/monome.hpp"
+#include "anemone/io/grid/device/null.hpp"
 
 // midi
 #include "anemone/io/midi/midi.hpp"
 #include "anemone/io/midi/device/midi.hpp"
 #include "anemone/io/midi/device/factory.hpp"
 #include "anemone/io/midi/device/rtmidi.hpp"
+#include "anemone/io/midi/device/null.hpp"
+#include "anemone/io/midi/smf.hpp"
 
 #endif
@@ -1,33 +1,504 @@
+#include <spdlog/spdlog.h>
+
+#include "anemone/util/wait.hpp"
 #include "anemone/io/clock/clock.hpp"
 
 
-Clock::Clock(std::shared_ptr<State> state) {
-  state->controls->bpm.get_observable()
-    .subscribe([this] (double b) {
-                 bpm = b;
-                 period = std::chrono::microseconds
-                   (static_cast<int>((60 * 1000 * 1000)/(bpm * (float)PPQN::Max)));
+Clock::Clock(std::shared_ptr<Config> config,
+             std::shared_ptr<State> state,
+             std::shared_ptr<Midi> midi,
+             std::shared_ptr<ClockDevice> device)
+  : Clock(device,
+          { .spin        = std::chrono::microseconds(config->at("clock")["spin"].as<unsigned int>(300)),
+            .catch_up    = config->at("clock")["catch_up"].as<unsigned int>(PPQN::Max),
+            .source      = config->at("clock")["source"].as<std::string>("internal") == "midi" ?
+                           Source::Midi : Source::Internal,
+            .input       = config->at("clock")["input"].as<std::string>(""),
+            .tick_thread = realtime_thread_from_config(config, "clock"),
+            .sync_thread = realtime_thread_from_config(config, "midi_out"),
+            .idle        = config->at("clock")["idle"].as<bool>(true),
+    },
+    state->controls->bpm.get_observable(),
+    midi->timing_events())
+{}
+
+Clock::Clock(std::shared_ptr<ClockDevice> device,
+             settings_t settings,
+             rx::observable<double> bpm_events,
+             rx::observable<midi_event_t> timing_events)
+  : settings(settings),
+    device(device),
+    timing(timing_events)
+{
+  // following an external clock only makes sense in real-time.
+  if (settings.source == Source::Midi && !device->is_realtime()) {
+    spdlog::warn("  clock -> can't follow midi in -> {} with a virtual clock device, using the internal clock",
+                 this->settings.input);
+    this->settings.source = Source::Internal;
+  }
+
+  // there is no point in idling in virtual time, and a stepped clock would wait forever.
+  if (!device->is_realtime()) this->settings.idle = false;
+
+  // tempo changes are only published here, the tick loop picks them up on the next tick.
+  bpm_events
+    .subscribe([this] (double bpm) {
+                 tempo_map.set(bpm);
                });
 }
 
+Clock::~Clock() {
+  disconnect();
+}
+
 rx::observable<tick_t> Clock::connect() {
   // start clock
   // TODO use rx schedulers to delegate this to a thread
-  std::thread
-    t([this] () {
-        while (true) {
-          auto t1 = std::chrono::high_resolution_clock::now();
+  running = true;
 
-          get_subscriber().on_next(tick_t{});
+  if (settings.source == Source::Midi) {
+    // follow sync messages from the configured midi input.
+    timing
+      .filter([this] (midi_event_t e) {
+                return e.source == settings.input;
+              })
+      .subscribe([this] (midi_event_t e) {
+                   receive(e);
+                 });
 
-          auto t2 = std::chrono::high_resolution_clock::now();
-          auto wait = period - std::chrono::duration_cast<std::chrono::microseconds>(t1 - t2);
+    ticker = std::thread([this] () { follow(); });
 
-          std::this_thread::sleep_for(wait);
-        }
-      });
+    spdlog::info("  connected -> clock (following midi in -> {})", settings.input);
+  } else {
+    {
+      std::lock_guard<std::mutex> guard(master.mutex);
+      master.anchor      = device->now();
+      master.base        = 0;
+      master.tick_period = TempoMap::period(tempo_map.bpm());
+    }
+
+    ticker = std::thread([this] () { run(); });
 
-  t.detach();
+    // midi clock messages go out on their own thread so they are never held up by
+    // whatever the tick subscribers are doing (e.g. emitting a burst of notes). they
+    // are only meaningful in real-time though.
+    if (device->is_realtime()) {
+      syncer = std::thread([this] () { send_sync(); });
+    }
+  }
 
   return get_observable();
 }
+
+void Clock::disconnect() {
+  running = false;
+
+  // wake up the tick thread if the device is holding it (e.g. a stepped virtual clock).
+  device->interrupt();
+
+  // wake up the follower if it is waiting on clock messages, and the tick loop & midi
+  // sync output if they are idle. the mutexes are taken so the wakeups can't slip in
+  // between a check of `running` and the wait.
+  { std::lock_guard<std::mutex> guard(sync.mutex); }
+  { std::lock_guard<std::mutex> guard(master.mutex); }
+  sync.condition.notify_all();
+  master.condition.notify_all();
+
+  if (ticker.joinable()) ticker.join();
+  if (syncer.joinable()) syncer.join();
+}
+
+rx::observable<ClockTransport> Clock::transport_events() {
+  return transport.get_observable();
+}
+
+rx::observable<clock_sync_t> Clock::sync_events() {
+  return sync_out.get_observable();
+}
+
+void Clock::start() {
+  {
+    std::lock_guard<std::mutex> guard(master.mutex);
+
+    // the song starts on the next tick.
+    master.playing  = true;
+    master.phase    = ticks;
+    master.position = 0;
+    master.pulse    = 0;
+    master.pending  = { make_sync_message(MidiSync::Start) };
+    master.generation++;
+  }
+
+  master.condition.notify_all();
+}
+
+void Clock::stop() {
+  {
+    std::lock_guard<std::mutex> guard(master.mutex);
+    if (!master.playing) return;
+
+    master.playing  = false;
+    master.position = ticks - master.phase;
+    master.pending  = { make_sync_message(MidiSync::Stop) };
+
+    // keep sending midi clock messages while stopped, relative to tick 0.
+    master.phase    = 0;
+    master.pulse    = (ticks * MIDI_CLOCK_PPQN + PPQN::Max - 1) / PPQN::Max;
+    master.generation++;
+  }
+
+  master.condition.notify_all();
+}
+
+void Clock::resume() {
+  {
+    std::lock_guard<std::mutex> guard(master.mutex);
+    if (master.playing) return;
+
+    // the song position pointer only has sixteenth note resolution, so we continue
+    // from the next sixteenth note. the song resumes at its stopped position on the
+    // next tick, which puts that sixteenth note a little later.
+    const long ticks_per_midi_beat = PPQN::Max / (MIDI_CLOCK_PPQN / MIDI_CLOCKS_PER_MIDI_BEAT);
+    long midi_beat = (master.position + ticks_per_midi_beat - 1) / ticks_per_midi_beat;
+
+    master.playing  = true;
+    master.phase    = ticks - master.position;
+    master.pulse    = midi_beat * MIDI_CLOCKS_PER_MIDI_BEAT;
+    master.pending  = { make_song_position_message(midi_beat),
+                        make_sync_message(MidiSync::Continue) };
+    master.generation++;
+  }
+
+  master.condition.notify_all();
+}
+
+unsigned long Clock::dropped_ticks() {
+  return dropped;
+}
+
+TempoMap& Clock::tempo() {
+  return tempo_map;
+}
+
+void Clock::idle(bool idle) {
+  if (!settings.idle) return;
+
+  {
+    std::lock_guard<std::mutex> guard(master.mutex);
+    if (master.idle == idle) return;
+
+    master.idle = idle;
+  }
+
+  master.condition.notify_all();
+}
+
+bool Clock::is_idle() {
+  std::lock_guard<std::mutex> guard(master.mutex);
+  return master.idle && !master.playing;
+}
+
+Clock::stats_t& Clock::stats() {
+  return statistics;
+}
+
+void Clock::log_stats(bool reset) {
+  auto us = [] (std::uint64_t ns) { return (double)ns / 1000.0; };
+
+  spdlog::info("clock -> {} ticks | late p50 {:.1f} p99 {:.1f} p99.9 {:.1f} max {:.1f} µs"
+               " | fan-out p50 {:.1f} p99 {:.1f} p99.9 {:.1f} max {:.1f} µs | {} overruns, {} dropped",
+               statistics.lateness.count(),
+               us(statistics.lateness.percentile(50)),
+               us(statistics.lateness.percentile(99)),
+               us(statistics.lateness.percentile(99.9)),
+               us(statistics.lateness.max()),
+               us(statistics.fan_out.percentile(50)),
+               us(statistics.fan_out.percentile(99)),
+               us(statistics.fan_out.percentile(99.9)),
+               us(statistics.fan_out.max()),
+               statistics.overruns.load(),
+               dropped.load());
+
+  if (!reset) return;
+
+  statistics.lateness.reset();
+  statistics.fan_out.reset();
+  statistics.overruns = 0;
+}
+
+void Clock::run() {
+  make_realtime("clock", settings.tick_thread);
+
+  // the deadline of each tick is the deadline of the previous one plus the period between
+  // them. while the tempo holds, this is `anchor + n * period`, so rounding errors never
+  // accumulate.
+  std::unique_lock<std::mutex> lock(master.mutex);
+  auto deadline    = master.anchor;
+  auto tick_period = master.tick_period;
+  long index       = master.base;
+  lock.unlock();
+
+  // the tempo segment being played, and the tick it started on.
+  unsigned long       version = 0;
+  TempoMap::segment_t segment = { .from  = tempo_map.bpm(),
+                                  .to    = tempo_map.bpm(),
+                                  .ticks = 0,
+                                  .curve = TempoMap::Ramp::Linear,
+  };
+  long                start   = index;
+
+  while (running) {
+    // while nothing needs ticks, block until something does and carry on from there.
+    if (master.idle) {
+      lock.lock();
+      if (master.idle && !master.playing) {
+        master.condition.wait(lock, [this] { return !running || !master.idle || master.playing; });
+
+        deadline           = device->now();
+        master.anchor      = deadline;
+        master.base        = index;
+        master.tick_period = tick_period;
+        master.generation++;
+
+        lock.unlock();
+        master.condition.notify_all();
+        continue;
+      }
+      lock.unlock();
+    }
+
+    device->wait_until(deadline, settings.spin);
+    if (!running) break;
+
+    statistics.wakeups++;
+
+    // pick up tempo changes published since the previous tick. they start on this tick,
+    // i.e. from the period following it.
+    TempoMap::segment_t published;
+    if (tempo_map.poll(version, published)) {
+      if (published.from < 0) published.from = TempoMap::bpm_at(segment, index - start);
+
+      segment = published;
+      start   = index;
+    }
+
+    auto period = TempoMap::period_at(segment, index - start);
+
+    // if the period changes, re-anchor the midi sync output's timeline on this tick.
+    if (period != tick_period) {
+      tick_period = period;
+
+      lock.lock();
+      master.anchor      = deadline;
+      master.base        = index;
+      master.tick_period = tick_period;
+      master.generation++;
+      lock.unlock();
+      master.condition.notify_all();
+    }
+
+    ticks = index + 1;
+    emit({ .index  = index,
+           .time   = deadline,
+           .period = tick_period,
+      });
+
+    index++;
+    deadline += tick_period;
+
+    // have we fallen whole ticks behind?
+    auto now = device->now();
+    if (now - deadline < tick_period) continue;
+
+    long missed = (now - deadline) / tick_period;
+    if (missed <= static_cast<long>(settings.catch_up)) continue; // the missed ticks will be emitted back-to-back.
+
+    // we are too far behind to catch up, drop the missed ticks and resync.
+    dropped  += missed;
+    index    += missed;
+    deadline += missed * tick_period;
+
+    spdlog::warn("clock dropped {} ticks ({} total)", missed, dropped.load());
+  }
+}
+
+void Clock::send_sync() {
+  make_realtime("midi clock", settings.sync_thread);
+
+  std::unique_lock<std::mutex> lock(master.mutex);
+
+  while (running) {
+    statistics.wakeups++;
+
+    // while the clock is idle, there is nothing to keep in time with.
+    if (master.idle && !master.playing && master.pending.empty()) {
+      master.condition.wait(lock, [this] { return !running || !master.idle || master.playing || !master.pending.empty(); });
+      continue;
+    }
+
+    // send pending transport messages right away, before the next midi clock message.
+    if (!master.pending.empty()) {
+      auto pending = std::move(master.pending);
+      master.pending.clear();
+
+      lock.unlock();
+      auto now = std::chrono::steady_clock::now();
+      for (auto message : pending) sync_out.get_subscriber().on_next(clock_sync_t{ .data = message, .due = now });
+      lock.lock();
+      continue;
+    }
+
+    // the midi clock message is due on the (fractional) tick it falls on.
+    auto generation = master.generation;
+    auto deadline   = tick_deadline(master.phase + ((double)(master.pulse * PPQN::Max) / MIDI_CLOCK_PPQN));
+
+    // if we are more than a midi clock late (e.g. we were starved), skip ahead
+    // rather than sending a burst of stale clock messages.
+    auto pulse_period = (master.tick_period * PPQN::Max) / MIDI_CLOCK_PPQN;
+    auto now          = std::chrono::steady_clock::now();
+    if (now - deadline > pulse_period) {
+      master.pulse += (now - deadline) / pulse_period;
+      continue;
+    }
+
+    // sleep until shortly before the deadline, unless the timeline or transport changes.
+    bool changed = master.condition.wait_until(lock, deadline - settings.spin, [this, generation] {
+                                                                                 return !running || master.generation != generation;
+                                                                               });
+    if (changed) continue;
+
+    master.pulse++;
+
+    // hand the message over ahead of its deadline, its sender waits out the rest.
+    lock.unlock();
+    sync_out.get_subscriber().on_next(clock_sync_t{ .data = make_sync_message(MidiSync::TimingClock), .due = deadline });
+    lock.lock();
+  }
+}
+
+std::chrono::steady_clock::time_point Clock::tick_deadline(double tick) {
+  return master.anchor +
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>
+    (std::chrono::duration<double, std::nano>(master.tick_period) * (tick - master.base));
+}
+
+void Clock::follow() {
+  make_realtime("clock", settings.tick_thread);
+
+  std::unique_lock<std::mutex> lock(sync.mutex);
+
+  while (running) {
+    std::optional<PhaseLockedLoop::time_point_t> deadline;
+
+    // wait until we can predict when the next tick is due. we predict at most one
+    // clock message past the most recent one, so if the external clock disappears
+    // without sending a stop, we overshoot by at most one clock (less than 3 ticks).
+    sync.condition.wait(lock, [this, &deadline] {
+                                if (!running) return true;
+                                if (!sync.playing) return false;
+
+                                // the position of the next tick in midi clocks relative to the pll.
+                                double position =
+                                  ((double)(sync.tick * MIDI_CLOCK_PPQN) / (double)PPQN::Max) - sync.origin;
+
+                                if (position >= sync.pll.pulses() + 1) return false;
+
+                                deadline = sync.pll.predict(position);
+                                return deadline.has_value();
+                              });
+    if (!running) break;
+
+    auto generation = sync.generation;
+
+    lock.unlock();
+    wait_until(*deadline, settings.spin);
+    lock.lock();
+
+    // if the transport changed while we were waiting, this tick is stale.
+    if (sync.generation != generation || !sync.playing) continue;
+
+    tick_t tick = { .index  = sync.tick++,
+                    .time   = *deadline,
+                    .period = (sync.pll.period() * MIDI_CLOCK_PPQN) / PPQN::Max,
+    };
+
+    lock.unlock();
+    emit(tick);
+    lock.lock();
+  }
+}
+
+void Clock::emit(tick_t tick) {
+  // lateness is measured by the device (i.e. in virtual time for virtual devices) while
+  // the fan-out is always measured in real time.
+  auto late  = std::chrono::duration_cast<std::chrono::nanoseconds>(device->now() - tick.time).count();
+  auto start = std::chrono::steady_clock::now();
+
+  get_subscriber().on_next(tick);
+
+  auto end = std::chrono::steady_clock::now();
+
+  // ticks are never emitted before their deadline, but they may be emitted back-to-back
+  // after it when catching up.
+  statistics.lateness.record(late > 0 ? late : 0);
+  statistics.fan_out.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+  if (end - start > tick.period) statistics.overruns++;
+}
+
+void Clock::receive(midi_event_t event) {
+  std::optional<ClockTransport> change;
+
+  {
+    std::lock_guard<std::mutex> guard(sync.mutex);
+
+    switch (static_cast<MidiSync>(event.data[0])) {
+    case MidiSync::TimingClock:
+      // clock messages received while stopped don't move the song position.
+      if (!sync.playing) break;
+
+      sync.pll.pulse(event.timestamp);
+      sync.pulse++;
+      break;
+
+    case MidiSync::Start:
+      // the first clock message after a start is the beginning of the song.
+      sync.playing = true;
+      sync.pulse   = 0;
+      sync.origin  = 0;
+      sync.tick    = 0;
+      sync.pll.reset();
+      sync.generation++;
+      change = ClockTransport::Start;
+      break;
+
+    case MidiSync::Continue:
+      // the first clock message after a continue is at the current song position.
+      sync.playing = true;
+      sync.origin  = sync.pulse;
+      sync.pll.reset();
+      sync.generation++;
+      change = ClockTransport::Continue;
+      break;
+
+    case MidiSync::Stop:
+      sync.playing = false;
+      sync.generation++;
+      change = ClockTransport::Stop;
+      break;
+
+    case MidiSync::SongPosition:
+      // the song position can only be moved while stopped.
+      if (sync.playing) break;
+
+      sync.pulse = midi_song_position(event.data) * MIDI_CLOCKS_PER_MIDI_BEAT;
+      sync.tick  = (sync.pulse * PPQN::Max) / MIDI_CLOCK_PPQN;
+      sync.generation++;
+      break;
+    }
+  }
+
+  sync.condition.notify_all();
+
+  if (change) transport.get_subscriber().on_next(*change);
+}
@@ -9,24 +9,290 @@
 #ifndef IO_CLOCK_H
 #define IO_CLOCK_H
 
+#include <mutex>
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <string>
 #include <thread>
+#include <vector>
+#include <condition_variable>
 
 #include "anemone/rx.hpp"
 #include "anemone/types.hpp"
 #include "anemone/state.hpp"
+#include "anemone/config.hpp"
+#include "anemone/util/realtime.hpp"
+#include "anemone/util/histogram.hpp"
 
+#include "anemone/io/clock/pll.hpp"
+#include "anemone/io/clock/tempo.hpp"
+#include "anemone/io/clock/device/clock.hpp"
+#include "anemone/io/midi/midi.hpp"
 
+
+/// @brief an outgoing midi sync message, stamped with when it should be sent.
+struct clock_sync_t {
+  midi_data_t                           data;
+  std::chrono::steady_clock::time_point due;
+};
+
+
+/// @brief Clock which emits `PPQN::Max` ticks per beat.
+///
+/// @details
+/// by default, the clock generates ticks from its tempo map, which follows the global
+/// bpm and can ramp between tempos. ticks are scheduled against absolute deadlines on
+/// the monotonic clock: each deadline is the previous one plus the (integer) period
+/// between them, i.e. the n-th tick after a tempo change is due at `anchor + n * period`.
+/// this way, however long subscribers take to process a tick, it never accumulates into
+/// tempo drift. tempo changes are picked up on tick boundaries, the period following a
+/// tick is always the one it is emitted with, so the beat phase is continuous across
+/// tempo changes. the clock sleeps until shortly before each deadline and busy-waits
+/// for the rest (see `wait_until`).
+///
+/// if subscribers take so long that whole deadlines are missed, the clock emits the
+/// missed ticks back-to-back to catch up, up to a configurable limit. beyond this
+/// limit the missed ticks are dropped, the clock resyncs to the current time and the
+/// drop is logged.
+///
+/// alternatively, the clock can follow an external midi clock (24 ppqn) from a midi
+/// input. incoming clock messages are smoothed by a phase locked loop and the ticks
+/// in between them are scheduled from its predictions, so subscribers still see evenly
+/// spaced ticks rather than bursts of ticks whenever a clock message arrives. the
+/// external start, stop, continue and song position messages are followed as well.
+///
+/// when generating ticks internally, the clock also acts as a midi clock master. midi
+/// clock messages (24 ppqn) are scheduled on a dedicated thread against the exact
+/// (fractional) tick deadlines they fall on, so they stay locked to the ticks without
+/// ever waiting on tick subscribers. together with the start, stop, continue and song
+/// position messages sent on transport changes, they are emitted on `sync_events`,
+/// shortly (`spin`) before they are due and stamped with their due time, so that
+/// whoever sends them (e.g. the `MidiScheduler`) sends them right on time.
+///
+/// when idling is enabled, the tick loop & midi sync output block (rather than waking up
+/// on every tick) while the clock is told it is idle, e.g. when nothing is playing. when
+/// it stops idling, the ticks resume right away on a fresh timeline. idling only applies
+/// to real-time clock devices and never while the outgoing transport is playing.
+///
+/// the time itself comes from an injected `ClockDevice`: either the system's monotonic
+/// clock (`SystemClock`) or virtual time (`VirtualClock`), in which case ticks are
+/// emitted as fast as the subscribers process them, or stepped one by one.
+///
 class Clock : rx::subject<tick_t> {
 public:
-  Clock(std::shared_ptr<State>);
+  /// @brief where the clock gets its timing from.
+  enum class Source {
+                     /// generate ticks from the global bpm.
+                     Internal,
+                     /// follow an external midi clock.
+                     Midi,
+  };
+
+  /// @brief tick engine settings.
+  struct settings_t {
+    /// @brief how long to busy-wait before each tick deadline.
+    std::chrono::microseconds spin;
+
+    /// @brief maximum number of missed ticks to catch up on. beyond this, missed
+    /// ticks are dropped.
+    unsigned int catch_up;
+
+    /// @brief where the clock gets its timing from.
+    Source source = Source::Internal;
+
+    /// @brief name of the midi input to follow when the source is `Source::Midi`.
+    std::string input = "";
+
+    /// @brief real-time settings of the tick thread.
+    realtime_thread_t tick_thread = {};
+
+    /// @brief real-time settings of the midi sync output thread.
+    realtime_thread_t sync_thread = {};
+
+    /// @brief whether the tick loop may idle (see `idle`).
+    bool idle = false;
+  };
+
+  /// @brief constructs a clock configured by the `clock` section of the config.
+  Clock(std::shared_ptr<Config>,
+        std::shared_ptr<State>,
+        std::shared_ptr<Midi>,
+        std::shared_ptr<ClockDevice>);
+
+  /// @brief constructs a clock from explicit settings.
+  ///
+  /// @param device          the clock device providing the time.
+  /// @param settings        the tick engine settings.
+  /// @param bpm_events      stream of bpm changes (for the internal source).
+  /// @param timing_events   stream of midi sync messages (for the midi source).
+  ///
+  Clock(std::shared_ptr<ClockDevice>,
+        settings_t,
+        rx::observable<double>,
+        rx::observable<midi_event_t> = rx::observable<>::never<midi_event_t>());
 
+  ~Clock();
+
+  /// @brief starts the tick thread and returns the stream of ticks.
   rx::observable<tick_t> connect();
+
+  /// @brief stops the tick & midi sync threads after the current tick, and waits for
+  /// them to finish.
+  void disconnect();
+
+  /// @brief stream of transport changes (when following an external clock).
+  rx::observable<ClockTransport> transport_events();
+
+  /// @brief stream of outgoing midi sync messages (when generating ticks internally).
+  rx::observable<clock_sync_t> sync_events();
+
+  /// @brief starts the outgoing transport from the top on the next tick.
+  void start();
+
+  /// @brief stops the outgoing transport, remembering its song position.
+  void stop();
+
+  /// @brief resumes the outgoing transport from the song position it was stopped at.
+  void resume();
+
+  /// @brief total number of ticks dropped because their deadlines were missed.
+  unsigned long dropped_ticks();
+
+  /// @brief the tempo map driving the internal tick loop, e.g. to ramp the tempo.
+  TempoMap& tempo();
+
+  /// @brief tells the clock whether anything needs ticks.
+  ///
+  /// @details
+  /// while idle, the tick loop and midi sync output block until the clock is no longer
+  /// idle, at which point the next tick is emitted right away.
+  ///
+  /// @param idle   whether the clock may idle.
+  ///
+  void idle(bool);
+
+  /// @brief whether the clock is idle.
+  bool is_idle();
+
+  /// @brief tick timing statistics.
+  struct stats_t {
+    /// @brief how late each tick was emitted relative to its deadline (in ns).
+    Histogram lateness;
+
+    /// @brief how long each tick took to be processed by all subscribers (in ns).
+    Histogram fan_out;
+
+    /// @brief number of ticks which took longer than a tick period to be processed.
+    std::atomic<unsigned long> overruns = 0;
+
+    /// @brief number of times the tick & midi sync threads woke up (never reset).
+    std::atomic<unsigned long> wakeups = 0;
+  };
+
+  /// @brief the tick timing statistics.
+  stats_t& stats();
+
+  /// @brief logs a summary of the tick timing statistics.
+  ///
+  /// @param reset   whether to start over afterwards (e.g. for periodic reports).
+  ///
+  void log_stats(bool reset);
   
 private:
-  double bpm;
-  std::chrono::microseconds period;
+  settings_t settings;
+
+  /// @brief the clock device providing the time.
+  std::shared_ptr<ClockDevice> device;
+
+  /// @brief tempo changes published to the tick loop.
+  TempoMap tempo_map;
+
+  std::atomic<bool> running = false;
+  std::atomic<unsigned long> dropped = 0;
+
+  /// @brief the tick thread (following the external clock or not).
+  std::thread ticker;
+
+  /// @brief the midi sync output thread.
+  std::thread syncer;
+
+  stats_t statistics;
+
+  /// @brief incoming midi sync messages.
+  rx::observable<midi_event_t> timing;
+
+  /// @brief outgoing transport changes.
+  rx::subject<ClockTransport> transport;
+
+  /// @brief outgoing midi sync messages.
+  rx::subject<clock_sync_t> sync_out;
+
+  /// @brief number of ticks emitted so far (including the one being emitted), i.e. the
+  /// index of the next tick.
+  std::atomic<long> ticks = 0;
+
+  /// @brief state shared between the tick thread, the midi sync output thread and
+  /// callers changing the outgoing transport.
+  struct {
+    std::mutex              mutex;
+    std::condition_variable condition;
+
+    /// @brief when tick `base` is due. tick `n` is due at `anchor + (n - base) * tick_period`.
+    std::chrono::steady_clock::time_point anchor;
+    long                                  base = 0;
+    std::chrono::nanoseconds              tick_period;
+
+    bool playing    = false;
+    /// @brief the tick at which the song position was 0.
+    long phase      = 0;
+    /// @brief song position (in ticks) the transport was stopped at.
+    long position   = 0;
+    /// @brief song position (in midi clocks) of the next midi clock message.
+    long pulse      = 0;
+    /// @brief transport messages to send before the next midi clock message.
+    std::vector<midi_data_t> pending;
+    /// @brief bumped whenever the timeline or the transport changes.
+    long generation = 0;
+    /// @brief whether nothing needs ticks (only changed with the mutex held).
+    std::atomic<bool> idle = false;
+  } master;
+
+  /// @brief state shared between the midi input thread and the tick thread when
+  /// following an external clock.
+  struct {
+    std::mutex              mutex;
+    std::condition_variable condition;
+    PhaseLockedLoop         pll;
+
+    bool playing    = false;
+    /// @brief song position (in midi clocks) of the next incoming clock message.
+    long pulse      = 0;
+    /// @brief song position (in midi clocks) of the pll's position 0.
+    long origin     = 0;
+    /// @brief song position (in ticks) of the next tick to emit.
+    long tick       = 0;
+    /// @brief bumped on every transport change so in-flight ticks can be discarded.
+    long generation = 0;
+  } sync;
+
+  /// @brief the internal tick loop.
+  void run();
+
+  /// @brief the tick loop when following an external clock.
+  void follow();
+
+  /// @brief emits a tick to the subscribers, recording its timing.
+  void emit(tick_t);
+
+  /// @brief the midi sync output loop.
+  void send_sync();
+
+  /// @brief when the provided (fractional) tick is due. expects `master.mutex` to be held.
+  std::chrono::steady_clock::time_point tick_deadline(double);
+
+  /// @brief handles an incoming midi sync message.
+  void receive(midi_event_t);
 };
 
 #endif
@@ -0,0 +1,48 @@
+/**
+ * @file   io/clock/device/clock.hpp
+ * @brief  IO Clock Device Interface
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef IO_CLOCK_DEVICE_H
+#define IO_CLOCK_DEVICE_H
+
+#include <chrono>
+
+
+/// @brief Interface for clock devices.
+///
+/// @details
+/// This class defines where the `Clock` gets its notion of time from: what time it is
+/// and how to wait until a tick deadline. This interface allows for dependency injection
+/// so that the clock can either follow the system's monotonic clock or run in virtual
+/// time (e.g. to simulate a performance faster than real-time, or to step ticks one by
+/// one in tests).
+///
+class ClockDevice {
+public:
+  typedef std::chrono::steady_clock::time_point time_point_t;
+
+  virtual ~ClockDevice() = default;
+
+  /// @brief the current time.
+  virtual time_point_t now() = 0;
+
+  /// @brief waits until the provided tick deadline.
+  ///
+  /// @param deadline   the time to wait until.
+  /// @param spin       how long before the deadline to stop sleeping and busy-wait (if
+  ///                   the device actually waits).
+  ///
+  virtual void wait_until(time_point_t deadline, std::chrono::microseconds spin) = 0;
+
+  /// @brief wakes up any thread waiting in `wait_until` (e.g. when the clock disconnects).
+  virtual void interrupt() = 0;
+
+  /// @brief whether time passes on its own (as opposed to only when ticks advance).
+  virtual bool is_realtime() = 0;
+};
+
+#endif
@@ -0,0 +1,17 @@
+#include "anemone/util/wait.hpp"
+#include "anemone/io/clock/device/system.hpp"
+
+
+ClockDevice::time_point_t SystemClock::now() {
+  return std::chrono::steady_clock::now();
+}
+
+void SystemClock::wait_until(time_point_t deadline, std::chrono::microseconds spin) {
+  ::wait_until(deadline, spin);
+}
+
+void SystemClock::interrupt() {}
+
+bool SystemClock::is_realtime() {
+  return true;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file   io/clock/device/system.hpp
+ * @brief  System Clock Device Class
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef IO_CLOCK_DEVICE_SYSTEM_H
+#define IO_CLOCK_DEVICE_SYSTEM_H
+
+#include "anemone/io/clock/device/clock.hpp"
+
+
+/// @brief Clock device following the system's monotonic clock.
+class SystemClock : public ClockDevice {
+public:
+  virtual time_point_t now() override;
+
+  /// @brief sleeps until shortly before the deadline and busy-waits for the rest (see `::wait_until`).
+  virtual void wait_until(time_point_t, std::chrono::microseconds) override;
+
+  /// @brief does nothing, waits always end at their deadline.
+  virtual void interrupt() override;
+
+  virtual bool is_realtime() override;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#include "anemone/io/clock/device/virtual.hpp"
+
+
+VirtualClock::VirtualClock(Mode mode)
+  : mode(mode)
+{}
+
+ClockDevice::time_point_t VirtualClock::now() {
+  std::lock_guard<std::mutex> guard(mutex);
+  return time;
+}
+
+void VirtualClock::wait_until(time_point_t deadline, std::chrono::microseconds) {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  if (mode == Mode::Stepped) {
+    // let `step` know the previous tick has been processed, and wait to be released.
+    waiting = true;
+    condition.notify_all();
+    condition.wait(lock, [this] { return released > 0 || interrupted; });
+    waiting = false;
+
+    if (interrupted) return;
+    released--;
+  }
+
+  if (deadline > time) time = deadline;
+}
+
+void VirtualClock::interrupt() {
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    interrupted = true;
+  }
+
+  condition.notify_all();
+}
+
+bool VirtualClock::is_realtime() {
+  return false;
+}
+
+void VirtualClock::step(unsigned long ticks) {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  released += ticks;
+  condition.notify_all();
+
+  // the ticks have been processed once they have all started and the clock is back
+  // to waiting for more.
+  condition.wait(lock, [this] { return (released == 0 && waiting) || interrupted; });
+}
@@ -0,0 +1,73 @@
+/**
+ * @file   io/clock/device/virtual.hpp
+ * @brief  Virtual Clock Device Class
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef IO_CLOCK_DEVICE_VIRTUAL_H
+#define IO_CLOCK_DEVICE_VIRTUAL_H
+
+#include <mutex>
+#include <condition_variable>
+
+#include "anemone/io/clock/device/clock.hpp"
+
+
+/// @brief Clock device running in virtual time.
+///
+/// @details
+/// time never passes on its own, it jumps straight to each tick deadline. in free
+/// running mode, this happens as soon as the previous tick has been processed, so the
+/// clock runs as fast as its subscribers can keep up. in stepped mode, ticks are only
+/// released by calls to `step`, which makes playback fully deterministic (e.g. for tests).
+///
+/// virtual time starts at the epoch of `std::chrono::steady_clock`.
+///
+class VirtualClock : public ClockDevice {
+public:
+  enum class Mode {
+                   /// advance to each tick deadline right away.
+                   FreeRunning,
+                   /// advance to each tick deadline when stepped.
+                   Stepped,
+  };
+
+  VirtualClock(Mode = Mode::FreeRunning);
+
+  virtual time_point_t now() override;
+
+  /// @brief advances the time to the deadline (once stepped, in stepped mode).
+  virtual void wait_until(time_point_t, std::chrono::microseconds) override;
+
+  virtual void interrupt() override;
+
+  virtual bool is_realtime() override;
+
+  /// @brief releases ticks and waits until they have been processed.
+  ///
+  /// @remark only meaningful in stepped mode.
+  ///
+  /// @param ticks   the number of ticks to release.
+  ///
+  void step(unsigned long ticks = 1);
+
+private:
+  Mode mode;
+
+  std::mutex              mutex;
+  std::condition_variable condition;
+
+  time_point_t time = {};
+
+  /// @brief number of ticks released but not yet started.
+  unsigned long released = 0;
+
+  /// @brief whether the clock is waiting for ticks to be released.
+  bool waiting = false;
+
+  bool interrupted = false;
+};
+
+#endif
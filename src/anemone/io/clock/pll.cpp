@@ -0,0 +1,69 @@
+#include <cmath>
+
+#include "anemone/io/clock/pll.hpp"
+
+
+PhaseLockedLoop::PhaseLockedLoop()
+  : PhaseLockedLoop(settings_t{})
+{}
+
+PhaseLockedLoop::PhaseLockedLoop(settings_t settings)
+  : settings(settings)
+{}
+
+void PhaseLockedLoop::reset() {
+  count = 0;
+}
+
+void PhaseLockedLoop::pulse(time_point_t time) {
+  // the first pulse after a reset just fixes the phase.
+  if (count == 0) {
+    estimate = time;
+    count++;
+    return;
+  }
+
+  // the second pulse gives us our first period measurement, unless we already
+  // have one from before a reset.
+  if (pulse_period.count() <= 0) {
+    pulse_period = time - estimate;
+    estimate = time;
+    count++;
+    return;
+  }
+
+  auto predicted = estimate + std::chrono::duration_cast<duration_t>(pulse_period);
+  auto error     = std::chrono::duration<double, std::nano>(time - predicted);
+
+  // if the error is huge (a tempo jump, or we missed pulses) smoothing would take
+  // forever to converge, so start over from the measured interval instead.
+  if (std::abs(error.count()) > pulse_period.count()) {
+    pulse_period = time - estimate;
+    estimate = time;
+    count++;
+    return;
+  }
+
+  estimate      = predicted + std::chrono::duration_cast<duration_t>(error * settings.phase_gain);
+  pulse_period += error * settings.period_gain;
+  count++;
+}
+
+long PhaseLockedLoop::pulses() {
+  return count;
+}
+
+PhaseLockedLoop::duration_t PhaseLockedLoop::period() {
+  return std::chrono::duration_cast<duration_t>(pulse_period);
+}
+
+std::optional<PhaseLockedLoop::time_point_t> PhaseLockedLoop::predict(double position) {
+  if (count == 0) return std::nullopt;
+
+  // how far is the position from the most recent pulse?
+  double offset = position - (double)(count - 1);
+
+  if (offset > 0 && pulse_period.count() <= 0) return std::nullopt;
+
+  return estimate + std::chrono::duration_cast<duration_t>(pulse_period * offset);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file   io/clock/pll.hpp
+ * @brief  Phase Locked Loop for following external clocks
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef IO_CLOCK_PLL_H
+#define IO_CLOCK_PLL_H
+
+#include <chrono>
+#include <optional>
+
+
+/// @brief Phase locked loop which tracks a stream of evenly spaced pulses.
+///
+/// @details
+/// external clocks (e.g. midi clock at 24 ppqn) arrive with jitter, so we can't
+/// just emit ticks whenever a pulse arrives. instead, this second order loop keeps
+/// an estimate of when the most recent pulse *should* have happened and of the pulse
+/// period. each new pulse is compared against its prediction and the phase error
+/// nudges both estimates. the result is a smoothed timeline from which we can predict
+/// the time of any fractional pulse position, which is how we upsample pulses to ticks.
+///
+/// positions are counted in pulses since the last `reset`, i.e. the first pulse after
+/// a reset is at position 0.
+///
+class PhaseLockedLoop {
+public:
+  typedef std::chrono::steady_clock::time_point time_point_t;
+  typedef std::chrono::steady_clock::duration   duration_t;
+
+  /// @brief loop gains.
+  ///
+  /// @remark the defaults give a critically damped loop which settles within ~10 pulses
+  /// (about half a beat at midi clock rates).
+  struct settings_t {
+    /// @brief fraction of the phase error applied to the phase estimate.
+    double phase_gain  = 0.2;
+    /// @brief fraction of the phase error applied to the period estimate.
+    double period_gain = 0.011;
+  };
+
+  PhaseLockedLoop();
+  PhaseLockedLoop(settings_t);
+
+  /// @brief forgets the phase, but keeps the period estimate as a starting point.
+  void reset();
+
+  /// @brief feeds the next pulse into the loop.
+  ///
+  /// @param time   when the pulse was received.
+  ///
+  void pulse(time_point_t);
+
+  /// @brief number of pulses received since the last reset.
+  long pulses();
+
+  /// @brief the current pulse period estimate (zero if unknown).
+  duration_t period();
+
+  /// @brief predicts when the provided pulse position happens.
+  ///
+  /// @param position   pulse position since the last reset (may be fractional).
+  ///
+  /// @return the predicted time, or nothing if we can't predict it yet (no pulses
+  /// received, or the position is after the most recent pulse and we don't know the
+  /// period yet).
+  ///
+  std::optional<time_point_t> predict(double position);
+
+private:
+  settings_t settings;
+
+  /// @brief number of pulses received since the last reset.
+  long count = 0;
+
+  /// @brief filtered time of the most recent pulse.
+  time_point_t estimate;
+
+  /// @brief filtered pulse period.
+  std::chrono::duration<double, std::nano> pulse_period = std::chrono::duration<double, std::nano>(0);
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include <cmath>
+
+#include "anemone/types/controls/ppqn.hpp"
+#include "anemone/io/clock/tempo.hpp"
+
+
+TempoMap::TempoMap(double bpm)
+  : from(bpm),
+    to(bpm)
+{}
+
+void TempoMap::set(double bpm) {
+  publish({ .from = bpm, .to = bpm, .ticks = 0, .curve = Ramp::Linear });
+}
+
+void TempoMap::ramp(double bpm, double beats, Ramp curve) {
+  publish({ .from  = -1,
+            .to    = bpm,
+            .ticks = std::lround(beats * PPQN::Max),
+            .curve = curve,
+    });
+}
+
+double TempoMap::bpm() const {
+  return to.load(std::memory_order_relaxed);
+}
+
+void TempoMap::publish(segment_t segment) {
+  std::lock_guard<std::mutex> guard(writer);
+
+  sequence.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  from.store(segment.from, std::memory_order_relaxed);
+  to.store(segment.to, std::memory_order_relaxed);
+  ticks.store(segment.ticks, std::memory_order_relaxed);
+  curve.store(segment.curve, std::memory_order_relaxed);
+
+  sequence.fetch_add(1, std::memory_order_release);
+}
+
+bool TempoMap::poll(unsigned long& version, segment_t& segment) const {
+  auto before = sequence.load(std::memory_order_acquire);
+
+  // nothing new, or a writer is in the middle of publishing.
+  if (before == version || (before & 1)) return false;
+
+  segment_t read = { .from  = from.load(std::memory_order_relaxed),
+                     .to    = to.load(std::memory_order_relaxed),
+                     .ticks = ticks.load(std::memory_order_relaxed),
+                     .curve = curve.load(std::memory_order_relaxed),
+  };
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  // a writer got in while we were reading, try again on the next tick.
+  if (sequence.load(std::memory_order_relaxed) != before) return false;
+
+  version = before;
+  segment = read;
+
+  return true;
+}
+
+double TempoMap::bpm_at(const segment_t& segment, long tick) {
+  if (tick >= segment.ticks || segment.ticks <= 0) return segment.to;
+  if (tick <= 0) return segment.from;
+
+  double progress = (double)tick / (double)segment.ticks;
+
+  switch (segment.curve) {
+  case Ramp::Exponential:
+    return segment.from * std::pow(segment.to / segment.from, progress);
+  case Ramp::Linear:
+  default:
+    return segment.from + ((segment.to - segment.from) * progress);
+  }
+}
+
+std::chrono::nanoseconds TempoMap::period_at(const segment_t& segment, long tick) {
+  return period(bpm_at(segment, tick));
+}
+
+std::chrono::nanoseconds TempoMap::period(double bpm) {
+  return std::chrono::nanoseconds(std::llround((60.0 * 1000 * 1000 * 1000) / (bpm * (double)PPQN::Max)));
+}
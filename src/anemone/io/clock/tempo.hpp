@@ -0,0 +1,113 @@
+/**
+ * @file   io/clock/tempo.hpp
+ * @brief  Tempo Map Class
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef IO_CLOCK_TEMPO_H
+#define IO_CLOCK_TEMPO_H
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+
+/// @brief Tempo changes published to the tick engine.
+///
+/// @details
+/// the tempo is described by a single segment: a ramp from one tempo to another over
+/// a number of ticks, after which the tempo holds. a plain tempo change is a segment of
+/// zero ticks. writers publish a new segment (from any thread), and the tick thread
+/// picks it up with `poll` at the next tick boundary, at which point the segment starts.
+///
+/// segments are published with a sequence lock, so `poll` never blocks nor allocates: if
+/// it races with a writer, it just reports nothing and the segment is picked up on the
+/// following tick instead. writers are serialized among themselves with a mutex.
+///
+class TempoMap {
+public:
+  /// @brief how the tempo moves over a ramp.
+  enum class Ramp {
+                   /// the bpm changes by the same amount every tick.
+                   Linear,
+                   /// the bpm changes by the same ratio every tick.
+                   Exponential,
+  };
+
+  /// @brief a tempo segment, starting on the tick it was picked up on.
+  struct segment_t {
+    /// @brief the bpm at the start of the segment, negative to start from the tempo
+    /// in effect when the segment is picked up.
+    double from;
+
+    /// @brief the bpm at the end of the segment.
+    double to;
+
+    /// @brief the length of the ramp in ticks.
+    long ticks;
+
+    Ramp curve;
+  };
+
+  TempoMap(double bpm = 120);
+
+  /// @brief changes the tempo on the next tick.
+  void set(double bpm);
+
+  /// @brief ramps from the current tempo to the provided one, starting on the next tick.
+  ///
+  /// @param bpm     the tempo at the end of the ramp.
+  /// @param beats   the length of the ramp in beats.
+  /// @param curve   how the tempo moves over the ramp.
+  ///
+  void ramp(double bpm, double beats, Ramp = Ramp::Linear);
+
+  /// @brief the tempo most recently published (i.e. the tempo held after it).
+  double bpm() const;
+
+  /// @brief picks up the segment published since the provided version.
+  ///
+  /// @remark this is wait-free and meant to be called from the tick thread.
+  ///
+  /// @param version   the version last picked up, updated when a segment is picked up.
+  /// @param segment   set to the new segment, if there is one.
+  ///
+  /// @return whether a new segment was picked up.
+  ///
+  bool poll(unsigned long& version, segment_t& segment) const;
+
+  /// @brief the bpm on a tick of a segment.
+  ///
+  /// @param segment   the segment (with a resolved `from`).
+  /// @param tick      the tick relative to the start of the segment.
+  ///
+  static double bpm_at(const segment_t&, long tick);
+
+  /// @brief the period between a tick of a segment and the next one.
+  ///
+  /// @param segment   the segment (with a resolved `from`).
+  /// @param tick      the tick relative to the start of the segment.
+  ///
+  static std::chrono::nanoseconds period_at(const segment_t&, long tick);
+
+  /// @brief the period between ticks at the provided bpm.
+  static std::chrono::nanoseconds period(double bpm);
+
+private:
+  /// @brief serializes writers.
+  std::mutex writer;
+
+  /// @brief odd while a segment is being written.
+  std::atomic<unsigned long> sequence = 0;
+
+  std::atomic<double> from;
+  std::atomic<double> to;
+  std::atomic<long>   ticks = 0;
+  std::atomic<Ramp>   curve = Ramp::Linear;
+
+  void publish(segment_t);
+};
+
+#endif
@@ -11,24 +11,46 @@ Animator::Animator(std::shared_ptr<GridDevice> grid_device, std::shared_ptr<Layo
 void Animator::run() {
   // begin animation loop
   std::thread t([this] () {
-                  auto t = std::chrono::milliseconds(0);
-                  
+                  auto t    = std::chrono::milliseconds(0);
+                  auto next = std::chrono::steady_clock::now();
+
                   while (true) {
-                    auto t1 = std::chrono::high_resolution_clock::now();
+                    // with nothing to animate, sleep until there is.
+                    {
+                      std::unique_lock<std::mutex> guard(lock);
+                      if (pixels.empty()) {
+                        condition.wait(guard, [this] { return !pixels.empty(); });
+                        next = std::chrono::steady_clock::now();
+                      }
+                    }
+
+                    frames++;
 
                     render(t);
                     t += period;
-                    
-                    auto t2 = std::chrono::high_resolution_clock::now();
-                    auto wait = period - std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t2);
+                    next += period;
 
-                    std::this_thread::sleep_for(wait);
+                    std::this_thread::sleep_until(next);
                   }
                 });
 
   t.detach();
 }
 
+unsigned long Animator::wakeups() {
+  return frames;
+}
+
+void Animator::update_active() {
+  std::lock_guard<std::mutex> guard(lock);
+
+  bool animating = !pixels.empty();
+  if (animating) condition.notify_all();
+
+  // changes are announced with the lock held so they are never announced out of order.
+  if (active.get_value() != animating) active.get_subscriber().on_next(animating);
+}
+
 void Animator::render(std::chrono::milliseconds t) {
   std::lock_guard<std::mutex> guard(lock);
 
@@ -43,12 +65,16 @@ void Animator::render(std::chrono::milliseconds t) {
 }
 
 void Animator::add(std::shared_ptr<Animation> animation, grid_addr_t grid_addr) {
-  std::lock_guard<std::mutex> guard(lock);
+  {
+    std::lock_guard<std::mutex> guard(lock);
 
-  // translate grid_addr to grid_coordinates.
-  auto coordinates = current_layout->translate(grid_addr);
+    // translate grid_addr to grid_coordinates.
+    auto coordinates = current_layout->translate(grid_addr);
 
-  pixels[coordinates] = animation;
+    pixels[coordinates] = animation;
+  }
+
+  update_active();
 }
 
 void Animator::add(std::unordered_map<grid_addr_t, std::shared_ptr<Animation>, grid_addr_hasher> grid_addr_to_animation) {
@@ -58,23 +84,31 @@ void Animator::add(std::unordered_map<grid_addr_t, std::shared_ptr<Animation>, g
 }
 
 void Animator::remove(grid_addr_t grid_addr) {
-  std::lock_guard<std::mutex> guard(lock);
+  {
+    std::lock_guard<std::mutex> guard(lock);
   
-  // translate grid_addr to grid_coordinates.
-  auto coordinates = current_layout->translate(grid_addr);
+    // translate grid_addr to grid_coordinates.
+    auto coordinates = current_layout->translate(grid_addr);
   
-  pixels.erase(coordinates);
+    pixels.erase(coordinates);
+  }
+
+  update_active();
 }
 
 void Animator::remove(grid_addr_t grid_addr, unsigned int intensity) {
-  std::lock_guard<std::mutex> guard(lock);
+  {
+    std::lock_guard<std::mutex> guard(lock);
   
-  // translate grid_addr to grid_coordinates.
-  auto coordinates = current_layout->translate(grid_addr);
+    // translate grid_addr to grid_coordinates.
+    auto coordinates = current_layout->translate(grid_addr);
+
+    pixels.erase(coordinates);
 
-  pixels.erase(coordinates);
+    grid_device->set(coordinates, intensity);
+  }
 
-  grid_device->set(coordinates, intensity);
+  update_active();
 }
 
 void Animator::remove(std::vector<grid_addr_t> grid_addrs) {
@@ -10,8 +10,10 @@
 #define IO_GRID_ANIMATION_ANIMATOR_H
 
 #include <mutex>
+#include <atomic>
 #include <memory>
 #include <unordered_map>
+#include <condition_variable>
 
 #include "anemone/rx.hpp"
 #include "anemone/config.hpp"
@@ -41,8 +43,18 @@ public:
   Animator(std::shared_ptr<GridDevice>, std::shared_ptr<Layout>);
 
   /// @brief begins tha animation loop.
+  ///
+  /// @remark the loop only wakes up while there are animations to render, otherwise
+  /// it blocks until an animation is added.
+  ///
   void run();
 
+  /// @brief whether any animation is registered.
+  rx::behavior<bool> active = rx::behavior<bool>(false);
+
+  /// @brief number of frames rendered so far.
+  unsigned long wakeups();
+
   /// @brief add an animation to a grid address.
   ///
   /// @param animation    a pointer to an animation.
@@ -91,6 +103,12 @@ private:
 
   /// @brief mutex for accessinng pixel map.
   std::mutex lock;
+
+  /// @brief signalled when animations are added.
+  std::condition_variable condition;
+
+  /// @brief number of frames rendered so far.
+  std::atomic<unsigned long> frames = 0;
   
   /// @brief frame period.
   ///
@@ -107,6 +125,9 @@ private:
 
   /// @brief renders current animation frame.
   void render(std::chrono::milliseconds);
+
+  /// @brief updates `active` after the pixel map changed.
+  void update_active();
 };
 
 #endif
@@ -0,0 +1,14 @@
+#include "anemone/io/grid/device/null.hpp"
+
+
+void NullGrid::connect(std::string addr) {}
+
+rx::observable<grid_device_event_t> NullGrid::listen() {
+  return get_observable();
+}
+
+void NullGrid::turn_off(grid_coordinates_t c) {}
+
+void NullGrid::turn_on(grid_coordinates_t c) {}
+
+void NullGrid::set(grid_coordinates_t c, unsigned int intensity) {}
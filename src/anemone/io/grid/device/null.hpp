@@ -0,0 +1,36 @@
+/**
+ * @file   io/grid/device/null.hpp
+ * @brief  Null Implementation of Grid Device
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef IO_GRID_NULL_H
+#define IO_GRID_NULL_H
+
+#include <string>
+
+#include "anemone/rx.hpp"
+#include "anemone/types.hpp"
+
+#include "anemone/io/grid/device/grid.hpp"
+
+
+/// @brief Grid device without any hardware behind it.
+///
+/// @details
+/// it never sends any events and drops all led updates. this is used to run anemone
+/// headless (e.g. when rendering offline).
+///
+class NullGrid : public GridDevice {
+public:
+  virtual void connect(std::string addr) override;
+  virtual rx::observable<grid_device_event_t> listen() override;
+
+  virtual void turn_off(grid_coordinates_t c) override;
+  virtual void turn_on(grid_coordinates_t c) override;
+  virtual void set(grid_coordinates_t c, unsigned int intensity) override;
+};
+
+#endif
@@ -1,18 +1,80 @@
+#include <spdlog/spdlog.h>
+
 #include "anemone/io/io.hpp"
 
 
 IO::IO(std::shared_ptr<Config> config,
       std::shared_ptr<GridDevice> grid_device,
       std::shared_ptr<MidiDeviceFactory> midi_device_factory,
+       std::shared_ptr<ClockDevice> clock_device,
        std::shared_ptr<State> state)
+  : state(state)
 {
-  clock = std::make_shared<Clock>(state);
   grid = std::make_shared<Grid>(config, grid_device, state->layouts);
   midi = std::make_shared<Midi>(config, midi_device_factory);
+  scheduler = std::make_shared<MidiScheduler>(config, midi, clock_device);
+  clock = std::make_shared<Clock>(config, state, midi, clock_device);
+
+  // send midi clock & transport messages to the outputs which have clock enabled,
+  // through the scheduler so that its dispatcher is the only thread writing to them.
+  clock->sync_events()
+    .subscribe([scheduler = scheduler] (clock_sync_t sync) {
+                 scheduler->schedule_sync(sync.data, sync.due);
+               });
 }
 
 void IO::connect() {
-  clock_events = clock->connect();
+  // deferred actions are applied on ticks, so the clock may not idle while they wait.
+  state->deferred->on_pending = [this] { update_idle(); };
+
   grid_events = grid->connect();
   midi_events = midi->connect();
+  scheduler->connect();
+  clock_events = clock->connect();
+  transport_events = clock->transport_events();
+
+  // let the clock idle while no instrument is playing, nothing is animating and no
+  // deferred action is waiting for a tick (see above).
+  for (auto itr : state->instruments->by_name) {
+    itr.second->status.is_playing.get_observable()
+      .subscribe([this] (bool) { update_idle(); });
+  }
+  grid->animation->active.get_observable()
+    .subscribe([this] (bool) { update_idle(); });
+
+  last_report = { .time  = std::chrono::steady_clock::now(),
+                  .clock = clock->stats().wakeups,
+                  .grid  = grid->animation->wakeups(),
+  };
+}
+
+void IO::update_idle() {
+  std::lock_guard<std::mutex> guard(idle_mutex);
+
+  bool playing = false;
+  for (auto& itr : state->instruments->by_name) {
+    playing = playing || itr.second->is_playing();
+  }
+
+  clock->idle(!playing && !grid->animation->active.get_value() && !state->deferred->pending());
+}
+
+void IO::log_stats(bool reset) {
+  clock->log_stats(reset);
+
+  // wakeups of the periodic threads since the previous report.
+  auto now     = std::chrono::steady_clock::now();
+  auto seconds = std::chrono::duration<double>(now - last_report.time).count();
+  auto clock_wakeups = clock->stats().wakeups.load();
+  auto grid_wakeups  = grid->animation->wakeups();
+
+  if (seconds > 0) {
+    spdlog::info("wakeups -> {:.1f}/s (clock {:.1f}/s, grid {:.1f}/s){}",
+                 (double)((clock_wakeups - last_report.clock) + (grid_wakeups - last_report.grid)) / seconds,
+                 (double)(clock_wakeups - last_report.clock) / seconds,
+                 (double)(grid_wakeups - last_report.grid) / seconds,
+                 clock->is_idle() ? " | idle" : "");
+  }
+
+  last_report = { .time = now, .clock = clock_wakeups, .grid = grid_wakeups };
 }
@@ -9,6 +9,8 @@
 #ifndef IO_H
 #define IO_H
 
+#include <mutex>
+#include <chrono>
 #include <string>
 #include <memory>
 
@@ -16,9 +18,11 @@
 #include "anemone/state.hpp"
 
 #include "anemone/io/clock/clock.hpp"
+#include "anemone/io/clock/device/clock.hpp"
 #include "anemone/io/grid/grid.hpp"
 #include "anemone/io/grid/device/grid.hpp"
 #include "anemone/io/midi/midi.hpp"
+#include "anemone/io/midi/scheduler.hpp"
 #include "anemone/io/midi/device/factory.hpp"
 
 
@@ -32,6 +36,7 @@ public:
   /// @param config        pointer to a configuration object
   /// @param grid_device   pointer to a grid device object
   /// @param midi_device   pointer to a midi device object
+  /// @param clock_device  pointer to a clock device object
   /// @param state         pointer to the state
   ///
   /// @details
@@ -41,14 +46,22 @@ public:
   IO(std::shared_ptr<Config>,
      std::shared_ptr<GridDevice>,
      std::shared_ptr<MidiDeviceFactory> midi_device_factory,
+     std::shared_ptr<ClockDevice> clock_device,
      std::shared_ptr<State>);
 
   /// @brief Connects Grid & Midi objects to their ports.
   void connect();
 
+  /// @brief logs the clock timing stats & the wakeups of the periodic threads.
+  ///
+  /// @param reset   whether to start the clock timing stats over afterwards.
+  ///
+  void log_stats(bool reset);
+
   std::shared_ptr<Clock> clock;
   std::shared_ptr<Grid> grid;
   std::shared_ptr<Midi> midi;
+  std::shared_ptr<MidiScheduler> scheduler;
 
   /// @brief observable stream of grid events
   rx::observable<grid_event_t> grid_events;
@@ -58,6 +71,30 @@ public:
   
   /// @brief observable stream of clock events
   rx::observable<tick_t> clock_events;
+
+  /// @brief observable stream of transport changes from an external clock
+  rx::observable<ClockTransport> transport_events;
+
+private:
+  std::shared_ptr<State> state;
+
+  /// @brief wakeup counts as of the previous stats report.
+  struct {
+    std::chrono::steady_clock::time_point time;
+    unsigned long                         clock;
+    unsigned long                         grid;
+  } last_report;
+
+  /// @brief serializes telling the clock whether it may idle.
+  ///
+  /// @details this is updated from the grid, store and tick threads. computing whether
+  /// the clock may idle and telling it are one step, so that a stale answer (e.g. idle,
+  /// computed just before an action is deferred) is never told last.
+  ///
+  std::mutex idle_mutex;
+
+  /// @brief tells the clock whether it may idle.
+  void update_idle();
 };
 
 #endif
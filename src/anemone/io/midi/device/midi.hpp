@@ -52,6 +52,9 @@ class MidiOutputDevice : public MidiDevice {
 public:
   /// @brief emits midi messages to the midi output.
   virtual void emit(midi_data_t) = 0;
+
+  /// @brief emits a system exclusive message to the midi output.
+  virtual void emit(midi_sysex_t) = 0;
 };
 
 #endif
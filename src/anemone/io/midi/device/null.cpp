@@ -0,0 +1,36 @@
+#include "anemone/io/midi/device/null.hpp"
+
+
+NullMidiIn::NullMidiIn(std::string device_name, rx::subscriber<midi_event_t>)
+  : device_name(device_name)
+{}
+
+void NullMidiIn::connect() {}
+
+std::map<std::string, unsigned int> NullMidiIn::list_devices() {
+  return {};
+}
+
+void NullMidiIn::listen() {}
+
+std::string NullMidiIn::name() {
+  return device_name;
+}
+
+NullMidiOut::NullMidiOut(std::string device_name)
+  : device_name(device_name)
+{}
+
+void NullMidiOut::connect() {}
+
+std::map<std::string, unsigned int> NullMidiOut::list_devices() {
+  return {};
+}
+
+void NullMidiOut::emit(midi_data_t) {}
+
+void NullMidiOut::emit(midi_sysex_t) {}
+
+std::string NullMidiOut::name() {
+  return device_name;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file   io/midi/device/null.hpp
+ * @brief  Null Midi Device Classes
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef ANEMONE_IO_MIDI_DEVICE_NULL_H
+#define ANEMONE_IO_MIDI_DEVICE_NULL_H
+
+#include <map>
+#include <string>
+
+#include "anemone/rx.hpp"
+#include "anemone/types.hpp"
+
+#include "anemone/io/midi/device/midi.hpp"
+
+
+/// @brief Midi input which never receives anything.
+class NullMidiIn : public MidiInputDevice {
+public:
+  NullMidiIn(std::string, rx::subscriber<midi_event_t>);
+
+  virtual void connect() override;
+  virtual std::map<std::string, unsigned int> list_devices() override;
+  virtual void listen() override;
+  virtual std::string name() override;
+
+private:
+  std::string device_name;
+};
+
+/// @brief Midi output which drops everything it is sent.
+class NullMidiOut : public MidiOutputDevice {
+public:
+  NullMidiOut(std::string);
+
+  virtual void connect() override;
+  virtual std::map<std::string, unsigned int> list_devices() override;
+  virtual void emit(midi_data_t) override;
+  virtual void emit(midi_sysex_t) override;
+  virtual std::string name() override;
+
+private:
+  std::string device_name;
+};
+
+#endif
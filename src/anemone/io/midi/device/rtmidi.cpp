@@ -67,12 +67,34 @@ std::map<std::string, unsigned int> RTMidiIn::list_devices() {
 }
 
 void RTMidiIn::listen() {
+  // we want timing messages (clock, start, stop, etc.) so we can sync to external clocks.
+  input->ignoreTypes(true, false, true);
+
   input->setCallback([] (double deltatime, std::vector<unsigned char> *msg, void *user_data) {
                        RTMidiIn *this_rtmidi = (RTMidiIn *)user_data;
 
-                       midi_event_t event = { .source = this_rtmidi->name(),
+                       // deltatime is the time since the previous message as measured by the midi
+                       // backend, which is much more accurate than when this callback happens to
+                       // run. so we reconstruct each message's timestamp by accumulating deltas, and
+                       // only fall back to the arrival time for the first message or if the
+                       // reconstructed timestamp has wandered off (e.g. after a stall).
+                       auto now = std::chrono::steady_clock::now();
+                       auto timestamp = this_rtmidi->last_timestamp +
+                         std::chrono::duration_cast<std::chrono::steady_clock::duration>
+                         (std::chrono::duration<double>(deltatime));
+
+                       if (timestamp > now || now - timestamp > std::chrono::milliseconds(10))
+                         timestamp = now;
+
+                       this_rtmidi->last_timestamp = timestamp;
+
+                       // sysex is ignored (see above), so all messages fit in a midi_data_t.
+                       if (msg->size() > midi_data_t::capacity) return;
+
+                       midi_event_t event = { .source      = this_rtmidi->name(),
                                               .destination = "",
-                                              .data = *msg,
+                                              .data        = midi_data_t(msg->begin(), msg->end()),
+                                              .timestamp   = timestamp,
                        };
 
                        this_rtmidi->input_stream.on_next(event);
@@ -121,6 +143,7 @@ void RTMidiOut::connect() {
 
   // okay, the device has been connected and detected.
   output->openPort(port);
+  is_open = true;
 
   spdlog::info("  connected -> midi out -> {}", device_name);  
 }
@@ -148,7 +171,17 @@ std::map<std::string, unsigned int> RTMidiOut::list_devices() {
 }
 
 void RTMidiOut::emit(midi_data_t data) {
-  output->sendMessage(&data);
+  if (!is_open) return;
+
+  std::lock_guard<std::mutex> guard(output_mutex);
+  output->sendMessage(data.data(), data.size());
+}
+
+void RTMidiOut::emit(midi_sysex_t sysex) {
+  if (!is_open || sysex.empty()) return;
+
+  std::lock_guard<std::mutex> guard(output_mutex);
+  output->sendMessage(sysex.bytes, sysex.size);
 }
 
 std::string RTMidiOut::name() {
@@ -11,6 +11,8 @@
 
 
 #include <map>
+#include <mutex>
+#include <atomic>
 #include <string>
 #include <thread>
 #include <chrono>
@@ -61,6 +63,9 @@ private:
   std::string device_name;
   
   std::unique_ptr<RtMidiIn> input;
+
+  /// @brief timestamp of the previously received message.
+  std::chrono::steady_clock::time_point last_timestamp;
 };
 
 
@@ -85,8 +90,18 @@ public:
   virtual std::map<std::string, unsigned int> list_devices() override;
 
   /// @brief emits midi messages to the midi output.
+  ///
+  /// @remark this is thread safe, but midi clock messages shouldn't have to wait on
+  /// another writer: they go through the `MidiScheduler` dispatcher, which is the only
+  /// thread writing short messages to the outputs while it runs (sysex messages are
+  /// still written from their caller's thread, see `Midi::emit_sysex`).
   virtual void emit(midi_data_t) override;
 
+  /// @brief emits a system exclusive message to the midi output.
+  ///
+  /// @remark this is thread safe, see `emit(midi_data_t)`.
+  virtual void emit(midi_sysex_t) override;
+
   /// @returns the name of the midi device.
   virtual std::string name() override;
   
@@ -95,6 +110,15 @@ private:
   std::string device_name;
   
   std::unique_ptr<RtMidiOut> output;
+
+  /// @brief serializes sending messages when several threads emit, i.e. when there is
+  /// no scheduler dispatcher (no lookahead), or when a sysex message is written while
+  /// the dispatcher runs. otherwise, the dispatcher is the only thread writing to the
+  /// output and it is never contended.
+  std::mutex output_mutex;
+
+  /// @brief whether the output port is open. messages emitted before then are dropped.
+  std::atomic<bool> is_open = false;
 };
 
 #endif
@@ -7,7 +7,7 @@ Midi::Midi(std::shared_ptr<Config> config, std::shared_ptr<MidiDeviceFactory> de
   : device_factory(device_factory)
 {
   make_input_devices(config->at("ports")["midi"]["in"].as<std::vector<std::string> >());
-  make_output_devices(config->at("ports")["midi"]["out"].as<std::vector<std::string> >());
+  make_output_devices(config->at("ports")["midi"]["out"].yml);
 }
 
 rx::observable<midi_event_t> Midi::connect() {
@@ -29,25 +29,34 @@ rx::observable<midi_event_t> Midi::connect() {
     auto name = itr.first;
     auto device = itr.second;
     std::thread t
-      ([name, &device] {
+      ([name, device] {
          device->connect();
        });
     t.detach();
   }
 
-  return incoming_events.get_observable();
+  return incoming_events.get_observable()
+    | rx::filter([] (midi_event_t e) {
+                   return !is_midi_sync_message(e.data);
+                 });
+}
+
+rx::observable<midi_event_t> Midi::timing_events() {
+  return incoming_events.get_observable()
+    | rx::filter([] (midi_event_t e) {
+                   return is_midi_sync_message(e.data);
+                 });
 }
 
-void Midi::emit(midi_event_t event) {
+void Midi::emit(const midi_event_t& event) {
   // TODO make routing better (right now sends to all output devices...)
-  for (auto itr : output_devices) {
-    auto device = itr.second;
-    device->emit(event.data);
+  for (const auto& itr : output_devices) {
+    itr.second->emit(event.data);
   }
 }
 
 void Midi::emit(std::vector<midi_event_t>& events) {
-  for (auto event : events) {
+  for (const auto& event : events) {
     emit(event);
   }
 }
@@ -56,14 +65,41 @@ void Midi::emit(std::vector<midi_event_t>&& events) {
   emit(events);
 }
 
+void Midi::emit_sync(midi_data_t data) {
+  for (const auto& device : sync_output_devices) {
+    device->emit(data);
+  }
+}
+
+void Midi::emit_sysex(const unsigned char* data, std::size_t size) {
+  std::lock_guard<std::mutex> guard(sysex_mutex);
+
+  auto message = sysex.store(data, size);
+  if (message.empty()) {
+    spdlog::warn("sysex message too long ({} bytes), dropping it", size);
+    return;
+  }
+
+  // TODO make routing better (right now sends to all output devices...)
+  for (const auto& itr : output_devices) {
+    itr.second->emit(message);
+  }
+}
+
 void Midi::make_input_devices(std::vector<std::string> names) {
   for (auto name : names) {
     input_devices[name] = device_factory->make_input(name, incoming_events.get_subscriber());
   }
 }
 
-void Midi::make_output_devices(std::vector<std::string> names) {
-  for (auto name : names) {
+void Midi::make_output_devices(YAML::Node ports) {
+  for (auto port : ports) {
+    auto name = port.IsMap() ? port["name"].as<std::string>() : port.as<std::string>();
+
     output_devices[name] = device_factory->make_output(name);
-  }  
+
+    if (port.IsMap() && port["clock"].as<bool>(false)) {
+      sync_output_devices.push_back(output_devices[name]);
+    }
+  }
 }
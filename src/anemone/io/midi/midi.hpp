@@ -11,6 +11,7 @@
 
 
 #include <map>
+#include <mutex>
 #include <thread>
 #include <string>
 #include <vector>
@@ -29,17 +30,41 @@ public:
   Midi(std::shared_ptr<Config>, std::shared_ptr<MidiDeviceFactory>);
 
   /// @brief connects to midi devices and returns a stream of incoming midi events.
+  ///
+  /// @remark synchronization messages (clock, start, stop, etc.) are not included
+  /// in this stream, see `timing_events`.
   rx::observable<midi_event_t> connect();
+
+  /// @brief stream of incoming midi synchronization messages.
+  rx::observable<midi_event_t> timing_events();
   
   /// @brief emits a midi event
-  void emit(midi_event_t);
+  void emit(const midi_event_t&);
 
   /// @brief emits a vector of midi events.
   void emit(std::vector<midi_event_t>&);
 
   /// @brief emits a vector of midi events. TODO do we needs this....?
   void emit(std::vector<midi_event_t>&&);
+
+  /// @brief emits a midi synchronization message to the outputs with `clock` enabled.
+  void emit_sync(midi_data_t);
+
+  /// @brief emits a system exclusive message.
+  ///
+  /// @remark the message is copied into the sysex arena, rather than allocated. it is
+  /// written to the outputs from the calling thread, not through the scheduler's
+  /// dispatcher, so it contends the outputs' locks with the dispatcher while it is sent.
+  ///
+  /// @param data   the bytes of the message, without its 0xF0 & 0xF7 framing bytes.
+  /// @param size   the number of bytes.
+  ///
+  void emit_sysex(const unsigned char* data, std::size_t size);
 private:
+  /// @brief arena the system exclusive messages are stored in while they are emitted.
+  SysexArena sysex;
+  std::mutex sysex_mutex;
+
   /// @brief incoming events subject.
   rx::subject<midi_event_t> incoming_events;
 
@@ -52,8 +77,16 @@ private:
   /// @brief map of midi output devices.
   std::map<std::string, std::shared_ptr<MidiOutputDevice> > output_devices;
 
+  /// @brief midi output devices which midi synchronization messages are sent to.
+  std::vector<std::shared_ptr<MidiOutputDevice> > sync_output_devices;
+
   void make_input_devices(std::vector<std::string>);
-  void make_output_devices(std::vector<std::string>);
+
+  /// @brief makes output devices from the `ports.midi.out` config.
+  ///
+  /// @details each entry is either a device name, or a map with a `name` and an
+  /// optional `clock` flag enabling midi clock output to that device.
+  void make_output_devices(YAML::Node);
 };
 
 #endif
@@ -0,0 +1,246 @@
+#include <vector>
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "anemone/util/wait.hpp"
+#include "anemone/io/midi/scheduler.hpp"
+
+
+MidiScheduler::MidiScheduler(std::shared_ptr<Config> config,
+                             std::shared_ptr<Midi> midi,
+                             std::shared_ptr<ClockDevice> clock_device)
+  : MidiScheduler({ .lookahead       = std::chrono::microseconds
+                    (clock_device->is_realtime() ?
+                     static_cast<long>(config->at("scheduler")["lookahead"].as<double>(0) * 1000) : 0),
+                    .spin            = std::chrono::microseconds(config->at("scheduler")["spin"].as<unsigned int>(200)),
+                    .dispatch_thread = realtime_thread_from_config(config, "midi_out"),
+    },
+    midi)
+{}
+
+MidiScheduler::MidiScheduler(settings_t settings, std::shared_ptr<Midi> midi)
+  : settings(settings),
+    midi(midi)
+{
+  // the heap never grows past its capacity, so the dispatcher never allocates.
+  heap.reserve(capacity);
+}
+
+MidiScheduler::~MidiScheduler() {
+  disconnect();
+}
+
+void MidiScheduler::connect() {
+  // without a lookahead, events are emitted as they are scheduled.
+  if (settings.lookahead.count() == 0) return;
+
+  running = true;
+
+  notifier   = std::thread([this] () { stream_played(); });
+  dispatcher = std::thread([this] () { dispatch(); });
+
+  spdlog::info("  connected -> midi scheduler ({}µs lookahead)", settings.lookahead.count());
+}
+
+void MidiScheduler::disconnect() {
+  running = false;
+  wake.notify();
+
+  if (dispatcher.joinable()) dispatcher.join();
+
+  // the dispatcher is done, so this thread takes over pushing to the played ring, to
+  // stop the notifier once it has streamed everything before.
+  if (notifier.joinable()) {
+    while (!played_ring.try_push({})) std::this_thread::yield();
+    notifier.join();
+  }
+}
+
+void MidiScheduler::schedule(scheduled_midi_event_t scheduled) {
+  if (!running) {
+    midi->emit(scheduled.event);
+    if (scheduled.played != nullptr) scheduled.played->get_subscriber().on_next(scheduled.event);
+    return;
+  }
+
+  if (!requests.try_push({ .kind = request_t::Kind::Schedule, .scheduled = scheduled })) {
+    dropped_count.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  wake.notify();
+}
+
+void MidiScheduler::emit(midi_event_t event) {
+  if (!running) {
+    midi->emit(event);
+    return;
+  }
+
+  if (!immediate.try_push({ .due = std::chrono::steady_clock::now(), .event = event, .owner = nullptr })) {
+    dropped_count.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  wake.notify();
+}
+
+void MidiScheduler::schedule_sync(midi_data_t data, std::chrono::steady_clock::time_point due) {
+  if (!running) {
+    wait_until(due);
+    midi->emit_sync(data);
+    return;
+  }
+
+  if (!sync_ring.try_push({ .due = due, .data = data })) {
+    spdlog::warn("midi sync ring full, dropping a sync message");
+    return;
+  }
+
+  wake.notify();
+}
+
+void MidiScheduler::cancel(const void *owner, std::chrono::steady_clock::time_point after) {
+  if (!running) return;
+
+  // unlike an event, a cancellation can't be dropped (the events it cancels would be
+  // sent), so wait for the dispatcher to make room, which it does on each wake up.
+  request_t request = { .kind = request_t::Kind::Cancel, .scheduled = { .due = after, .event = {}, .owner = owner } };
+  while (!requests.try_push(request)) {
+    wake.notify();
+    std::this_thread::yield();
+  }
+
+  wake.notify();
+}
+
+std::chrono::microseconds MidiScheduler::lookahead() {
+  return settings.lookahead;
+}
+
+std::chrono::steady_clock::time_point MidiScheduler::next_due() {
+  auto due  = heap.empty() ? std::chrono::steady_clock::time_point::max() : heap.front().scheduled.due;
+  auto sync = sync_ring.front();
+
+  return sync != nullptr ? std::min(due, sync->due) : due;
+}
+
+void MidiScheduler::take_requests() {
+  requests.drain([this] (request_t&& request) {
+                   if (request.kind == request_t::Kind::Schedule) {
+                     push_pending(std::move(request.scheduled));
+                     return;
+                   }
+
+                   auto owner = request.scheduled.owner;
+                   auto after = request.scheduled.due;
+                   auto end   = std::remove_if(heap.begin(), heap.end(), [owner, after] (const pending_t& pending) {
+                                                                          return pending.scheduled.owner == owner && pending.scheduled.due > after;
+                                                                        });
+                   if (end == heap.end()) return;
+
+                   heap.erase(end, heap.end());
+                   std::make_heap(heap.begin(), heap.end());
+                 });
+
+  immediate.drain([this] (scheduled_midi_event_t&& scheduled) { push_pending(std::move(scheduled)); });
+}
+
+void MidiScheduler::push_pending(scheduled_midi_event_t scheduled) {
+  if (heap.size() == capacity) {
+    dropped_count.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  heap.push_back({ .scheduled = std::move(scheduled), .order = scheduled_count++ });
+  std::push_heap(heap.begin(), heap.end());
+}
+
+void MidiScheduler::emit_due_sync() {
+  sync_t sync;
+
+  for (auto next = sync_ring.front(); next != nullptr; next = sync_ring.front()) {
+    if (next->due > std::chrono::steady_clock::now()) return;
+
+    sync_ring.try_pop(sync);
+    midi->emit_sync(sync.data);
+  }
+}
+
+void MidiScheduler::dispatch() {
+  make_realtime("midi out", settings.dispatch_thread);
+
+  std::vector<scheduled_midi_event_t> events;
+  events.reserve(capacity);
+
+  auto is_ready = [this] {
+                    return !running || !requests.empty() || !immediate.empty() || !sync_ring.empty();
+                  };
+
+  while (running) {
+    take_requests();
+    auto due = next_due();
+
+    // sleep until something is requested, or until shortly before the earliest event
+    // or sync message (something requested meanwhile may be due earlier).
+    if (due == std::chrono::steady_clock::time_point::max()) {
+      wake.wait(is_ready, std::chrono::nanoseconds::max());
+      continue;
+    }
+
+    auto sleep = due - settings.spin - std::chrono::steady_clock::now();
+    if (sleep > std::chrono::nanoseconds(0)) {
+      wake.wait(is_ready, std::chrono::duration_cast<std::chrono::nanoseconds>(sleep));
+      continue;
+    }
+
+    wait_until(due);
+
+    // the events due may have been cancelled while spinning.
+    take_requests();
+
+    // release every event that is due.
+    auto now = std::chrono::steady_clock::now();
+    while (!heap.empty() && heap.front().scheduled.due <= now) {
+      std::pop_heap(heap.begin(), heap.end());
+      events.push_back(std::move(heap.back().scheduled));
+      heap.pop_back();
+    }
+
+    // sync messages go first, and may not wait behind more than one event.
+    emit_due_sync();
+    for (auto& scheduled : events) {
+      midi->emit(scheduled.event);
+      emit_due_sync();
+    }
+
+    // now that they are out, hand them over to be streamed to whoever wants to know
+    // what was played.
+    for (auto& scheduled : events) {
+      if (scheduled.played == nullptr) continue;
+
+      if (!played_ring.try_push({ .played = scheduled.played, .event = std::move(scheduled.event) })) {
+        dropped_count.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    events.clear();
+  }
+}
+
+void MidiScheduler::stream_played() {
+  bool streaming = true;
+
+  while (streaming) {
+    played_ring.wait();
+    played_ring.drain([&streaming] (played_t&& played) {
+                        // an empty event is pushed once the dispatcher is done.
+                        if (played.played == nullptr) {
+                          streaming = false;
+                          return;
+                        }
+
+                        played.played->get_subscriber().on_next(played.event);
+                      });
+  }
+}
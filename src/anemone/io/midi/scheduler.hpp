@@ -0,0 +1,233 @@
+/**
+ * @file   io/midi/scheduler.hpp
+ * @brief  Midi Lookahead Scheduler
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef ANEMONE_IO_MIDI_SCHEDULER_H
+#define ANEMONE_IO_MIDI_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+#include "anemone/rx.hpp"
+#include "anemone/config.hpp"
+#include "anemone/types.hpp"
+#include "anemone/util/ring.hpp"
+#include "anemone/util/realtime.hpp"
+
+#include "anemone/io/midi/midi.hpp"
+#include "anemone/io/clock/device/clock.hpp"
+
+
+/// @brief a midi event stamped with when it should be emitted.
+struct scheduled_midi_event_t {
+  /// @brief when the event should be emitted.
+  std::chrono::steady_clock::time_point due;
+
+  /// @brief the event to emit.
+  midi_event_t event;
+
+  /// @brief opaque tag identifying who scheduled the event (e.g. a part), so that
+  /// all of its pending events can be cancelled together.
+  const void *owner;
+
+  /// @brief where to stream the event once it has been sent, if anywhere (e.g. the
+  /// playback events of an instrument).
+  rx::behavior<midi_event_t> *played = nullptr;
+};
+
+
+/// @brief Scheduler which emits midi events at their due times.
+///
+/// @details
+/// rather than emitting midi events from within the tick subscribers (where any slow
+/// subscriber delays the output), events are rendered ahead of time and a dedicated
+/// dispatcher thread releases each one at its due time. the dispatcher sleeps until
+/// shortly before the earliest event and busy-waits for the rest (see `wait_until`).
+///
+/// neither the tick thread nor the dispatcher ever allocates, and neither takes a lock
+/// of the scheduler's (the dispatcher takes each output's own lock to write to it,
+/// which is only contended while a sysex message is written, see `Midi::emit_sysex`):
+///   * events are scheduled (and cancelled) by the tick thread through a single
+///     producer ring, and emitted right away by other threads (e.g. pads) through a
+///     multiple producer ring, so the dispatcher sees both in the order they were made.
+///   * the dispatcher keeps the pending events in a time ordered heap of fixed capacity,
+///     which only it touches.
+///   * once the events due are sent, they are handed over to a (non real-time) thread
+///     which streams them to whoever wants to know what was actually played (see
+///     `scheduled_midi_event_t::played`), so events which are cancelled before they are
+///     due are never seen there, and nobody's subscribers run on the dispatcher.
+///
+/// events which don't fit (in a ring or in the heap) are dropped and counted.
+///
+/// renderers should render all events due within the `lookahead` window. if the events
+/// they have rendered change (e.g. the sequence is edited), they can `cancel` their
+/// pending events and render them again.
+///
+/// midi sync messages (e.g. midi clock) go through a separate single producer ring
+/// and take priority: due sync messages are sent before, and in between, the events
+/// being released. this way, the dispatcher is the only thread writing to the midi
+/// outputs (so it never waits on another writer) and a burst of events delays a clock
+/// message by the time it takes to send one event at most.
+///
+/// with a lookahead of zero, there is no buffering at all and scheduled events are
+/// emitted right away from the calling thread.
+///
+class MidiScheduler {
+public:
+  /// @brief scheduler settings.
+  struct settings_t {
+    /// @brief how far ahead events should be rendered.
+    std::chrono::microseconds lookahead;
+
+    /// @brief how long to busy-wait before each due time.
+    std::chrono::microseconds spin;
+
+    /// @brief real-time settings of the dispatcher thread.
+    realtime_thread_t dispatch_thread = {};
+  };
+
+  /// @brief constructs a scheduler configured by the `scheduler` section of the config.
+  ///
+  /// @remark when the clock device isn't real-time (e.g. a virtual clock), there is no
+  /// lookahead so that events are emitted in step with the (virtual) ticks.
+  ///
+  MidiScheduler(std::shared_ptr<Config>, std::shared_ptr<Midi>, std::shared_ptr<ClockDevice>);
+
+  /// @brief constructs a scheduler from explicit settings.
+  MidiScheduler(settings_t, std::shared_ptr<Midi>);
+
+  ~MidiScheduler();
+
+  /// @brief starts the dispatcher & notifier threads.
+  void connect();
+
+  /// @brief stops the dispatcher & notifier threads, and waits for them to finish.
+  void disconnect();
+
+  /// @brief the number of events the scheduler holds, pending or in flight.
+  static constexpr std::size_t capacity = 4096;
+
+  /// @brief schedules an event.
+  ///
+  /// @remark it is called from a single thread (i.e. the tick thread).
+  ///
+  void schedule(scheduled_midi_event_t);
+
+  /// @brief emits an event as soon as possible (e.g. when a pad is pressed).
+  void emit(midi_event_t);
+
+  /// @brief schedules a midi sync message, sent to the outputs with `clock` enabled.
+  ///
+  /// @remark it should be called from a single thread (i.e. the midi clock thread),
+  /// shortly before the message is due.
+  ///
+  /// @param data   the sync message.
+  /// @param due    when it should be sent.
+  ///
+  void schedule_sync(midi_data_t data, std::chrono::steady_clock::time_point due);
+
+  /// @brief cancels pending events of the provided owner.
+  ///
+  /// @remark it is called from the same thread as `schedule`.
+  ///
+  /// @param owner   the owner whose events to cancel.
+  /// @param after   only cancel events due after this time (by default, all of them).
+  ///
+  void cancel(const void *owner, std::chrono::steady_clock::time_point after = {});
+
+  /// @brief how far ahead events should be rendered.
+  std::chrono::microseconds lookahead();
+
+  /// @brief the number of events dropped because the scheduler was full.
+  unsigned long dropped() const { return dropped_count.load(std::memory_order_relaxed); };
+
+private:
+  settings_t settings;
+
+  std::shared_ptr<Midi> midi;
+
+  std::atomic<bool> running = false;
+
+  std::thread dispatcher;
+  std::thread notifier;
+
+  /// @brief an event to schedule, or the events of an owner to cancel.
+  struct request_t {
+    enum class Kind { Schedule, Cancel } kind = Kind::Schedule;
+
+    /// @brief the event to schedule, or the owner (and time after which) to cancel.
+    scheduled_midi_event_t scheduled = {};
+  };
+
+  /// @brief events scheduled & cancelled by the tick thread.
+  SpscRing<request_t, capacity> requests;
+
+  /// @brief events emitted right away, from any thread.
+  MpscRing<scheduled_midi_event_t, 256> immediate;
+
+  /// @brief a pending event, ordered by due time and then by when it was scheduled.
+  struct pending_t {
+    scheduled_midi_event_t scheduled;
+    unsigned long          order;
+
+    /// @brief whether it comes after another one (i.e. the heap is a min-heap).
+    bool operator<(const pending_t& other) const {
+      return scheduled.due != other.scheduled.due ? scheduled.due > other.scheduled.due : order > other.order;
+    };
+  };
+
+  /// @brief pending events, as a heap whose capacity is reserved up front (dispatcher only).
+  std::vector<pending_t> heap;
+  unsigned long          scheduled_count = 0;
+
+  /// @brief a sent event to stream.
+  struct played_t {
+    rx::behavior<midi_event_t> *played = nullptr;
+    midi_event_t                event  = {};
+  };
+
+  /// @brief events sent by the dispatcher, waiting to be streamed by the notifier.
+  SpscRing<played_t, capacity> played_ring;
+
+  /// @brief wakes the dispatcher up when something is pushed to its rings.
+  RingSignal wake;
+
+  std::atomic<unsigned long> dropped_count = { 0 };
+
+  /// @brief a pending midi sync message.
+  struct sync_t {
+    std::chrono::steady_clock::time_point due;
+    midi_data_t                           data;
+  };
+
+  /// @brief pending midi sync messages, in due order.
+  SpscRing<sync_t, 64> sync_ring;
+
+  /// @brief the dispatcher loop.
+  void dispatch();
+
+  /// @brief the notifier loop, streaming the events played until stopped.
+  void stream_played();
+
+  /// @brief moves the requests made since the last time into the heap (dispatcher only).
+  void take_requests();
+
+  /// @brief adds an event to the heap, unless it is full (dispatcher only).
+  void push_pending(scheduled_midi_event_t);
+
+  /// @brief when the next event or sync message is due (dispatcher only).
+  std::chrono::steady_clock::time_point next_due();
+
+  /// @brief sends the sync messages which are due (dispatcher only).
+  void emit_due_sync();
+};
+
+#endif
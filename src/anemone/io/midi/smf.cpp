@@ -0,0 +1,113 @@
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+
+#include "anemone/io/midi/smf.hpp"
+
+
+namespace {
+  void write_u32(std::vector<unsigned char>& out, unsigned long value) {
+    out.push_back((value >> 24) & 0xFF);
+    out.push_back((value >> 16) & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+    out.push_back(value & 0xFF);
+  }
+
+  void write_u16(std::vector<unsigned char>& out, unsigned int value) {
+    out.push_back((value >> 8) & 0xFF);
+    out.push_back(value & 0xFF);
+  }
+
+  // variable length quantity: 7 bits per byte, most significant first, with the
+  // high bit set on every byte but the last.
+  void write_vlq(std::vector<unsigned char>& out, unsigned long value) {
+    unsigned char bytes[5];
+    int n = 0;
+
+    do {
+      bytes[n++] = value & 0x7F;
+      value >>= 7;
+    } while (value > 0 && n < 5);
+
+    while (n > 1) out.push_back(bytes[--n] | 0x80);
+    out.push_back(bytes[0]);
+  }
+}
+
+StandardMidiFile::StandardMidiFile(unsigned int division, std::string name)
+  : division(division),
+    tracks(1)
+{
+  if (!name.empty()) add_meta(0, 0, 0x03, { name.begin(), name.end() });
+}
+
+StandardMidiFile::track_idx_t StandardMidiFile::add_track(std::string name) {
+  tracks.emplace_back();
+
+  track_idx_t track = tracks.size() - 1;
+  add_meta(track, 0, 0x03, { name.begin(), name.end() });
+
+  return track;
+}
+
+void StandardMidiFile::add_event(track_idx_t track, unsigned long tick, const midi_data_t& data) {
+  if (track >= tracks.size() || data.empty()) return;
+
+  tracks[track].push_back({ .tick = tick, .bytes = { data.begin(), data.end() } });
+}
+
+void StandardMidiFile::add_tempo(unsigned long tick, double bpm) {
+  if (bpm <= 0) return;
+
+  // microseconds per quarter note, as 24 bits.
+  unsigned long tempo = std::lround(60000000.0 / bpm);
+  tempo = std::min(tempo, 0xFFFFFFul);
+
+  add_meta(0, tick, 0x51, { static_cast<unsigned char>((tempo >> 16) & 0xFF),
+                            static_cast<unsigned char>((tempo >> 8) & 0xFF),
+                            static_cast<unsigned char>(tempo & 0xFF) });
+}
+
+void StandardMidiFile::add_meta(track_idx_t track, unsigned long tick, unsigned char type, std::vector<unsigned char> data) {
+  std::vector<unsigned char> bytes = { 0xFF, type };
+  write_vlq(bytes, data.size());
+  bytes.insert(bytes.end(), data.begin(), data.end());
+
+  tracks[track].push_back({ .tick = tick, .bytes = bytes });
+}
+
+bool StandardMidiFile::write(std::string path, unsigned long end) {
+  std::vector<unsigned char> out = { 'M', 'T', 'h', 'd' };
+  write_u32(out, 6);
+  write_u16(out, 1);
+  write_u16(out, tracks.size());
+  write_u16(out, division & 0x7FFF);
+
+  for (auto& track : tracks) {
+    std::vector<unsigned char> chunk;
+    unsigned long previous = 0;
+
+    for (auto& event : track) {
+      if (event.tick > end) break;
+
+      write_vlq(chunk, event.tick - previous);
+      chunk.insert(chunk.end(), event.bytes.begin(), event.bytes.end());
+      previous = event.tick;
+    }
+
+    // end of track.
+    write_vlq(chunk, end - previous);
+    chunk.insert(chunk.end(), { 0xFF, 0x2F, 0x00 });
+
+    out.insert(out.end(), { 'M', 'T', 'r', 'k' });
+    write_u32(out, chunk.size());
+    out.insert(out.end(), chunk.begin(), chunk.end());
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) return false;
+
+  file.write(reinterpret_cast<const char*>(out.data()), out.size());
+
+  return static_cast<bool>(file);
+}
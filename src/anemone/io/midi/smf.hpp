@@ -0,0 +1,80 @@
+/**
+ * @file   io/midi/smf.hpp
+ * @brief  Standard Midi File Writer
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef ANEMONE_IO_MIDI_SMF_H
+#define ANEMONE_IO_MIDI_SMF_H
+
+#include <string>
+#include <vector>
+
+#include "anemone/types.hpp"
+
+
+/// @brief Builds a type-1 Standard Midi File (SMF) in memory and writes it out.
+///
+/// @details
+/// event times are given in ticks of the file's division (ticks per quarter note).
+/// the first track is the tempo track, it holds the tempo changes and the file name,
+/// every other track is added with `add_track`. events must be added in time order
+/// within each track.
+///
+class StandardMidiFile {
+public:
+  typedef unsigned int track_idx_t;
+
+  /// @brief constructs an empty file with only the tempo track.
+  ///
+  /// @param division   ticks per quarter note.
+  /// @param name       the name written to the tempo track.
+  ///
+  StandardMidiFile(unsigned int division, std::string name = "");
+
+  /// @brief adds a named track.
+  ///
+  /// @return the index of the new track.
+  ///
+  track_idx_t add_track(std::string name);
+
+  /// @brief adds a channel message to a track.
+  ///
+  /// @param track   the track index.
+  /// @param tick    the time of the message.
+  /// @param data    the complete midi message.
+  ///
+  void add_event(track_idx_t, unsigned long tick, const midi_data_t&);
+
+  /// @brief adds a tempo change to the tempo track.
+  ///
+  /// @param tick   the time of the tempo change.
+  /// @param bpm    the new tempo in quarter notes per minute.
+  ///
+  void add_tempo(unsigned long tick, double bpm);
+
+  /// @brief writes the file, closing every track at the provided time.
+  ///
+  /// @param path   the file path.
+  /// @param end    the time of the end of all tracks.
+  ///
+  /// @return whether the file could be written.
+  ///
+  bool write(std::string path, unsigned long end);
+
+private:
+  struct event_t {
+    unsigned long              tick;
+    std::vector<unsigned char> bytes;
+  };
+
+  unsigned int division;
+
+  std::vector<std::vector<event_t> > tracks;
+
+  void add_meta(track_idx_t, unsigned long tick, unsigned char type, std::vector<unsigned char> data);
+};
+
+#endif
@@ -19,23 +19,26 @@ ER1::MidiController::MidiController(std::shared_ptr<IO> io,
                      is_midi_off_note_message(e.data);
                  })
     | rx::map([er1] (midi_event_t e) -> std::pair<std::shared_ptr<ER1::Pad>, bool> {
-        // TODO handle error if the note corresponds to no pad...
-        
-        // maps the inbound midi note to the pad that it triggers and also
+        // maps the inbound midi note to the pad that it triggers (if any) and also
         // whether it is a midi on or off event
         auto on  = is_midi_on_note_message(e.data);
-        auto pad = er1->midi_map.note_to_pad.at(e.data[1]);
+        auto pad = er1->midi_map.note_to_pad.find(e.data[1]);
+        if (pad == er1->midi_map.note_to_pad.end()) return { nullptr, on };
 
-        return { pad, on };
-      });
+        return { pad->second, on };
+      })
+    | rx::filter([] (std::pair<std::shared_ptr<ER1::Pad>, bool> p) {
+                   // drop notes which don't trigger a pad.
+                   return std::get<0>(p) != nullptr;
+                 });
 
   // subscribe to midi note events
   playback_midi_note_events
-    .subscribe([er1] (std::pair<std::shared_ptr<ER1::Pad>, bool> p) {
+    .subscribe(state->store->dispatching<std::pair<std::shared_ptr<ER1::Pad>, bool>>([er1] (std::pair<std::shared_ptr<ER1::Pad>, bool> p) {
                  auto pad = std::get<0>(p);
                  auto on  = std::get<1>(p);
 
                  // set playback state of this pad.
                  pad->is_playing.get_subscriber().on_next(on);
-               });
+               }));
 }
@@ -34,7 +34,7 @@ ER1::PadsController::PadsController(std::shared_ptr<IO> io,
     
   // subscribe to oscillator pad events
   osc_pad_events
-    .subscribe([io, er1] (grid_event_t e) {
+    .subscribe([io, state, er1] (grid_event_t e) {
                  auto pressed = e.type == GridEvent::Pressed ? true : false;
                  auto osc     = er1->pads.oscillators[e.index];
 
@@ -46,19 +46,21 @@ ER1::PadsController::PadsController(std::shared_ptr<IO> io,
                    };
 
                  // emit the midi event
-                 io->midi->emit(midi_event);
+                 io->scheduler->emit(midi_event);
 
-                 // if this was a press event (aka a midi note ON event was emitted), update
-                 // the last midi note played
-                 if (pressed) er1->update_last_midi_notes_played(midi_event);
+                 state->store->dispatch([er1, osc, pressed, midi_event] {
+                                          // if this was a press event (aka a midi note ON event was emitted), update
+                                          // the last midi note played
+                                          if (pressed) er1->update_last_midi_notes_played(midi_event);
 
-                 // update the playback status of this pad
-                 osc->is_playing.get_subscriber().on_next(pressed);
+                                          // update the playback status of this pad
+                                          osc->is_playing.get_subscriber().on_next(pressed);
+                                        });
                });
 
   // subscribe to cymbal pad events
   cymbal_pad_events
-    .subscribe([io, er1] (grid_event_t e) {
+    .subscribe([io, state, er1] (grid_event_t e) {
                  auto pressed = e.type == GridEvent::Pressed ? true : false;
                  auto cymbals = er1->pads.cymbals[e.index];
 
@@ -70,19 +72,21 @@ ER1::PadsController::PadsController(std::shared_ptr<IO> io,
                    };
 
                  // emit the midi event
-                 io->midi->emit(midi_event);
+                 io->scheduler->emit(midi_event);
 
-                 // if this was a press event (aka a midi note ON event was emitted), update
-                 // the last midi note played
-                 if (pressed) er1->update_last_midi_notes_played(midi_event);
+                 state->store->dispatch([er1, cymbals, pressed, midi_event] {
+                                          // if this was a press event (aka a midi note ON event was emitted), update
+                                          // the last midi note played
+                                          if (pressed) er1->update_last_midi_notes_played(midi_event);
 
-                 // update the playback status of this pad
-                 cymbals->is_playing.get_subscriber().on_next(pressed);
+                                          // update the playback status of this pad
+                                          cymbals->is_playing.get_subscriber().on_next(pressed);
+                                        });
                });
 
   // subscribe to oscillator pad events
   audio_in_pad_events
-    .subscribe([io, er1] (grid_event_t e) {
+    .subscribe([io, state, er1] (grid_event_t e) {
                  auto pressed  = e.type == GridEvent::Pressed ? true : false;
                  auto audio_in = er1->pads.audio_ins[e.index];
 
@@ -94,13 +98,15 @@ ER1::PadsController::PadsController(std::shared_ptr<IO> io,
                    };
 
                  // emit the midi event
-                 io->midi->emit(midi_event);
+                 io->scheduler->emit(midi_event);
 
-                 // if this was a press event (aka a midi note ON event was emitted), update
-                 // the last midi note played
-                 if (pressed) er1->update_last_midi_notes_played(midi_event);
+                 state->store->dispatch([er1, audio_in, pressed, midi_event] {
+                                          // if this was a press event (aka a midi note ON event was emitted), update
+                                          // the last midi note played
+                                          if (pressed) er1->update_last_midi_notes_played(midi_event);
 
-                 // update the playback status of this pad
-                 audio_in->is_playing.get_subscriber().on_next(pressed);
+                                          // update the playback status of this pad
+                                          audio_in->is_playing.get_subscriber().on_next(pressed);
+                                        });
                });
 }
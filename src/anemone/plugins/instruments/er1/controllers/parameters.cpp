@@ -26,13 +26,13 @@ ER1::ParametersController::ParametersController(std::shared_ptr<IO> io,
                        e.section == GridSectionName::DelayTime;
                    });
     delay_time_press
-      .subscribe([parameter] (grid_event_t e) {
+      .subscribe(state->store->dispatching<grid_event_t>([parameter] (grid_event_t e) {
                    parameter->midi_map.mapping_in_progress.get_subscriber().on_next(true);
-                 });
+                 }));
     delay_time_unpress
-      .subscribe([parameter] (grid_event_t e) {
+      .subscribe(state->store->dispatching<grid_event_t>([parameter] (grid_event_t e) {
                    parameter->midi_map.mapping_in_progress.get_subscriber().on_next(false);
-                 });
+                 }));
     
     // setup midi handling logic
     auto parameter_events = io->midi_events
@@ -42,7 +42,7 @@ ER1::ParametersController::ParametersController(std::shared_ptr<IO> io,
                    });
 
     parameter_events
-      .subscribe([parameter, io] (midi_event_t e) {
+      .subscribe(state->store->dispatching<midi_event_t>([parameter, io] (midi_event_t e) {
                    if (parameter->midi_map.mapping_in_progress.get_value()) {
                      spdlog::warn("mapping parameter");
                      parameter->midi_map.source = e.source;
@@ -56,6 +56,6 @@ ER1::ParametersController::ParametersController(std::shared_ptr<IO> io,
                      // emit value to output
                      // io->midi->emit(parameter->get_midi_output());
                    }
-                 });
+                 }));
   }
 }
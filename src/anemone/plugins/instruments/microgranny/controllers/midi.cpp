@@ -1,3 +1,5 @@
+#include <array>
+
 #include <spdlog/spdlog.h>
 
 #include "anemone/plugins/instruments/microgranny/microgranny.hpp"
@@ -32,6 +34,14 @@ MicroGranny::MidiController::MidiController(std::shared_ptr<IO> io,
   //                    state->instruments->rendered.get_value()->name == microgranny->name;
   //                });
 
+  // pad index of each midi note number (-1 when a note doesn't trigger a pad), so
+  // played back notes can be mapped to pads without searching or parsing note names.
+  std::array<int, 128> note_to_pad;
+  note_to_pad.fill(-1);
+  for (unsigned int pad_idx = 0; pad_idx < microgranny->midi_map.notes.size(); pad_idx++) {
+    note_to_pad[microgranny->midi_map.notes[pad_idx] & 0x7F] = pad_idx;
+  }
+
   // midi on note events being played by the sequencer
   auto played_back_pads_on = microgranny->playback_midi_events.get_observable()
     | rx::filter([] (midi_event_t e) {
@@ -40,18 +50,9 @@ MicroGranny::MidiController::MidiController(std::shared_ptr<IO> io,
                    // filter for midi on notes only
                    return is_midi_on_note_message(e.data);
                  })
-    | rx::map([microgranny] (midi_event_t e) {
+    | rx::map([note_to_pad] (midi_event_t e) {
                 // convert midi note number to pad index
-                int pad_idx;
-                
-                // TODO hmmm, do we have to always loop over the pads?
-                // more optimized would be to keep a mapping....
-                for (pad_idx = 0; pad_idx < microgranny->midi_map.notes.size(); pad_idx++) {
-                  if (spn_to_num(microgranny->midi_map.notes[pad_idx]) == (unsigned int)e.data[1])
-                    return pad_idx;
-                }
-
-                return -1;
+                return note_to_pad[e.data[1] & 0x7F];
               })
     | rx::filter([] (int pad) { return pad >= 0; });
 
@@ -63,18 +64,9 @@ MicroGranny::MidiController::MidiController(std::shared_ptr<IO> io,
                    // filter for midi on notes only
                    return is_midi_off_note_message(e.data);
                  })
-    | rx::map([microgranny] (midi_event_t e) {
+    | rx::map([note_to_pad] (midi_event_t e) {
                 // convert midi note number to pad index
-                int pad_idx;
-
-                // TODO hmmm, do we have to always loop over the pads?
-                // more optimized would be to keep a mapping....
-                for (pad_idx = 0; pad_idx < microgranny->midi_map.notes.size(); pad_idx++) {
-                  if (spn_to_num(microgranny->midi_map.notes[pad_idx]) == (unsigned int)e.data[1])
-                    return pad_idx;
-                }
-
-                return -1;
+                return note_to_pad[e.data[1] & 0x7F];
               })
     | rx::filter([] (int pad) { return pad >= 0; });
 
@@ -85,11 +77,11 @@ MicroGranny::MidiController::MidiController(std::shared_ptr<IO> io,
 
   // subscribe to played back notes
   played_back_pads_on
-    .subscribe([microgranny] (unsigned int pad) {
+    .subscribe(state->store->dispatching<unsigned int>([microgranny] (unsigned int pad) {
                  microgranny->pad_is_playing[pad].get_subscriber().on_next(true);
-               });
+               }));
   played_back_pads_off
-    .subscribe([microgranny] (unsigned int pad) {
+    .subscribe(state->store->dispatching<unsigned int>([microgranny] (unsigned int pad) {
                  microgranny->pad_is_playing[pad].get_subscriber().on_next(false);
-               });
+               }));
 }
@@ -35,7 +35,7 @@ MicroGranny::PadsController::PadsController(std::shared_ptr<IO> io,
 
   // subscribe to grid press events
   pad_press_events
-    .subscribe([io, microgranny] (grid_section_index_t pad) {
+    .subscribe([io, state, microgranny] (grid_section_index_t pad) {
 
                  // create midi note to emit
                  midi_event_t midi_event = { .source      = "",
@@ -46,22 +46,26 @@ MicroGranny::PadsController::PadsController(std::shared_ptr<IO> io,
                  };
 
                  // emit pad midi note on
-                 io->midi->emit(midi_event);
+                 io->scheduler->emit(midi_event);
 
-                 microgranny->update_last_midi_notes_played(midi_event);
-                 microgranny->pad_is_playing[pad].get_subscriber().on_next(true);
+                 state->store->dispatch([microgranny, pad, midi_event] {
+                                          microgranny->update_last_midi_notes_played(midi_event);
+                                          microgranny->pad_is_playing[pad].get_subscriber().on_next(true);
+                                        });
                });
 
   // subscribe to grid unpress events
   pad_unpress_events
-    .subscribe([io, microgranny] (grid_section_index_t pad) {
+    .subscribe([io, state, microgranny] (grid_section_index_t pad) {
                  // emit midi off note
-                 io->midi->emit({ .source      = "",
-                                  .destination = "",
-                                  .data        = midi_note_off(microgranny->midi_map.notes[pad],
-                                                               microgranny->midi_map.channel),
+                 io->scheduler->emit({ .source      = "",
+                                       .destination = "",
+                                       .data        = midi_note_off(microgranny->midi_map.notes[pad],
+                                                                    microgranny->midi_map.channel),
                    });
 
-                 microgranny->pad_is_playing[pad].get_subscriber().on_next(false);
+                 state->store->dispatch([microgranny, pad] {
+                                          microgranny->pad_is_playing[pad].get_subscriber().on_next(false);
+                                        });
                });
 }
@@ -31,12 +31,12 @@ namespace MicroGranny {
     /// @brief midi mapping
     struct {
       unsigned int channel = 6;
-      std::vector<std::string> notes = { { "c-1"  },
-                                         { "c#-1" },
-                                         { "d-1"  },
-                                         { "d#-1" },
-                                         { "e-1"  },
-                                         { "f-1"  }
+      std::vector<midi_note_number_t> notes = { spn_to_num("c-1"),
+                                                spn_to_num("c#-1"),
+                                                spn_to_num("d-1"),
+                                                spn_to_num("d#-1"),
+                                                spn_to_num("e-1"),
+                                                spn_to_num("f-1"),
       };
     } midi_map;
 
@@ -0,0 +1,134 @@
+#include <cmath>
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "anemone/config.hpp"
+#include "anemone/render/project.hpp"
+
+
+namespace {
+  long beats_to_ticks(double beats) {
+    return std::lround(beats * PPQN::Max);
+  }
+
+  PPQN ppqn_from_config(Config node) {
+    auto ppqn = node.as<unsigned int>();
+
+    switch (ppqn) {
+    case PPQN::One:
+    case PPQN::Two:
+    case PPQN::Four:
+    case PPQN::Eight:
+    case PPQN::Sixteen:
+    case PPQN::ThirtyTwo:
+    case PPQN::SixtyFour:
+      return static_cast<PPQN>(ppqn);
+    default:
+      spdlog::error("invalid ppqn {} in project (must be a power of two up to {})", ppqn, PPQN::Max);
+      exit( EXIT_FAILURE );
+    }
+  }
+
+  void check_instrument(std::string name) {
+    if (!instrument_name_from_string(name)) {
+      spdlog::error("unknown instrument '{}' in project", name);
+      exit( EXIT_FAILURE );
+    }
+  }
+}
+
+std::optional<InstrumentName> instrument_name_from_string(std::string name) {
+  static const std::map<std::string, InstrumentName> names = {
+    { "er1",         InstrumentName::ER1 },
+    { "gr1",         InstrumentName::GR1 },
+    { "sp404",       InstrumentName::SP404 },
+    { "ms20",        InstrumentName::MS20 },
+    { "volcabeat",   InstrumentName::VOLCABEAT },
+    { "microbrute",  InstrumentName::MICROBRUTE },
+    { "juno60",      InstrumentName::JUNO60 },
+    { "microgranny", InstrumentName::MICROGRANNY },
+  };
+
+  auto itr = names.find(name);
+  if (itr == names.end()) return std::nullopt;
+
+  return itr->second;
+}
+
+project_t load_project(std::string path) {
+  Config config(path);
+
+  project_t project = { .name   = config["name"].as<std::string>(path),
+                        .bpm    = config["bpm"].as<double>(120),
+                        .length = beats_to_ticks(config["beats"].as<double>(16)),
+  };
+
+  for (auto itr : config.at("instruments").yml) {
+    auto name = itr.first.as<std::string>();
+    check_instrument(name);
+
+    Config node(itr.second, path);
+
+    project_instrument_t instrument = { .name    = name,
+                                        .bank    = node["bank"].as<bank_idx_t>(0),
+                                        .part    = node["part"].as<part_idx_t>(0),
+                                        .ppqn    = node["ppqn"].yml ? ppqn_from_config(node["ppqn"]) : PPQN::Four,
+                                        .playing = node["playing"].as<bool>(true),
+    };
+
+    if (node["last_step"].yml) instrument.last_step = node["last_step"].as<step_idx_t>();
+
+    for (auto step : node["steps"].yml) {
+      sequence_layer_t layer;
+
+      for (auto note : step.second) {
+        auto length = std::lround(note["length"].as<double>(1) * PPQN::Max);
+        if (length < 1) {
+          spdlog::error("invalid note length in project (must be longer than 1/{} of a step)", PPQN::Max);
+          exit( EXIT_FAILURE );
+        }
+
+        auto event = step_event_t::make_midi_note_on(note["note"].as<std::string>(),
+                                                     note["chan"].as<unsigned int>(1),
+                                                     note["vel"].as<unsigned int>(127),
+                                                     length);
+        layer.insert_or_assign(event.id, event);
+      }
+
+      instrument.steps[step.first.as<step_idx_t>()] = layer;
+    }
+
+    project.instruments.push_back(instrument);
+  }
+
+  for (auto entry : config.at("timeline").yml) {
+    Config node(entry, path);
+
+    project_change_t change = { .tick       = beats_to_ticks(node["beat"].as<double>(0)),
+                                .instrument = node["instrument"].as<std::string>(""),
+                                .curve      = TempoMap::Ramp::Linear,
+    };
+
+    if (!change.instrument.empty()) check_instrument(change.instrument);
+
+    if (node["ppqn"].yml)      change.ppqn      = ppqn_from_config(node["ppqn"]);
+    if (node["last_step"].yml) change.last_step = node["last_step"].as<step_idx_t>();
+    if (node["playing"].yml)   change.playing   = node["playing"].as<bool>();
+    if (node["bpm"].yml)       change.bpm       = node["bpm"].as<double>();
+    if (node["ramp"].yml)      change.ramp      = node["ramp"].as<double>();
+
+    change.curve = node["curve"].as<std::string>("linear") == "exponential" ?
+      TempoMap::Ramp::Exponential : TempoMap::Ramp::Linear;
+
+    project.timeline.push_back(change);
+  }
+
+  // keep changes on the same tick in the order they were written.
+  std::stable_sort(project.timeline.begin(), project.timeline.end(),
+                   [] (const project_change_t& a, const project_change_t& b) {
+                     return a.tick < b.tick;
+                   });
+
+  return project;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file   render/project.hpp
+ * @brief  Offline Render Project
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef ANEMONE_RENDER_PROJECT_H
+#define ANEMONE_RENDER_PROJECT_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <optional>
+
+#include "anemone/types.hpp"
+#include "anemone/io/clock/tempo.hpp"
+
+
+/// @brief an instrument to render, and the part it plays.
+struct project_instrument_t {
+  std::string    name;
+  bank_idx_t     bank;
+  part_idx_t     part;
+  PPQN           ppqn;
+  bool           playing;
+
+  /// @brief the step selected as the last step, as on the grid.
+  std::optional<step_idx_t> last_step;
+
+  /// @brief the notes played on each (absolute) step.
+  std::map<step_idx_t, sequence_layer_t> steps;
+};
+
+/// @brief a change made during playback, as if it were made from the grid.
+///
+/// @details
+/// a change is applied between two ticks, right before the tick at `tick`. instrument
+/// changes apply to the instrument's part in playback, global changes have no instrument.
+///
+struct project_change_t {
+  long        tick;
+  std::string instrument;
+
+  std::optional<PPQN>       ppqn;
+  std::optional<step_idx_t> last_step;
+  std::optional<bool>       playing;
+  std::optional<double>     bpm;
+
+  /// @brief the length (in beats) of a ramp to the new bpm.
+  std::optional<double>     ramp;
+  TempoMap::Ramp            curve;
+};
+
+/// @brief a project to render offline.
+///
+/// @details
+/// a project is a yaml file of the form,
+///
+/// ```yaml
+/// bpm: 120
+/// beats: 32        # length of the render in quarter notes
+///
+/// instruments:     # the instruments to render, all others are stopped
+///   er1:
+///     bank: 0
+///     part: 0
+///     ppqn: 4
+///     last_step: 16
+///     steps:
+///       0: [ { note: c4, chan: 1, vel: 127 } ]
+///       4: [ { note: d4, length: 0.5 } ]  # held for half a step (1 by default)
+///
+/// timeline:        # changes applied at the start of the given beat
+///   - { beat: 8,  instrument: er1, ppqn: 8 }
+///   - { beat: 12, instrument: er1, last_step: 8 }
+///   - { beat: 16, instrument: er1, playing: false }
+///   - { beat: 20, instrument: er1, playing: true }
+///   - { beat: 24, bpm: 140 }
+///   - { beat: 28, bpm: 90, ramp: 4, curve: exponential }  # ramp over 4 beats
+/// ```
+///
+/// beats may be fractional, they are rounded to the nearest tick.
+///
+struct project_t {
+  std::string name;
+  double      bpm;
+
+  /// @brief the length of the render in ticks.
+  long length;
+
+  std::vector<project_instrument_t> instruments;
+
+  /// @brief the changes, sorted by tick.
+  std::vector<project_change_t> timeline;
+};
+
+/// @brief loads a project file.
+///
+/// @remark exits when the project is invalid.
+///
+/// @param path   the path to the project file.
+///
+/// @return the project.
+///
+project_t load_project(std::string path);
+
+/// @brief looks up an instrument name as used in the config & project files.
+///
+/// @param name   the instrument name (e.g. "er1").
+///
+/// @return the instrument name, if there is such an instrument.
+///
+std::optional<InstrumentName> instrument_name_from_string(std::string);
+
+#endif
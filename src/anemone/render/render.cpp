@@ -0,0 +1,183 @@
+#include <spdlog/spdlog.h>
+
+#include "anemone/io/grid/device/null.hpp"
+#include "anemone/io/midi/device/null.hpp"
+#include "anemone/render/render.hpp"
+#include "anemone/controllers/ppqn.hpp"
+#include "anemone/controllers/play_pause.hpp"
+
+
+namespace {
+  // same as selecting the last step of the part.
+  void set_last_step(std::shared_ptr<Part> part, step_idx_t step, unsigned int page_size) {
+    auto last = absolute_to_paged_step(step, page_size);
+
+    part->step.last.get_subscriber().on_next(last);
+    part->page.last.get_subscriber().on_next(last.page);
+  }
+}
+
+Renderer::Renderer(std::string config_path, std::string project_path)
+  : project(load_project(project_path)),
+    clock(std::make_shared<VirtualClock>(VirtualClock::Mode::Stepped)),
+    anemone(config_path,
+            std::make_shared<NullGrid>(),
+            std::make_shared< MidiDeviceFactoryFor<NullMidiIn, NullMidiOut> >(),
+            clock)
+{}
+
+bool Renderer::render(std::string path) {
+  spdlog::info("============= rendering =================");
+
+  StandardMidiFile smf(PPQN::Max, project.name);
+
+  anemone.state->connect();
+
+  setup();
+
+  anemone.io->connect();
+
+  std::vector<rx::composite_subscription> subscriptions;
+
+  // keep track of the tick being played. since we subscribe before the controllers,
+  // this is up to date by the time they play the tick. the tempo is taken from the
+  // ticks themselves, so it follows the clock exactly (including ramps).
+  subscriptions.push_back(anemone.io->clock_events
+                          .subscribe([this, &smf] (tick_t t) {
+                                       tick = t.index;
+
+                                       if (t.period != period) {
+                                         period = t.period;
+                                         smf.add_tempo(t.index, (60.0 * 1000 * 1000 * 1000) / (period.count() * (double)PPQN::Max));
+                                       }
+                                     }));
+
+  // record what each instrument plays on its own track.
+  for (auto& rendered : project.instruments) {
+    auto instrument = anemone.state->instruments->by_name.at(*instrument_name_from_string(rendered.name));
+    auto track      = smf.add_track(rendered.name);
+
+    subscriptions.push_back(instrument->playback_midi_events.get_observable()
+                            .subscribe([this, &smf, track] (midi_event_t e) {
+                                         smf.add_event(track, tick, e.data);
+                                       }));
+  }
+
+  anemone.controllers->connect();
+
+  // play up to each change, make it while the clock is held, and carry on.
+  long played = 0;
+  for (auto& change : project.timeline) {
+    if (change.tick >= project.length) break;
+
+    clock->step(change.tick - played);
+    played = change.tick;
+
+    apply(change);
+  }
+
+  clock->step(project.length - played);
+
+  anemone.io->clock->disconnect();
+
+  for (auto& subscription : subscriptions) subscription.unsubscribe();
+
+  if (!smf.write(path, project.length)) {
+    spdlog::error("could not write '{}'", path);
+    return false;
+  }
+
+  spdlog::info("  rendered {} ticks -> {}", project.length, path);
+
+  return true;
+}
+
+void Renderer::setup() {
+  auto state     = anemone.state;
+  auto part_size = state->layouts->sequencer->parts->size();
+  auto page_size = state->layouts->sequencer->steps->size();
+
+  state->controls->set_bpm(project.bpm);
+
+  // the clock isn't connected yet, so the state the tick engine plays from can be set
+  // directly rather than deferred (see `DeferredActions`).
+
+  // only the instruments in the project are played.
+  for (auto& itr : state->instruments->by_name) {
+    itr.second->playback.playing.store(false);
+    itr.second->status.is_playing.get_subscriber().on_next(false);
+  }
+
+  for (auto& rendered : project.instruments) {
+    auto itr = state->instruments->by_name.find(*instrument_name_from_string(rendered.name));
+    if (itr == state->instruments->by_name.end()) {
+      spdlog::error("instrument '{}' is not configured", rendered.name);
+      exit( EXIT_FAILURE );
+    }
+
+    auto instrument = itr->second;
+
+    auto part_idx = (rendered.bank * part_size) + rendered.part;
+    if (rendered.part >= part_size || part_idx >= instrument->parts.size()) {
+      spdlog::error("instrument '{}' has no part {} in bank {}", rendered.name, rendered.part, rendered.bank);
+      exit( EXIT_FAILURE );
+    }
+
+    auto part = instrument->parts[part_idx];
+
+    instrument->playback.bank.store(rendered.bank);
+    instrument->playback.part.store(part_idx);
+    instrument->status.bank.in_playback.get_subscriber().on_next(rendered.bank);
+    instrument->status.bank.under_edit.get_subscriber().on_next(rendered.bank);
+    instrument->status.part.in_playback.get_subscriber().on_next(part);
+    instrument->status.part.under_edit.get_subscriber().on_next(part);
+
+    part->ppqn.in_playback.store(rendered.ppqn);
+    part->ppqn.current.get_subscriber().on_next(rendered.ppqn);
+    part->ppqn.previous.get_subscriber().on_next(rendered.ppqn);
+    part->ppqn.next.get_subscriber().on_next(rendered.ppqn);
+
+    if (rendered.last_step) set_last_step(part, *rendered.last_step, page_size);
+
+    for (auto& step : rendered.steps) {
+      part->sequence.add_midi_note_events_at(absolute_to_paged_step(step.first, page_size),
+                                             step.first * PPQN::Max,
+                                             step.second);
+    }
+
+    // same as pressing the play/pause button of the part.
+    if (rendered.playing) play_pause(state, instrument, part, true);
+  }
+}
+
+void Renderer::apply(const project_change_t& change) {
+  auto state = anemone.state;
+
+  if (change.bpm && change.ramp) {
+    anemone.io->clock->tempo().ramp(*change.bpm, *change.ramp, change.curve);
+  } else if (change.bpm) {
+    state->controls->set_bpm(*change.bpm);
+  }
+
+  if (change.instrument.empty()) return;
+
+  auto itr = state->instruments->by_name.find(*instrument_name_from_string(change.instrument));
+  if (itr == state->instruments->by_name.end()) {
+    spdlog::warn("skipping change at tick {}, instrument '{}' is not configured", change.tick, change.instrument);
+    return;
+  }
+
+  auto instrument = itr->second;
+  auto part       = instrument->part_in_playback();
+
+  // like the ppqn buttons, the change only takes effect once the part is on a step.
+  if (change.ppqn) change_ppqn(state, part, *change.ppqn);
+
+  if (change.last_step) {
+    set_last_step(part, *change.last_step, state->layouts->sequencer->steps->size());
+  }
+
+  // like the play/pause button, playing waits for the next beat (if anything else is
+  // playing) and pausing for the next step.
+  if (change.playing) play_pause(state, instrument, part, *change.playing);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file   render/render.hpp
+ * @brief  Offline Renderer Class
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef ANEMONE_RENDER_RENDER_H
+#define ANEMONE_RENDER_RENDER_H
+
+#include <string>
+#include <memory>
+
+#include "anemone/anemone.hpp"
+#include "anemone/io/midi/smf.hpp"
+#include "anemone/render/project.hpp"
+
+
+/// @brief Renders a project to a Standard Midi File, as fast as possible.
+///
+/// @details
+/// the renderer runs anemone headless (without a grid or any midi ports) on a stepped
+/// virtual clock, so the sequence is played back by the same controllers as it is live.
+/// the clock is stepped up to each change in the project timeline, the change is made
+/// while the clock is held, and playback resumes. the midi played by each rendered
+/// instrument is written to its own track, at the tick it was played on, with one
+/// file tick per clock tick (i.e. a division of `PPQN::Max`).
+///
+class Renderer {
+public:
+  /// @brief constructs a renderer for a project.
+  ///
+  /// @param config_path    the path to the anemone configuration file.
+  /// @param project_path   the path to the project file.
+  ///
+  Renderer(std::string config_path, std::string project_path);
+
+  /// @brief renders the project.
+  ///
+  /// @param path   the path of the midi file to write.
+  ///
+  /// @return whether the midi file could be written.
+  ///
+  bool render(std::string path);
+
+private:
+  project_t project;
+
+  std::shared_ptr<VirtualClock> clock;
+
+  Anemone anemone;
+
+  /// @brief sets up the rendered instruments & parts before playback.
+  void setup();
+
+  /// @brief makes a change from the project timeline.
+  void apply(const project_change_t&);
+
+  /// @brief the index of the tick being played.
+  long tick = 0;
+
+  /// @brief the period following the tick being played.
+  std::chrono::nanoseconds period = {};
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef ANEMONE_RX_DISPATCHER_H
+#define ANEMONE_RX_DISPATCHER_H
+
+#include <vector>
+#include <memory>
+
+#include "anemone/util/concurrent_queue.hpp"
+
+
+namespace rx {
+
+  /// @brief Dispatcher of actions onto the queue they are applied from.
+  template<typename Action>
+  class Dispatcher {
+  public:
+    Dispatcher(std::shared_ptr< Queue<Action> >);
+    void dispatch(const Action& action);
+    void dispatch(Action&& action);
+    void dispatch(std::vector<Action> actions);
+
+  private:
+    std::shared_ptr< Queue<Action> > queue;
+  };
+
+
+  template<typename Action>
+  Dispatcher<Action>::Dispatcher(std::shared_ptr< Queue<Action> > q)
+    : queue(q) {};
+
+
+  template<typename Action>
+  void Dispatcher<Action>::dispatch(const Action& action) {
+    queue->push(action);
+  }
+
+  template<typename Action>
+  void Dispatcher<Action>::dispatch(Action&& action) {
+    queue->push(std::move(action));
+  }
+
+  template<typename Action>
+  void Dispatcher<Action>::dispatch(std::vector<Action> actions) {
+    for (auto& action : actions) {
+      queue->push(std::move(action));
+    }
+  }
+
+}
+
+#endif
@@ -21,4 +21,10 @@
 // instruments
 #include "anemone/state/instruments/instruments.hpp"
 
+// deferred actions
+#include "anemone/state/deferred/deferred.hpp"
+
+// action store
+#include "anemone/state/store/store.hpp"
+
 #endif
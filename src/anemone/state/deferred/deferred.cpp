@@ -0,0 +1,111 @@
+#include <algorithm>
+
+#include "anemone/state/deferred/deferred.hpp"
+
+
+namespace {
+  /// @brief the length of a bar, in ticks.
+  const long bar = 4 * PPQN::Max;
+
+  /// @brief the first multiple of `n` from `tick`.
+  long next_multiple(long tick, long n) {
+    return ((tick + n - 1) / n) * n;
+  }
+}
+
+void DeferredActions::defer(std::shared_ptr<Part> part, Quantize quantize, action_t action) {
+  {
+    std::lock_guard<std::mutex> guard(incoming_mutex);
+
+    incoming.push_back({ .part = part, .quantize = quantize, .action = action });
+    has_incoming.store(true, std::memory_order_release);
+  }
+
+  if (waiting.fetch_add(1, std::memory_order_acq_rel) == 0) on_pending();
+}
+
+void DeferredActions::apply(tick_t tick) {
+  // schedule the actions deferred since the last tick.
+  if (has_incoming.load(std::memory_order_acquire)) {
+    std::vector<deferred_t> deferred;
+    {
+      std::lock_guard<std::mutex> guard(incoming_mutex);
+      deferred.swap(incoming);
+      has_incoming.store(false, std::memory_order_relaxed);
+    }
+
+    for (auto& d : deferred) {
+      auto due_on = next_candidate(tick, tick.index, d);
+      wheel.schedule(due_on, std::move(d));
+    }
+  }
+
+  if (wheel.empty()) {
+    wheel.advance(tick.index, [] (long, deferred_t&) {});
+    return;
+  }
+
+  wheel.advance(tick.index, [this] (long, deferred_t& d) { due.push_back(std::move(d)); });
+
+  // apply the actions which are on their boundary, in the order they were deferred,
+  // and push the others back.
+  std::size_t applied = 0;
+  for (auto& d : due) {
+    if (is_aligned(tick, d)) {
+      d.action();
+      applied++;
+    } else {
+      auto due_on = next_candidate(tick, tick.index + 1, d);
+      wheel.schedule(due_on, std::move(d));
+    }
+  }
+  due.clear();
+
+  if (applied > 0 && waiting.fetch_sub(applied, std::memory_order_acq_rel) == applied) on_pending();
+}
+
+bool DeferredActions::is_aligned(const tick_t& tick, const deferred_t& d) {
+  switch (d.quantize) {
+  case Quantize::Tick:
+    return true;
+  case Quantize::Step:
+    // a part which isn't advancing (e.g. paused off a step) would never get there.
+    return !d.part->step.advancing.load(std::memory_order_relaxed) ||
+      d.part->step.cursor.load(std::memory_order_relaxed) % PPQN::Max == 0;
+  case Quantize::Sequence:
+    return !d.part->step.advancing.load(std::memory_order_relaxed) ||
+      d.part->step.cursor.load(std::memory_order_relaxed) == 0;
+  case Quantize::Beat:
+    return tick.index % PPQN::Max == 0;
+  case Quantize::Bar:
+  default:
+    return tick.index % bar == 0;
+  }
+}
+
+long DeferredActions::next_candidate(const tick_t& tick, long from, const deferred_t& d) {
+  switch (d.quantize) {
+  case Quantize::Tick:
+    return from;
+  case Quantize::Step:
+  case Quantize::Sequence: {
+    // a part which isn't advancing is as good as on its boundary.
+    if (!d.part->step.advancing.load(std::memory_order_relaxed)) return from;
+
+    // the cursor moves by the part's ppqn every tick, and comes back to the top of the
+    // sequence on a step, so both boundaries can only fall on the part's next step.
+    auto step = d.part->step.cursor.load(std::memory_order_relaxed);
+    auto ppqn = static_cast<long>(d.part->ppqn.in_playback.load(std::memory_order_relaxed));
+    auto off  = static_cast<long>(step % PPQN::Max);
+
+    long ticks = off == 0 ? 0 : (PPQN::Max - off + ppqn - 1) / ppqn;
+
+    return std::max(from, tick.index + ticks);
+  }
+  case Quantize::Beat:
+    return next_multiple(from, PPQN::Max);
+  case Quantize::Bar:
+  default:
+    return next_multiple(from, bar);
+  }
+}
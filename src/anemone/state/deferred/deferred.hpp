@@ -0,0 +1,129 @@
+/**
+ * @file   state/deferred/deferred.hpp
+ * @brief  Quantized Deferred Actions
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef STATE_DEFERRED_DEFERRED_H
+#define STATE_DEFERRED_DEFERRED_H
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "anemone/types/io/clock/tick.hpp"
+#include "anemone/types/instrument/part/part.hpp"
+#include "anemone/util/timing_wheel.hpp"
+
+
+/// @brief the musical boundary a deferred action is aligned to.
+enum class Quantize {
+                     /// the next tick, i.e. as soon as possible on the tick thread.
+                     Tick,
+                     /// the part's cursor is on a step (i.e. a multiple of `PPQN::Max`), or
+                     /// the part isn't advancing.
+                     Step,
+                     /// the clock is on a beat.
+                     Beat,
+                     /// the clock is on a bar (of four beats).
+                     Bar,
+                     /// the part's cursor is back at the top of its sequence, or the part
+                     /// isn't advancing.
+                     Sequence,
+};
+
+/// @brief Scheduler of state changes which must happen on musical boundaries.
+///
+/// @details
+/// controllers defer a mutation (e.g. changing a part's ppqn) until the next step,
+/// beat, bar or end of sequence, and the tick engine applies it at the start of the
+/// tick on which that boundary falls, before any part moves. deferred actions are kept
+/// in a timing wheel keyed by the tick they are expected to be due on, so ticks cost
+/// nothing while nothing is pending. since a part's cursor may change pace (or stop)
+/// while an action waits, actions aligned to a part are checked when they come up and
+/// pushed back to the next candidate tick if the part isn't on the boundary yet. a part
+/// which isn't advancing (e.g. it is paused, or not in playback) never gets to its
+/// boundary, so its actions are applied right away rather than waiting for it to play.
+///
+/// deferred actions are the only writers of the state the tick engine plays from:
+///   - `Part::ppqn.in_playback` and the part's step cursor,
+///   - `Instrument::playback`, i.e. the instrument's part & bank in playback and whether
+///     it is playing.
+///
+/// so that the tick engine never sees them change in the middle of a tick, and they never
+/// have two writers. controllers which change them right away defer them until the next
+/// `Tick`. they are only set directly when setting up the state, before the clock connects
+/// (e.g. when rendering offline). any other state an action changes, including the
+/// behaviors mirroring the state above (e.g. `Instrument::status.is_playing` or `Part::ppqn.current`), is
+/// posted to the `Store` from the action (see `Store::post`), so that no subscriber runs
+/// on the tick thread, and it never waits on the store's queue.
+///
+/// @remark actions can be deferred from any thread, they are applied on the tick thread.
+///
+class DeferredActions {
+public:
+  typedef std::function<void()> action_t;
+
+  /// @brief defers an action until a musical boundary.
+  ///
+  /// @param part       the part the boundary is relative to.
+  /// @param quantize   the boundary to wait for.
+  /// @param action     the action to apply.
+  ///
+  void defer(std::shared_ptr<Part>, Quantize, action_t);
+
+  /// @brief whether actions are waiting to be applied.
+  bool pending() const { return waiting.load(std::memory_order_acquire) > 0; };
+
+  /// @brief called whenever actions start or stop waiting to be applied, e.g. so that the
+  /// clock doesn't idle while they wait for a tick.
+  ///
+  /// @remark it must be set before actions are deferred from other threads.
+  ///
+  std::function<void()> on_pending = [] {};
+
+  /// @brief applies the actions due on a tick.
+  ///
+  /// @remark this is called by the tick engine, at the start of each tick.
+  ///
+  /// @param tick   the tick being played.
+  ///
+  void apply(tick_t);
+
+private:
+  struct deferred_t {
+    std::shared_ptr<Part> part;
+    Quantize              quantize;
+    action_t              action;
+  };
+
+  /// @brief actions waiting for their tick (tick thread only).
+  TimingWheel<deferred_t> wheel;
+
+  /// @brief actions which came up on the tick being applied (tick thread only).
+  std::vector<deferred_t> due;
+
+  /// @brief the number of actions deferred and not applied yet.
+  std::atomic<std::size_t> waiting = { 0 };
+
+  /// @brief actions deferred since the last tick.
+  std::vector<deferred_t> incoming;
+  std::atomic<bool>       has_incoming { false };
+  std::mutex              incoming_mutex;
+
+  /// @brief whether the tick is on the action's boundary.
+  bool is_aligned(const tick_t&, const deferred_t&);
+
+  /// @brief the first tick, from the provided one, which may be on the action's boundary.
+  ///
+  /// @param tick   the tick being played.
+  /// @param from   the earliest tick to consider.
+  ///
+  long next_candidate(const tick_t&, long from, const deferred_t&);
+};
+
+#endif
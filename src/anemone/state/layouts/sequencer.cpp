@@ -3,6 +3,7 @@
 #include "anemone/plugins.hpp"
 #include "anemone/state/state.hpp"
 #include "anemone/state/layouts/sequencer.hpp"
+#include "anemone/types/instrument/sequence/rendered.hpp"
 
 
 GridLayout::Sequencer::Sequencer(std::shared_ptr<Config> config, std::shared_ptr<PluginManager> plugin_manager)
@@ -21,6 +22,11 @@ GridLayout::Sequencer::Sequencer(std::shared_ptr<Config> config, std::shared_ptr
                                                     layouts.parse_grid_region("instrument_controls"));
   steps                = std::make_shared<GridSection>(GridSectionName::Steps,
                                                        layouts.parse_grid_region("steps"));
+  if (steps->size() > RenderedSteps::max_page_size) {
+    // each page of rendered steps is kept in a single bitmask.
+    spdlog::error("steps section too large ({} steps, the most is {})", steps->size(), RenderedSteps::max_page_size);
+    exit( EXIT_FAILURE );
+  }
   pages                = std::make_shared<GridSection>(GridSectionName::Pages,
                                                        layouts.parse_grid_region("pages"));
   parts                = std::make_shared<GridSection>(GridSectionName::Parts,
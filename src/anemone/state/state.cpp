@@ -7,7 +7,9 @@
 State::State(std::shared_ptr<Config> config, std::shared_ptr<PluginManager> plugin_manager)
   : layouts(std::make_shared<GridLayouts>(config, plugin_manager)),
     controls(std::make_shared<GlobalControls>(config)),
-    instruments(std::make_shared<Instruments>(config, plugin_manager->instrument_plugins))
+    instruments(std::make_shared<Instruments>(config, plugin_manager->instrument_plugins)),
+    deferred(std::make_shared<DeferredActions>()),
+    store(std::make_shared<Store>())
 {}
 
 void State::connect() {
@@ -15,6 +15,8 @@
 #include "anemone/state/layouts/layouts.hpp"
 #include "anemone/state/controls/controls.hpp"
 #include "anemone/state/instruments/instruments.hpp"
+#include "anemone/state/deferred/deferred.hpp"
+#include "anemone/state/store/store.hpp"
 
 
 // forward declare
@@ -23,9 +25,11 @@ class PluginManager;
 
 class State : public std::enable_shared_from_this<State> {
 public:
-  std::shared_ptr<GridLayouts>    layouts;
-  std::shared_ptr<GlobalControls> controls;
-  std::shared_ptr<Instruments>    instruments;
+  std::shared_ptr<GridLayouts>     layouts;
+  std::shared_ptr<GlobalControls>  controls;
+  std::shared_ptr<Instruments>     instruments;
+  std::shared_ptr<DeferredActions> deferred;
+  std::shared_ptr<Store>           store;
   
   State(std::shared_ptr<Config>, std::shared_ptr<PluginManager>);
 
@@ -0,0 +1,92 @@
+
+#include <chrono>
+
+#include <spdlog/spdlog.h>
+
+#include "anemone/state/store/store.hpp"
+
+
+Store::Store()
+  : queue(std::make_shared< Queue<action_t> >()),
+    dispatcher(queue)
+{}
+
+Store::~Store() {
+  stop();
+}
+
+void Store::dispatch(action_t action) {
+  if (applies_inline()) {
+    action();
+    return;
+  }
+
+  dispatcher.dispatch(std::move(action));
+  wake.notify();
+}
+
+void Store::start() {
+  if (writer.joinable()) return;
+
+  writer    = std::thread([this] { write(); });
+  writer_id = writer.get_id();
+
+  // actions are only queued once the writer is known.
+  running.store(true, std::memory_order_release);
+
+  spdlog::info("  connected -> state store");
+}
+
+void Store::stop() {
+  if (!writer.joinable()) return;
+
+  // an empty action wakes the writer up, once everything before it is applied.
+  dispatcher.dispatch(action_t());
+  wake.notify();
+  writer.join();
+}
+
+bool Store::applies_inline() const {
+  return !running.load(std::memory_order_acquire) || std::this_thread::get_id() == writer_id;
+}
+
+std::size_t Store::apply_posted() {
+  auto applied = posted.drain([] (change_t change) { change.apply(change.target, change.value); }, max_batch);
+  applied_count.fetch_add(applied, std::memory_order_relaxed);
+
+  return applied;
+}
+
+void Store::write() {
+  std::vector<action_t> batch;
+  batch.reserve(max_batch);
+
+  auto is_ready = [this] { return !posted.empty() || !queue->empty(); };
+
+  while (true) {
+    auto applied = apply_posted();
+
+    batch.clear();
+    queue->try_pop(batch, max_batch);
+
+    for (auto& action : batch) {
+      if (!action) {
+        // the changes posted before stopping are applied too.
+        while (apply_posted() > 0);
+
+        running.store(false, std::memory_order_release);
+        return;
+      }
+
+      action();
+      applied_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (applied == 0 && batch.empty()) {
+      wake.wait(is_ready, std::chrono::nanoseconds::max());
+      continue;
+    }
+
+    batch_count.fetch_add(1, std::memory_order_relaxed);
+  }
+}
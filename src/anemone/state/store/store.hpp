@@ -0,0 +1,163 @@
+/**
+ * @file   state/store/store.hpp
+ * @brief  Single Writer Action Store
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef STATE_STORE_STORE_H
+#define STATE_STORE_STORE_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "anemone/rx/dispatcher.hpp"
+#include "anemone/util/ring.hpp"
+#include "anemone/util/concurrent_queue.hpp"
+
+
+/// @brief Store through which all (low frequency) state mutations go.
+///
+/// @details
+/// controllers run on whichever thread their events come from (the grid, midi and
+/// clock threads), so rather than mutating the state themselves, they dispatch actions
+/// which mutate it. actions are queued and applied in order by a single writer thread,
+/// in batches of at most `max_batch`, so state is never mutated concurrently and the
+/// subjects behind it are never contended.
+///
+/// until the writer is started (e.g. when rendering offline) actions are applied as
+/// they are dispatched, on the dispatching thread. actions dispatched from the writer
+/// itself (e.g. by a subscriber of the state an action mutated) are also applied as
+/// they are dispatched.
+///
+/// the tick thread doesn't dispatch (dispatching locks the queue, and allocates when an
+/// action doesn't fit in a `std::function`), it posts changes instead: a function, its
+/// target and an integral value, pushed to a lock-free ring which the writer drains
+/// before each batch of actions.
+///
+/// @remark high frequency state (see `HighFrequencyState`) and the state the tick engine
+/// plays from (see `DeferredActions`) are not mutated through the store but on the tick
+/// thread, since they must change on their tick. no action may mutate them, while
+/// deferred actions post whatever else they change to the store.
+///
+class Store {
+public:
+  /// @brief an action, i.e. a reducer bound to its arguments.
+  typedef std::function<void()> action_t;
+
+  /// @brief the maximum number of actions applied per batch.
+  static constexpr std::size_t max_batch = 64;
+
+  Store();
+  ~Store();
+
+  Store(const Store&) = delete;
+  Store& operator=(const Store&) = delete;
+
+  /// @brief dispatches an action, from any thread but the tick thread (see `post`).
+  void dispatch(action_t);
+
+  /// @brief wraps a reducer of a value, so that calling it dispatches it with the value.
+  ///
+  /// @details e.g. `events.subscribe(store->dispatching<grid_event_t>([] (grid_event_t e) {...}))`.
+  ///
+  template <typename T, typename Reducer>
+  std::function<void(T)> dispatching(Reducer reducer) {
+    return [this, reducer] (T value) {
+             dispatch([reducer, value] { reducer(value); });
+           };
+  };
+
+  /// @brief posts a change, from the tick thread (or any thread which mustn't lock).
+  ///
+  /// @details e.g. `store->post<&follow_cursor>(part, page)`, with `follow_cursor` a
+  /// `void(Part*, page_idx_t)`, which the writer applies like an action.
+  ///
+  /// @tparam Apply   the function applying the change to its target.
+  ///
+  /// @remark the target must outlive the change. changes are applied in the order they
+  /// were posted, unless the ring is full: a change which doesn't fit is dispatched
+  /// instead (so it's never dropped), and may be applied before those already posted.
+  ///
+  template <auto Apply, typename Target, typename T>
+  void post(Target* target, T value) {
+    static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "only integral values can be posted");
+
+    if (applies_inline()) {
+      Apply(target, value);
+      return;
+    }
+
+    change_t change = {
+      .apply  = [] (void* target, std::uint64_t value) {
+                  Apply(static_cast<Target*>(target), static_cast<T>(value));
+                },
+      .target = target,
+      .value  = static_cast<std::uint64_t>(value),
+    };
+
+    if (!posted.try_push(change)) {
+      dispatch([target, value] { Apply(target, value); });
+      return;
+    }
+
+    wake.notify();
+  };
+
+  /// @brief starts the writer thread.
+  void start();
+
+  /// @brief stops the writer thread, once the actions already dispatched are applied.
+  void stop();
+
+  /// @brief the number of actions (and changes posted) applied by the writer.
+  unsigned long applied() const { return applied_count.load(std::memory_order_relaxed); };
+
+  /// @brief the number of batches applied by the writer.
+  unsigned long batches() const { return batch_count.load(std::memory_order_relaxed); };
+
+private:
+  /// @brief a change posted, i.e. a function applying a value to a target.
+  struct change_t {
+    void          (*apply)(void*, std::uint64_t);
+    void*         target;
+    std::uint64_t value;
+  };
+
+  std::shared_ptr< Queue<action_t> > queue;
+  rx::Dispatcher<action_t>          dispatcher;
+
+  /// @brief the changes posted, applied before each batch of actions.
+  MpscRing<change_t, 256> posted;
+
+  /// @brief wakes the writer up when an action is dispatched or a change posted.
+  RingSignal wake;
+
+  std::thread       writer;
+  std::thread::id   writer_id;
+  std::atomic<bool> running = { false };
+
+  std::atomic<unsigned long> applied_count = { 0 };
+  std::atomic<unsigned long> batch_count   = { 0 };
+
+  /// @brief whether actions are applied as they are dispatched, on the caller's thread.
+  bool applies_inline() const;
+
+  /// @brief applies the changes posted (writer thread).
+  ///
+  /// @return the number of changes applied.
+  ///
+  std::size_t apply_posted();
+
+  /// @brief applies batches of actions until stopped (writer thread).
+  void write();
+};
+
+#endif
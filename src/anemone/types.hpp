@@ -26,10 +26,12 @@
 
 // midi types
 #include "anemone/types/io/midi/data.hpp"
+#include "anemone/types/io/midi/sysex.hpp"
 #include "anemone/types/io/midi/event.hpp"
 
 // clock types
 #include "anemone/types/io/clock/tick.hpp"
+#include "anemone/types/io/clock/transport.hpp"
 
 // global control types
 #include "anemone/types/controls/ppqn.hpp"
@@ -19,6 +19,12 @@ Instrument::Instrument(InstrumentName name,
     last_midi_notes_played(rx::behavior<sequence_layer_t>(default_midi_notes))
 {}
 
+Instrument::playback_t::playback_t(const playback_t& other)
+  : part(other.part.load()),
+    bank(other.bank.load()),
+    playing(other.playing.load())
+{}
+
 void Instrument::update_last_midi_notes_played(midi_event_t midi_event) {
   // TODO add timing logic to aggregate closely timed updates!
 
@@ -8,6 +8,7 @@
 #ifndef TYPES_INSTRUMENTS_INSTRUMENT_H
 #define TYPES_INSTRUMENTS_INSTRUMENT_H
 
+#include <atomic>
 #include <memory>
 
 #include "anemone/rx.hpp"
@@ -53,6 +54,30 @@ public:
   status_t status;
   std::vector<std::shared_ptr<Part> > parts;
 
+  /// @brief the state the tick engine plays from.
+  ///
+  /// @details it is only written by deferred actions (see `DeferredActions`) on the tick
+  /// thread, and read by the tick engine without locking. the behaviors of `status`
+  /// mirror it for everyone else, and are updated through the `Store`.
+  struct playback_t {
+    std::atomic<part_idx_t> part    = { 0 };
+    std::atomic<bank_idx_t> bank    = { 0 };
+    std::atomic<bool>       playing = { true };
+
+    playback_t() = default;
+
+    /// @remark copies a snapshot, only while the instruments are built.
+    playback_t(const playback_t&);
+  };
+
+  playback_t playback;
+
+  /// @brief the part the tick engine plays.
+  std::shared_ptr<Part> part_in_playback() const { return parts[playback.part.load(std::memory_order_acquire)]; };
+
+  /// @brief whether the tick engine plays this instrument.
+  bool is_playing() const { return playback.playing.load(std::memory_order_acquire); };
+
   /// @brief an abservable stream of midi events in playback.
   ///
   /// @details this stream is useful for when a specific instrument class
@@ -1,18 +1,20 @@
+#include <spdlog/spdlog.h>
+
 #include "anemone/types/instrument/part/part.hpp"
 
 
 Part::Part(part_idx_t id)
   : id(id),
-    ppqn({ .current        = rx::behavior<PPQN>(PPQN::Four),
-           .previous       = rx::behavior<PPQN>(PPQN::Four),
-           .next           = rx::behavior<PPQN>(PPQN::Four),
-           .pending_change = rx::behavior<bool>(false),
-      }),
-    page({ .rendered      = rx::behavior<page_idx_t>(0),
-           .under_edit    = rx::behavior<page_idx_t>(0),
-           .last          = rx::behavior<page_idx_t>(1), // TODO NOTE: this is duplicated state with step.last .... remove one of them. probably this one and make this derived inn the ui
-           .follow_cursor = rx::behavior<bool>(false),
-      }),
+    ppqn{ .current        = rx::behavior<PPQN>(PPQN::Four),
+          .previous       = rx::behavior<PPQN>(PPQN::Four),
+          .next           = rx::behavior<PPQN>(PPQN::Four),
+          .pending_change = rx::behavior<bool>(false),
+      },
+    page{ .rendered      = rx::behavior<page_idx_t>(0),
+          .under_edit    = rx::behavior<page_idx_t>(0),
+          .last          = rx::behavior<page_idx_t>(1), // TODO NOTE: this is duplicated state with step.last .... remove one of them. probably this one and make this derived inn the ui
+          .follow_cursor = rx::behavior<bool>(false),
+      },
     transport({ .is_playing          = rx::behavior<bool>(true),
                 .is_paused           = rx::behavior<bool>(false),
                 .is_stopped          = rx::behavior<bool>(false),
@@ -22,12 +24,45 @@ Part::Part(part_idx_t id)
                 .is_about_to_unpause = rx::behavior<bool>(false),
                 .pulse_pause_offset  = rx::behavior<int>(0),
       }),
-    step({ .current   = rx::behavior<granular_step_idx_t>(0),
-           .last      = rx::behavior<paged_step_idx_t>({ .page = 1, .step = 31 }),
-           .show_last = rx::behavior<bool>(false),
-      })
+    step{ .last      = rx::behavior<paged_step_idx_t>({ .page = 1, .step = 31 }),
+          .show_last = rx::behavior<bool>(false),
+      }
 {}
 
 void Part::Step::update_current(granular_step_idx_t step) {
-  current.get_subscriber().on_next(step);
+  cursor.store(step, std::memory_order_relaxed);
+  current.set(step);
+}
+
+void Part::mute(step_event_id_t id, bool muted) {
+  // index the layer if it has no events yet, so it is still muted once it does.
+  auto idx = sequence.layers.index(id);
+  if (idx == LayerIndex::unindexed) {
+    spdlog::warn("can't mute layer {:#x} of part {}, it has more than {} layers", id, this->id, LayerIndex::max_layers);
+    return;
+  }
+
+  auto bit = layer_mask_t(1) << idx;
+
+  if (muted) {
+    layers.muted.fetch_or(bit, std::memory_order_relaxed);
+  } else {
+    layers.muted.fetch_and(~bit, std::memory_order_relaxed);
+  }
+}
+
+void Part::solo(step_event_id_t id, bool soloed) {
+  auto idx = sequence.layers.index(id);
+  if (idx == LayerIndex::unindexed) {
+    spdlog::warn("can't solo layer {:#x} of part {}, it has more than {} layers", id, this->id, LayerIndex::max_layers);
+    return;
+  }
+
+  auto bit = layer_mask_t(1) << idx;
+
+  if (soloed) {
+    layers.soloed.fetch_or(bit, std::memory_order_relaxed);
+  } else {
+    layers.soloed.fetch_and(~bit, std::memory_order_relaxed);
+  }
 }
@@ -10,10 +10,12 @@
 #define ANEMONE_TYPES_INSTRUMENT_PART_H
 
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
 #include "anemone/rx.hpp"
+#include "anemone/util/high_frequency.hpp"
 
 #include "anemone/types/controls/ppqn.hpp"
 #include "anemone/types/instrument/page/page.hpp"
@@ -54,6 +56,12 @@ public:
     rx::behavior<PPQN> previous;
     rx::behavior<PPQN> next;
     rx::behavior<bool> pending_change;
+
+    /// @brief the ppqn the cursor moves at, read by the tick thread.
+    ///
+    /// @remark it is written by deferred actions, on the tick thread, and `current`
+    /// mirrors it (through the store) for everyone else.
+    std::atomic<PPQN>  in_playback = { PPQN::Four };
   };
 
   struct Page {
@@ -61,6 +69,9 @@ public:
     rx::behavior<page_idx_t> under_edit;
     rx::behavior<page_idx_t> last;
     rx::behavior<bool>       follow_cursor;
+
+    /// @brief the page the cursor is on (driven by the clock).
+    HighFrequencyState<page_idx_t> in_playback = { 0 };
   };
 
   // TODO maybe refactor this to be on Instrument innstead of each part....
@@ -84,22 +95,68 @@ public:
     rx::behavior<int> pulse_pause_offset;
   };
 
+  /// @remark the cursor moves by a granular step on every tick, but only the step it is
+  /// on is observed. so `current` is only updated when the cursor lands on a new step,
+  /// while `cursor` (read by the tick thread) always holds its exact position. both are
+  /// driven by the clock, so they are high frequency state rather than behaviors.
   struct Step {
-    rx::behavior<granular_step_idx_t> current;
+    HighFrequencyState<granular_step_idx_t> current = { 0 };
     // rx::behavior<paged_step_idx_t>    current_page_relative = { .page = 0, .step = 0 }; // TODO remove this redundancy!???
-    rx::behavior<paged_step_idx_t>    last;
-    rx::behavior<bool>                show_last;
+    rx::behavior<paged_step_idx_t>          last;
+    rx::behavior<bool>                      show_last;
+    std::atomic<granular_step_idx_t>        cursor  = { 0 };
+
+    /// @brief whether the cursor was advanced on the last tick, i.e. the part is in
+    /// playback and its instrument is playing (set by the tick engine).
+    std::atomic<bool>                       advancing = { false };
 
-    /// @brief update the current step.
+    /// @brief update the current step (and move the cursor to it).
     void update_current(granular_step_idx_t);
   };
+
+  /// @brief the muted & soloed layers of the sequence, as masks of its dense layers.
+  ///
+  /// @remark these are read by the tick thread on every tick, so they are atomics
+  /// rather than behaviors.
+  struct Layers {
+    std::atomic<layer_mask_t> muted  = { 0 };
+    std::atomic<layer_mask_t> soloed = { 0 };
+
+    /// @brief the layers which are heard, i.e. the soloed layers if there are any,
+    /// and all but the muted layers otherwise.
+    layer_mask_t audible() const {
+      auto solo = soloed.load(std::memory_order_relaxed);
+      return solo != 0 ? solo : ~muted.load(std::memory_order_relaxed);
+    };
+  };
   
   Ppqn ppqn;
   Page page;
   Transport transport;
   Step step;
+  Layers layers;
   Sequence sequence;
   bool unsaved;
+
+  /// @brief mutes (or unmutes) a layer of the sequence.
+  ///
+  /// @remark a layer which couldn't be indexed (see `LayerIndex::unindexed`) can't
+  /// be muted, it is reported and ignored.
+  ///
+  /// @param id      the layer id.
+  /// @param muted   whether it is muted.
+  ///
+  void mute(step_event_id_t, bool);
+
+  /// @brief solos (or unsolos) a layer of the sequence.
+  ///
+  /// @remark a layer which couldn't be indexed (see `LayerIndex::unindexed`) can't
+  /// be soloed, it is reported and ignored.
+  ///
+  /// @param id       the layer id.
+  /// @param soloed   whether it is soloed.
+  ///
+  void solo(step_event_id_t, bool);
 };
 
 #endif
@@ -0,0 +1,96 @@
+/**
+ * @file   types/instrument/sequence/layers.hpp
+ * @brief  Dense Sequence Layer Index
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef ANEMONE_TYPES_INSTRUMENT_SEQUENCE_LAYERS_H
+#define ANEMONE_TYPES_INSTRUMENT_SEQUENCE_LAYERS_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "anemone/types/instrument/step/event.hpp"
+
+
+/// @brief a dense, part relative, layer index.
+typedef unsigned char layer_idx_t;
+
+/// @brief a set of layers, the nth bit is the nth (dense) layer.
+typedef std::uint64_t layer_mask_t;
+
+/// @brief all layers.
+const layer_mask_t ALL_LAYERS = ~layer_mask_t(0);
+
+/// @brief Dense index of the layers of a sequence.
+///
+/// @details
+/// layer ids are sparse (e.g. `0x9A24`, see `step_event_id_t`), so each layer a
+/// sequence uses is given a small dense index the first time it is seen, in order.
+/// a selection of layers (e.g. the muted layers of a part) is then a bitmask, and
+/// checking whether an event is selected is a single bitwise and.
+///
+/// @remark only the first `max_layers` layers are indexed, the others are `unindexed`.
+/// the bit of `unindexed` is never muted nor soloed, so those layers are heard unless
+/// another layer is soloed, but they can't be selected on their own.
+///
+/// @remark the index is only written and read by the thread editing the sequence,
+/// i.e. the state store's writer (see `Store`). the tick thread never reads it, it
+/// reads the dense layers of the compiled events instead.
+///
+class LayerIndex {
+public:
+  /// @brief the number of layers which can be indexed.
+  static constexpr unsigned int max_layers = 63;
+
+  /// @brief the index of the layers which couldn't be indexed.
+  static constexpr layer_idx_t unindexed = max_layers;
+
+  /// @brief gets the index of a layer, indexing it if it's new.
+  ///
+  /// @return the index of the layer, or `unindexed` if there are already `max_layers`.
+  ///
+  layer_idx_t index(step_event_id_t id) {
+    auto itr = std::lower_bound(ids.begin(), ids.end(), id, by_id);
+    if (itr != ids.end() && itr->id == id) return itr->idx;
+    if (ids.size() == max_layers) return unindexed;
+
+    layer_idx_t idx = ids.size();
+    ids.insert(itr, { .id = id, .idx = idx });
+
+    return idx;
+  };
+
+  /// @brief gets the bit of a layer, if it has been indexed (and 0 otherwise, even if it
+  /// is `unindexed`).
+  layer_mask_t mask(step_event_id_t id) const {
+    auto itr = std::lower_bound(ids.begin(), ids.end(), id, by_id);
+    if (itr == ids.end() || itr->id != id) return 0;
+
+    return layer_mask_t(1) << itr->idx;
+  };
+
+  /// @brief gets the bits of a selection of layers.
+  layer_mask_t mask(const std::vector<step_event_id_t>& selected) const {
+    layer_mask_t bits = 0;
+    for (auto id : selected) bits |= mask(id);
+
+    return bits;
+  };
+
+private:
+  struct entry_t {
+    step_event_id_t id;
+    layer_idx_t     idx;
+  };
+
+  /// @brief the indexed layers, sorted by id.
+  std::vector<entry_t> ids;
+
+  static bool by_id(const entry_t& entry, step_event_id_t id) { return entry.id < id; };
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include "anemone/types/instrument/sequence/rendered.hpp"
+
+
+RenderedSteps::~RenderedSteps() {
+  for (auto& chunk : chunks) delete chunk.load(std::memory_order_relaxed);
+}
+
+unsigned int RenderedSteps::count(page_idx_t page) const {
+  return __builtin_popcountll(this->page(page));
+}
+
+unsigned int RenderedSteps::count() const {
+  unsigned int steps = 0;
+  for (page_idx_t page = 0; page < max_pages; page += chunk_pages) {
+    if (mask_of(page) == nullptr) continue;
+
+    for (page_idx_t n = 0; n < chunk_pages; n++) steps += count(page + n);
+  }
+
+  return steps;
+}
+
+std::uint64_t RenderedSteps::occupied(page_idx_t first) const {
+  std::uint64_t occupied = 0;
+  for (unsigned int n = 0; n < 64 && first + n < max_pages; n++) {
+    if (page(first + n) != 0) occupied |= std::uint64_t(1) << n;
+  }
+
+  return occupied;
+}
+
+std::size_t RenderedSteps::bytes() const {
+  std::size_t bytes = sizeof(RenderedSteps);
+  for (auto& chunk : chunks) {
+    if (chunk.load(std::memory_order_relaxed) != nullptr) bytes += sizeof(chunk_t);
+  }
+
+  return bytes;
+}
+
+RenderedSteps::chunk_t* RenderedSteps::allocate(unsigned int idx) {
+  // there is a single writer, so the chunk can't have been published meanwhile. it is
+  // zeroed before it is published, so readers only ever see empty pages in it.
+  auto chunk = new chunk_t();
+  chunks[idx].store(chunk, std::memory_order_release);
+
+  return chunk;
+}
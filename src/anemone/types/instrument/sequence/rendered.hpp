@@ -0,0 +1,121 @@
+/**
+ * @file   types/instrument/sequence/rendered.hpp
+ * @brief  Rendered Steps Index
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef ANEMONE_TYPES_INSTRUMENT_SEQUENCE_RENDERED_H
+#define ANEMONE_TYPES_INSTRUMENT_SEQUENCE_RENDERED_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include "anemone/types/instrument/page/page.hpp"
+#include "anemone/types/instrument/step/step.hpp"
+
+
+/// @brief bitmask of the rendered steps on a page, the nth bit is the nth step.
+typedef std::uint64_t page_mask_t;
+
+/// @brief index of the steps which are rendered (i.e. have events) on each page.
+///
+/// @details
+/// each page is a fixed-width bitmask, so setting, testing and clearing a step are a
+/// single bit operation and a whole page can be rendered from one mask. summaries of
+/// a page or a part are popcounts over the masks. the masks are 64 bits wide, which
+/// bounds the size of the steps section (see `GridLayout::Sequencer`).
+///
+/// masks are allocated `chunk_pages` at a time, once a step is rendered on one of
+/// their pages, and never move or go away afterwards. every part has a fixed table of
+/// chunk pointers (`max_pages / chunk_pages` of them, i.e. 512 bytes), so a long part
+/// (e.g. 4096 steps, i.e. 256 pages of 16 steps) takes 512 bytes + 2KiB of masks, while
+/// a short one takes 512 + 128 bytes.
+///
+/// the part is edited by one thread at a time (see `Sequence`), while the ui & tick
+/// threads read it. chunks are published atomically, and the masks are atomic too,
+/// so readers never see a page being allocated or half written.
+///
+/// @remark steps on pages past `max_pages` are ignored.
+///
+class RenderedSteps {
+public:
+  /// @brief the largest page (i.e. steps section) supported.
+  static constexpr unsigned int max_page_size = 64;
+
+  /// @brief the number of pages a part can have.
+  static constexpr unsigned int max_pages = 1024;
+
+  /// @brief the number of pages allocated at once.
+  static constexpr unsigned int chunk_pages = 16;
+
+  RenderedSteps() = default;
+  RenderedSteps(const RenderedSteps&) = delete;
+  RenderedSteps& operator=(const RenderedSteps&) = delete;
+
+  ~RenderedSteps();
+
+  /// @brief marks a step as rendered.
+  void set(paged_step_idx_t step) {
+    if (step.page >= max_pages) return;
+
+    auto chunk = chunks[step.page / chunk_pages].load(std::memory_order_acquire);
+    if (chunk == nullptr) chunk = allocate(step.page / chunk_pages);
+
+    (*chunk)[step.page % chunk_pages].fetch_or(bit(step.step), std::memory_order_relaxed);
+  };
+
+  /// @brief marks a step as not rendered.
+  void clear(paged_step_idx_t step) {
+    auto mask = mask_of(step.page);
+    if (mask != nullptr) mask->fetch_and(~bit(step.step), std::memory_order_relaxed);
+  };
+
+  /// @brief whether a step is rendered.
+  bool test(paged_step_idx_t step) const {
+    return (page(step.page) & bit(step.step)) != 0;
+  };
+
+  /// @brief the rendered steps of a page.
+  page_mask_t page(page_idx_t page) const {
+    auto mask = mask_of(page);
+    return mask != nullptr ? mask->load(std::memory_order_relaxed) : 0;
+  };
+
+  /// @brief the number of rendered steps on a page.
+  unsigned int count(page_idx_t) const;
+
+  /// @brief the number of rendered steps in the part.
+  unsigned int count() const;
+
+  /// @brief the pages with rendered steps, 64 of them from the provided page on. the
+  /// nth bit is the page `first + n`.
+  std::uint64_t occupied(page_idx_t first = 0) const;
+
+  /// @brief the memory held by the index, in bytes.
+  std::size_t bytes() const;
+
+private:
+  typedef std::array<std::atomic<page_mask_t>, chunk_pages> chunk_t;
+
+  std::array<std::atomic<chunk_t*>, max_pages / chunk_pages> chunks = {};
+
+  /// @brief allocates & publishes a chunk of pages (by the writer only).
+  chunk_t* allocate(unsigned int);
+
+  std::atomic<page_mask_t>* mask_of(page_idx_t page) const {
+    if (page >= max_pages) return nullptr;
+
+    auto chunk = chunks[page / chunk_pages].load(std::memory_order_acquire);
+    return chunk != nullptr ? &(*chunk)[page % chunk_pages] : nullptr;
+  };
+
+  static page_mask_t bit(page_relative_step_idx_t step) {
+    return step < max_page_size ? page_mask_t(1) << step : 0;
+  };
+};
+
+#endif
@@ -1,40 +1,148 @@
+#include <algorithm>
+
 #include <spdlog/spdlog.h>
 
 #include "anemone/types/instrument/sequence/sequence.hpp"
 
+
+namespace {
+  bool compiled_before(const compiled_step_event_t& event, granular_step_idx_t step) {
+    return event.step < step;
+  }
+
+  bool compiled_after(granular_step_idx_t step, const compiled_step_event_t& event) {
+    return step < event.step;
+  }
+
+  void compile(const step_event_t& event, granular_step_idx_t step, layer_idx_t layer, schedule_t::chunk_t& results) {
+    if (event.data.empty()) return;
+
+    results.push_back({ .step     = step,
+                        .id       = event.id,
+                        .data     = event.data,
+                        .layer    = layer,
+                        .duration = event.duration,
+      });
+  }
+
+  /// @brief the last version given to a schedule.
+  std::atomic<unsigned long> versions = { 0 };
+}
+
+Sequence::Sequence()
+  : compiled(new schedule_t{ .chunks = {}, .version = ++versions })
+{}
+
+Sequence::~Sequence() {
+  delete compiled.load(std::memory_order_relaxed);
+  for (auto schedule : retired) delete schedule;
+}
+
 // TODO make this so it can handle on/off/nrpn/(cc??)
 void Sequence::add_midi_note_events_at(paged_step_idx_t paged_step,
                                        granular_step_idx_t granular_step,
                                        sequence_layer_t sequence_layer)
 {
   // add to rendered steps
-  try {
-    rendered_steps.at(paged_step.page).insert(paged_step.step);  
-  } catch (std::out_of_range &error) {
-    // no rendered steps previously existed on that page.
-    rendered_steps[paged_step.page] = { paged_step.step };
-  }
+  rendered_steps.set(paged_step);
 
-  // broadcast that a rendered step was added
-  added_steps.get_subscriber().on_next(paged_step);
-
-  // add actual notes to sequence
+  // add actual notes to sequence. their note offs are played back according to the
+  // duration of each note.
   midi_on[granular_step] = sequence_layer;
 
-  // HACKY add note off TODO MAKE BETTER
-  sequence_layer_t off_layer;
-  for (auto itr : sequence_layer) {
-    auto off_data = midi_note_off_from_on(itr.second.data);
-    step_event_t off_step_event(step_event_protocol_t::Midi, off_data);
-    off_layer.insert_or_assign(off_step_event.id, off_step_event);
-  }
-  midi_off[granular_step + PPQN::Max] = off_layer;
+  recompile({ granular_step });
+
+  // broadcast that a rendered step was added (once it can be played back).
+  added_steps.get_subscriber().on_next(paged_step);
 }
 
 void Sequence::remove_midi_note_events_at(paged_step_idx_t paged_step,
                                           granular_step_idx_t granular_step)
 {
-  
+  // remove from rendered steps
+  rendered_steps.clear(paged_step);
+
+  // remove the notes from the sequence
+  midi_on.erase(granular_step);
+
+  recompile({ granular_step });
+
+  // broadcast that a rendered step was removed
+  removed_steps.get_subscriber().on_next(paged_step);
+}
+
+schedule_guard_t Sequence::schedule() const {
+  // claim a hazard pointer.
+  auto snapshot = compiled.load(std::memory_order_seq_cst);
+  std::atomic<const schedule_t*>* hazard = nullptr;
+  while (hazard == nullptr) {
+    for (auto& h : hazards) {
+      const schedule_t* none = nullptr;
+      if (h.compare_exchange_strong(none, snapshot, std::memory_order_seq_cst)) {
+        hazard = &h;
+        break;
+      }
+    }
+  }
+
+  // announce the schedule about to be read, and make sure it wasn't swapped out meanwhile.
+  while (true) {
+    auto current = compiled.load(std::memory_order_seq_cst);
+    if (current == snapshot) break;
+
+    snapshot = current;
+    hazard->store(snapshot, std::memory_order_seq_cst);
+  }
+
+  return schedule_guard_t(snapshot, hazard);
+}
+
+schedule_range_t Sequence::events_at(const schedule_t& schedule, granular_step_idx_t step) {
+  auto chunk = schedule.chunk_of(step);
+  auto first = std::lower_bound(chunk.begin(), chunk.end(), step, compiled_before);
+  auto last  = std::upper_bound(first, chunk.end(), step, compiled_after);
+
+  return { .first = first, .last = last };
+}
+
+void Sequence::recompile(std::initializer_list<granular_step_idx_t> steps) {
+  auto current = compiled.load(std::memory_order_relaxed);
+  auto next    = new schedule_t{ .chunks = current->chunks, .version = ++versions };
+
+  for (auto step : steps) {
+    auto idx = step / schedule_t::chunk_span;
+    if (idx >= next->chunks.size()) next->chunks.resize(idx + 1);
+
+    // copy the step's chunk, and splice the step's freshly compiled events in place of
+    // its old ones, keeping the same order as `events_at`.
+    auto chunk = next->chunks[idx] != nullptr
+      ? std::make_shared<schedule_t::chunk_t>(*next->chunks[idx])
+      : std::make_shared<schedule_t::chunk_t>();
+
+    auto first = std::lower_bound(chunk->begin(), chunk->end(), step, compiled_before);
+    auto last  = std::upper_bound(first, chunk->end(), step, compiled_after);
+
+    schedule_t::chunk_t events;
+    for (auto& event : events_at(step)) compile(event, step, layers.index(event.id), events);
+
+    first = chunk->erase(first, last);
+    chunk->insert(first, events.begin(), events.end());
+
+    next->chunks[idx] = std::move(chunk);
+  }
+
+  // swap the new schedule in, and reclaim the swapped out ones no reader holds anymore.
+  retired.push_back(compiled.exchange(next, std::memory_order_seq_cst));
+  retired.erase(std::remove_if(retired.begin(), retired.end(),
+                               [this] (const schedule_t* schedule) {
+                                 for (auto& hazard : hazards) {
+                                   if (hazard.load(std::memory_order_seq_cst) == schedule) return false;
+                                 }
+
+                                 delete schedule;
+                                 return true;
+                               }),
+                retired.end());
 }
 
 std::vector<step_event_t> Sequence::get_events_at(granular_step_idx_t step) {
@@ -47,41 +155,55 @@ std::vector<step_event_t> Sequence::get_events_at(granular_step_idx_t step,
 {
   std::vector<step_event_t> step_events;
 
-  collect_events_at(midi_on, step, layers, step_events);
-  collect_events_at(midi_off, step, layers, step_events);
-  collect_events_at(midi_cc, step, layers, step_events);
-  collect_events_at(midi_nrpn, step, layers, step_events);
+  for (auto& event : events_at(step, layers)) {
+    step_events.push_back(event);
+  }
 
   return step_events;
 }
 
-void Sequence::collect_events_at(sequence_t sequence,
-                                 granular_step_idx_t step,
-                                 const std::vector<step_event_id_t> &selected_layers,
-                                 std::vector<step_event_t>& results)
+step_events_view_t Sequence::events_at(granular_step_idx_t step,
+                                       const std::vector<step_event_id_t>& selected) const
 {
-  try {
-    auto layers_at_step = sequence.at(step);
+  // no layers selects all of them.
+  return events_at(step, selected.empty() ? ALL_LAYERS : layers.mask(selected));
+}
 
-    // we are collecting all layers
-    if (selected_layers.size() == 0) {
-      for (auto itr : layers_at_step) {
-        results.push_back(itr.second);
-      }
-      // return early.
-      return;
-    }
+step_events_view_t Sequence::events_at(granular_step_idx_t step, layer_mask_t selected) const {
+  auto layers_at = [step] (const sequence_t& sequence) -> const sequence_layer_t* {
+                     auto itr = sequence.find(step);
+                     return itr == sequence.end() ? nullptr : &itr->second;
+                   };
 
-    // we are collecting specific layers
-    for (auto layer_id : selected_layers) {
-      try {
-        results.push_back(layers_at_step.at(layer_id));
-      } catch (std::out_of_range &error) {
-        // no such layer at this step...carry on.
-      }
-    }
+  return step_events_view_t({ layers_at(midi_on),
+                              layers_at(midi_cc),
+                              layers_at(midi_nrpn) },
+                            { .index = &layers, .mask = selected });
+}
 
-  } catch (std::out_of_range &error) {
-    // no events at this step...carry on.
+schedule_range_t schedule_cursor_t::advance(const schedule_t& schedule, granular_step_idx_t to) {
+  auto events = schedule.chunk_of(to);
+
+  if (version != schedule.version || to < step || to / schedule_t::chunk_span != chunk) {
+    // the schedule was edited, we wrapped around or moved on to another chunk. find
+    // our place again.
+    version = schedule.version;
+    chunk   = to / schedule_t::chunk_span;
+    next    = std::lower_bound(events.begin(), events.end(), to, compiled_before) - events.begin();
   }
+
+  step = to;
+
+  auto size = static_cast<std::size_t>(events.end() - events.begin());
+
+  // skip the events of steps we jumped over.
+  while (next < size && events.first[next].step < to) next++;
+
+  schedule_range_t range = { .first = events.first + next, .last = events.first + next };
+  while (next < size && events.first[next].step == to) {
+    next++;
+    range.last++;
+  }
+
+  return range;
 }
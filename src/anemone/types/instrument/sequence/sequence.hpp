@@ -11,14 +11,20 @@
 
 #include <map>
 #include <set>
+#include <array>
+#include <atomic>
 #include <memory>
+#include <algorithm>
 #include <vector>
+#include <initializer_list>
 
 #include "anemone/rx.hpp"
 
 #include "anemone/types/instrument/page/page.hpp"
 #include "anemone/types/instrument/step/step.hpp"
 #include "anemone/types/instrument/step/event.hpp"
+#include "anemone/types/instrument/sequence/layers.hpp"
+#include "anemone/types/instrument/sequence/rendered.hpp"
 
 
 /// @brief a sequence layer type.
@@ -39,21 +45,260 @@ typedef std::map<step_event_id_t, step_event_t> sequence_layer_t;
 /// @brief type alias for sequence storing data structure.
 typedef std::map<step_idx_t, sequence_layer_t> sequence_t;
 
+/// @brief a step event compiled for playback.
+///
+/// @details
+/// compiled events have a fixed size so that a part's whole schedule lives in one
+/// contiguous array.
+///
+struct compiled_step_event_t {
+  granular_step_idx_t step;
+  step_event_id_t     id;
+  midi_data_t         data;
+
+  /// @brief the dense index of the event's layer (see `LayerIndex`).
+  layer_idx_t         layer;
+
+  /// @brief how long a note is held for, in granular steps.
+  granular_step_idx_t duration;
+
+  /// @brief whether this is a note on, to be followed by a note off.
+  bool is_note_on() const {
+    return data.size() == 3 && (data[0] & 0xF0) == 0x90 && data[2] > 0;
+  };
+};
+
+/// @brief a non-owning range of the compiled events at a step of a schedule.
+struct schedule_range_t {
+  const compiled_step_event_t* first;
+  const compiled_step_event_t* last;
+
+  const compiled_step_event_t* begin() const { return first; };
+  const compiled_step_event_t* end() const { return last; };
+  bool empty() const { return first == last; };
+};
+
+/// @brief a compiled playback schedule, sorted by granular step.
+///
+/// @details
+/// the schedule is split in chunks of `chunk_span` granular steps, so that an edit
+/// only copies the chunk of the edited step (and the table of chunks), while the
+/// other chunks are shared with the previous schedule.
+///
+struct schedule_t {
+  /// @brief the granular steps a chunk spans (i.e. 64 steps).
+  static constexpr granular_step_idx_t chunk_span = 64 * PPQN::Max;
+
+  /// @brief the compiled events of a chunk, sorted by granular step.
+  typedef std::vector<compiled_step_event_t> chunk_t;
+
+  /// @brief the chunks, the nth spans `[n * chunk_span, (n + 1) * chunk_span)`.
+  std::vector< std::shared_ptr<const chunk_t> > chunks;
+
+  /// @brief a number identifying the schedule, unique among all schedules.
+  unsigned long version = 0;
+
+  /// @brief the compiled events of the chunk a step is in.
+  schedule_range_t chunk_of(granular_step_idx_t step) const {
+    auto idx = step / chunk_span;
+    if (idx >= chunks.size() || chunks[idx] == nullptr) return { .first = nullptr, .last = nullptr };
+
+    return { .first = chunks[idx]->data(), .last = chunks[idx]->data() + chunks[idx]->size() };
+  };
+
+  /// @brief the number of compiled events.
+  std::size_t size() const {
+    std::size_t events = 0;
+    for (auto& chunk : chunks) events += chunk != nullptr ? chunk->size() : 0;
+
+    return events;
+  };
+};
+
+/// @brief a published schedule, which can't be reclaimed while it is held.
+///
+/// @details
+/// holding it announces the schedule through one of the sequence's hazard pointers
+/// (see `Sequence::schedule`), and releasing it clears the hazard pointer.
+///
+class schedule_guard_t {
+public:
+  schedule_guard_t(const schedule_t* schedule, std::atomic<const schedule_t*>* hazard)
+    : schedule(schedule),
+      hazard(hazard)
+  {};
+
+  schedule_guard_t(schedule_guard_t&& other)
+    : schedule(other.schedule),
+      hazard(other.hazard)
+  {
+    other.hazard = nullptr;
+  };
+
+  schedule_guard_t(const schedule_guard_t&) = delete;
+  schedule_guard_t& operator=(const schedule_guard_t&) = delete;
+  schedule_guard_t& operator=(schedule_guard_t&&) = delete;
+
+  ~schedule_guard_t() {
+    if (hazard != nullptr) hazard->store(nullptr, std::memory_order_release);
+  };
+
+  const schedule_t& operator*() const { return *schedule; };
+  const schedule_t* operator->() const { return schedule; };
+
+private:
+  const schedule_t*               schedule;
+  std::atomic<const schedule_t*>* hazard;
+};
+
+/// @brief a playback cursor over a compiled schedule.
+///
+/// @details
+/// the cursor remembers where the next event in the schedule is, so that moving it
+/// forward to a step without any events is a single comparison. it re-seeks (with a
+/// binary search) only when the schedule is swapped by an edit, when the step moves
+/// backwards (i.e. the part wrapped around its last step) or into another chunk, or
+/// after a reset. steps which are jumped over (e.g. at a coarser ppqn) are skipped.
+///
+struct schedule_cursor_t {
+  /// @brief the version of the schedule the cursor is over (none if 0).
+  unsigned long version = 0;
+
+  /// @brief the chunk of the schedule the cursor is in.
+  std::size_t chunk = 0;
+
+  /// @brief the index of the next event in the chunk.
+  std::size_t next = 0;
+
+  /// @brief the step the cursor was last moved to.
+  granular_step_idx_t step = 0;
+
+  /// @brief moves the cursor to a step.
+  ///
+  /// @param schedule   the current schedule of the sequence.
+  /// @param step       the step to move to.
+  ///
+  /// @return the range of compiled events at the step.
+  ///
+  /// @remark a step's events are returned once, moving to the same step again
+  /// returns nothing.
+  ///
+  schedule_range_t advance(const schedule_t&, granular_step_idx_t);
+
+  /// @brief forgets where the cursor is, so it re-seeks on its next move.
+  void reset() { version = 0; };
+};
+
+/// @brief a selection of sequence layers.
+///
+/// @details
+/// the selection is a mask of the dense layers of a sequence, so it points to the
+/// sequence's layer index, which must outlive it.
+///
+struct layer_filter_t {
+  const LayerIndex* index = nullptr;
+  layer_mask_t      mask  = ALL_LAYERS;
+
+  /// @brief whether the provided layer is selected.
+  bool selects(step_event_id_t id) const {
+    return mask == ALL_LAYERS || (index != nullptr && (index->mask(id) & mask) != 0);
+  };
+};
+
+/// @brief a non-owning view of the step events of a sequence at a step.
+///
+/// @details
+/// the view walks the layers of the step in the on, cc and nrpn sequences (in
+/// that order) in place. it never copies or allocates, but is only valid until the
+/// sequence is next edited.
+///
+class step_events_view_t {
+public:
+  /// @brief the sequences the view walks.
+  static const std::size_t sequences = 3;
+
+  class iterator {
+  public:
+    iterator(const step_events_view_t* view, std::size_t sequence)
+      : view(view),
+        sequence(sequence)
+    {
+      enter();
+    };
+
+    const step_event_t& operator*() const { return current->second; };
+    const step_event_t* operator->() const { return &current->second; };
+
+    iterator& operator++() {
+      ++current;
+      settle();
+      return *this;
+    };
+
+    bool operator==(const iterator& rhs) const {
+      return sequence == rhs.sequence && (sequence == sequences || current == rhs.current);
+    };
+
+    bool operator!=(const iterator& rhs) const { return !(*this == rhs); };
+
+  private:
+    const step_events_view_t*          view;
+    std::size_t                        sequence;
+    sequence_layer_t::const_iterator   current;
+
+    /// @brief moves to the first layer of the current (or next non-empty) sequence.
+    void enter() {
+      while (sequence < sequences && view->layers[sequence] == nullptr) sequence++;
+      if (sequence == sequences) return;
+
+      current = view->layers[sequence]->begin();
+      settle();
+    };
+
+    /// @brief moves forward to the next selected layer, if not already on one.
+    void settle() {
+      while (current != view->layers[sequence]->end() && !view->filter.selects(current->first)) ++current;
+
+      if (current == view->layers[sequence]->end()) {
+        sequence++;
+        enter();
+      }
+    };
+  };
+
+  step_events_view_t(std::array<const sequence_layer_t*, sequences> layers, layer_filter_t filter)
+    : layers(layers),
+      filter(filter)
+  {};
+
+  iterator begin() const { return iterator(this, 0); };
+  iterator end() const { return iterator(this, sequences); };
+  bool empty() const { return begin() == end(); };
+
+private:
+  /// @brief the layers at the step in each sequence, if there are any.
+  std::array<const sequence_layer_t*, sequences> layers;
+
+  layer_filter_t filter;
+};
+
 /// @brief data structure for storing rendered steps
 ///
 /// @todo eventually this must be able to handle layering!
-typedef std::map<page_idx_t, std::set<page_relative_step_idx_t> > rendered_steps_t;
+typedef RenderedSteps rendered_steps_t;
 
 
 /// @brief Sequence class for representing a sequence of midi events.
 class Sequence {
 public:
   sequence_t       midi_on;
-  sequence_t       midi_off;
   sequence_t       midi_cc;
   sequence_t       midi_nrpn;
   rendered_steps_t rendered_steps;
 
+  /// @brief the dense index of the layers used by the sequence.
+  LayerIndex       layers;
+
   /// @brief added_steps is an observable which sends updates to subscribers who
   /// want to know the most recently added steps.
   rx::subject<paged_step_idx_t> added_steps;
@@ -102,11 +347,79 @@ public:
   ///
   std::vector<step_event_t> get_events_at(granular_step_idx_t, const std::vector<step_event_id_t>&);
 
+  /// @brief view the step events at the provided step, without copying them.
+  ///
+  /// @param step     a granular step index.
+  /// @param layers   a mask of the (dense) layers to view, all of them by default.
+  ///
+  /// @return a view of the step events.
+  ///
+  step_events_view_t events_at(granular_step_idx_t, layer_mask_t = ALL_LAYERS) const;
+
+  /// @brief view the step events at the provided step for the provided layer ids.
+  ///
+  /// @param step     a granular step index.
+  /// @param layers   the layer ids to view, all of them if there are none.
+  ///
+  /// @return a view of the step events.
+  ///
+  step_events_view_t events_at(granular_step_idx_t, const std::vector<step_event_id_t>&) const;
+
+  /// @brief the number of schedules which may be held at once.
+  static constexpr std::size_t max_readers = 4;
+
+  Sequence();
+  ~Sequence();
+
+  Sequence(const Sequence&) = delete;
+  Sequence& operator=(const Sequence&) = delete;
+
+  /// @brief get the compiled playback schedule.
+  ///
+  /// @details
+  /// the schedule is never modified once published, edits compile a new schedule and
+  /// swap it in. so a reader (i.e. the tick thread) can hold on to the schedule it got
+  /// for as long as it holds the guard, and sees edits on its next call. getting it
+  /// never locks: the reader announces the schedule it reads through a hazard pointer,
+  /// and the writer only reclaims the schedules it swapped out once no reader holds
+  /// them (à la `HighFrequencyState`).
+  ///
+  /// @remark at most `max_readers` guards may be held at once (the tick thread holds
+  /// one at a time).
+  ///
+  /// @return the compiled schedule.
+  ///
+  schedule_guard_t schedule() const;
+
+  /// @brief get the compiled events at the provided step of a schedule.
+  ///
+  /// @param schedule   a compiled schedule.
+  /// @param step       a granular step index.
+  ///
+  /// @return the range of compiled events at the step, in schedule order.
+  ///
+  static schedule_range_t events_at(const schedule_t&, granular_step_idx_t);
+
 private:
-  void collect_events_at(sequence_t,
-                         granular_step_idx_t,
-                         const std::vector<step_event_id_t>&,
-                         std::vector<step_event_t>&);
+  /// @brief the published playback schedule.
+  std::atomic<const schedule_t*> compiled;
+
+  /// @brief the schedules held by readers, if any.
+  mutable std::array<std::atomic<const schedule_t*>, max_readers> hazards = {};
+
+  /// @brief the schedules swapped out but still held by a reader (writer only).
+  std::vector<const schedule_t*> retired;
+
+  /// @brief recompiles the provided steps of the schedule and publishes the result.
+  ///
+  /// @details only the chunks of the provided steps are copied, the others are shared
+  /// with the previous schedule.
+  ///
+  /// @remark edits are expected to be made from one thread at a time.
+  ///
+  /// @param steps   the granular steps which were edited.
+  ///
+  void recompile(std::initializer_list<granular_step_idx_t>);
 };
 
 #endif
@@ -13,11 +13,9 @@
 #include <vector>
 
 #include "anemone/types/io/midi/data.hpp"
+#include "anemone/types/instrument/step/step.hpp"
 
 
-// forward declaration. see anemone/types/midi.hpp
-typedef std::vector<unsigned char> midi_data_t;
-
 /// @brief Step event protocol.
 enum class step_event_protocol_t {
                                   /// MIDI protocol.
@@ -35,6 +33,8 @@ enum class step_event_protocol_t {
 ///   `status byte` is the command + channel
 ///   `data 1 byte` is a 0-127 value (such as pitch)
 ///
+/// so that each (status, channel, note/control) has its own id.
+///
 typedef unsigned short step_event_id_t;
 
 /// @brief Step event type.
@@ -43,15 +43,21 @@ struct step_event_t {
   step_event_id_t       id;
   midi_data_t           data;
 
+  /// @brief how long a note is held for, in granular steps (i.e. `PPQN::Max` is
+  /// one step, whatever the ppqn).
+  granular_step_idx_t   duration;
+
   /// @brief step_event_t constructor, responsible for creating the step_event_id_t.
-  step_event_t(step_event_protocol_t p, midi_data_t d) {
+  step_event_t(step_event_protocol_t p, midi_data_t d, granular_step_idx_t duration = PPQN::Max)
+    : duration(duration)
+  {
     protocol = p;
     data = d;
     
     switch (protocol) {
     case step_event_protocol_t::Midi:
     default: // TODO remove this default!
-      id = (step_event_id_t)(((0x0000 | data[0]) << 4) & data[1]);
+      id = (step_event_id_t)((data[0] << 8) | data[1]);
     }
   }
   
@@ -60,11 +66,15 @@ struct step_event_t {
   };
 
   /// @brief create a midi note on step event.
-  static step_event_t make_midi_note_on(std::string note, unsigned int channel, unsigned int velocity) {
+  static step_event_t make_midi_note_on(std::string note,
+                                        unsigned int channel,
+                                        unsigned int velocity,
+                                        granular_step_idx_t duration = PPQN::Max)
+  {
     auto protocol = step_event_protocol_t::Midi;
     auto data     = midi_note_on(note, channel, velocity);
 
-    return step_event_t(protocol, data);
+    return step_event_t(protocol, data, duration);
   }
 };
 
@@ -9,8 +9,19 @@
 #ifndef ANEMONE_TYPES_IO_CLOCK_TICK_H
 #define ANEMONE_TYPES_IO_CLOCK_TICK_H
 
+#include <chrono>
+
   
 /// @brief clock tick.
-struct tick_t {};
+struct tick_t {
+  /// @brief index of this tick since the clock started.
+  long index = 0;
+
+  /// @brief when this tick is due.
+  std::chrono::steady_clock::time_point time = {};
+
+  /// @brief the current tick period.
+  std::chrono::nanoseconds period = {};
+};
 
 #endif
@@ -0,0 +1,23 @@
+/**
+ * @file   types/io/clock/transport.hpp
+ * @brief  Clock Transport Type
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef ANEMONE_TYPES_IO_CLOCK_TRANSPORT_H
+#define ANEMONE_TYPES_IO_CLOCK_TRANSPORT_H
+
+
+/// @brief clock transport changes.
+enum class ClockTransport {
+                           /// the clock started from the beginning of the song.
+                           Start,
+                           /// the clock stopped.
+                           Stop,
+                           /// the clock continued from where it stopped.
+                           Continue,
+};
+
+#endif
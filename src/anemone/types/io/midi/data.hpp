@@ -10,11 +10,67 @@
 #define ANEMONE_TYPES_IO_MIDI_DATA_H
 
 #include <string>
-#include <vector>
+#include <cstddef>
+#include <string_view>
+#include <initializer_list>
 
 
 /// @brief midi data type.
-typedef std::vector<unsigned char> midi_data_t;
+///
+/// @details
+/// channel voice, system common and system real time messages are at most three bytes
+/// long, so they are kept inline in a small value type which is copied around without
+/// ever allocating. longer messages (i.e. sysex) don't fit and take a separate path,
+/// see `midi_sysex_t`.
+///
+/// @remark bytes past the third are dropped.
+///
+class midi_data_t {
+public:
+  /// @brief the longest message held.
+  static constexpr std::size_t capacity = 3;
+
+  constexpr midi_data_t() = default;
+
+  constexpr midi_data_t(std::initializer_list<unsigned char> bytes) {
+    for (auto byte : bytes) push_back(byte);
+  };
+
+  template <typename Iterator>
+  midi_data_t(Iterator first, Iterator last) {
+    for (; first != last; ++first) push_back(*first);
+  };
+
+  constexpr std::size_t size() const { return length; };
+  constexpr bool empty() const { return length == 0; };
+
+  constexpr unsigned char& operator[](std::size_t i) { return bytes[i]; };
+  constexpr const unsigned char& operator[](std::size_t i) const { return bytes[i]; };
+
+  unsigned char* data() { return bytes; };
+  const unsigned char* data() const { return bytes; };
+
+  const unsigned char* begin() const { return bytes; };
+  const unsigned char* end() const { return bytes + length; };
+
+  constexpr void push_back(unsigned char byte) {
+    if (length < capacity) bytes[length++] = byte;
+  };
+
+  constexpr bool operator==(const midi_data_t& rhs) const {
+    if (length != rhs.length) return false;
+    for (std::size_t i = 0; i < length; i++) {
+      if (bytes[i] != rhs.bytes[i]) return false;
+    }
+    return true;
+  };
+
+  constexpr bool operator!=(const midi_data_t& rhs) const { return !(*this == rhs); };
+
+private:
+  unsigned char bytes[capacity] = { 0, 0, 0 };
+  unsigned char length          = 0;
+};
 
 /// @brief midi note type definition.
 typedef unsigned int midi_note_number_t;
@@ -25,14 +81,87 @@ typedef std::string midi_spn_t;
 /// @brief midi channel type.
 typedef unsigned int midi_channel_t;
 
+/// @brief midi system messages used for synchronization.
+///
+/// @remark timing clock messages are sent 24 times per quarter note. the song
+/// position pointer is expressed in midi beats (sixteenth notes, i.e. 6 clocks).
+enum class MidiSync : unsigned char {
+                                     SongPosition = 0xF2,
+                                     TimingClock  = 0xF8,
+                                     Start        = 0xFA,
+                                     Continue     = 0xFB,
+                                     Stop         = 0xFC,
+};
+
+/// @brief number of midi timing clock messages per quarter note.
+const unsigned int MIDI_CLOCK_PPQN = 24;
+
+/// @brief number of midi timing clock messages per midi beat (sixteenth note).
+const unsigned int MIDI_CLOCKS_PER_MIDI_BEAT = 6;
+
+/// @brief semitones above c of each note letter, from 'a' to 'g'.
+constexpr int SPN_SEMITONES[] = { 9, 11, 0, 2, 4, 5, 7 };
+
 /// @brief translate 'scientific pitch notation' to note number.
-midi_note_number_t spn_to_num(midi_spn_t spn);
+///
+/// @remark this is constexpr, so notes written in the code (e.g. `spn_to_num("c4")`)
+/// are translated at compile time.
+///
+constexpr midi_note_number_t spn_to_num(std::string_view spn) {
+  if (spn.empty()) return 0;
+
+  // note letter, case insensitive.
+  char letter = spn[0] >= 'A' && spn[0] <= 'G' ? spn[0] - 'A' + 'a' : spn[0];
+  int note    = letter >= 'a' && letter <= 'g' ? SPN_SEMITONES[letter - 'a'] : 0;
+
+  std::size_t i = 1;
+
+  // detect sharps/flats, and negative octave
+  if (i < spn.size() && spn[i] == 'b') {
+    note--;
+    i++;
+  } else if (i < spn.size() && spn[i] == '#') {
+    note++;
+    i++;
+  }
+
+  int octave_sign = 1;
+  if (i < spn.size() && spn[i] == '-') {
+    // this must be octave -1
+    octave_sign = -1;
+    i++;
+  }
+
+  // parse octave
+  // Note: we are parsing negative octaves here... in the official
+  // midi spec, there is a -1 octave.
+  // officially C0 has the midi note number 12?
+  int octave = 0;
+  for (; i < spn.size() && spn[i] >= '0' && spn[i] <= '9'; i++) {
+    octave = (octave * 10) + (spn[i] - '0');
+  }
+  octave *= octave_sign;
+
+  // sharps/flats may cross into the next/previous octave (e.g. 'cb4' is 'b3'), which
+  // the note number takes care of.
+  return (midi_note_number_t)(((octave + 1) * 12) + note);
+}
 
 /// @brief create a midi on note given an spn note.
-midi_data_t midi_note_on(midi_spn_t note, midi_channel_t channel, unsigned int velocity);
+midi_data_t midi_note_on(std::string_view note, midi_channel_t channel, unsigned int velocity);
+
+/// @brief create a midi on note given a note number.
+constexpr midi_data_t midi_note_on(midi_note_number_t note, midi_channel_t channel, unsigned int velocity) {
+  return { (unsigned char)(143 + channel), (unsigned char)note, (unsigned char)velocity };
+}
 
 /// @brief create a midi off note given an spn note.
-midi_data_t midi_note_off(midi_spn_t note, midi_channel_t channel);
+midi_data_t midi_note_off(std::string_view note, midi_channel_t channel);
+
+/// @brief create a midi off note given a note number.
+constexpr midi_data_t midi_note_off(midi_note_number_t note, midi_channel_t channel) {
+  return { (unsigned char)(127 + channel), (unsigned char)note, 0 };
+}
 
 /// @brief create a midi off note from midi on note data.
 midi_data_t midi_note_off_from_on(midi_data_t data);
@@ -40,13 +169,25 @@ midi_data_t midi_note_off_from_on(midi_data_t data);
 /// @brief create a midi cc message.
 midi_data_t make_cc_message(midi_channel_t channel, unsigned int control, unsigned int value);
 
+/// @brief create a midi synchronization message (other than a song position pointer).
+midi_data_t make_sync_message(MidiSync);
+
+/// @brief create a song position pointer message given a position in midi beats.
+midi_data_t make_song_position_message(unsigned int position);
+
 /// @brief determines if a midi message is a note on message.
-bool is_midi_on_note_message(midi_data_t);
+bool is_midi_on_note_message(const midi_data_t&);
 
 /// @brief determines if a midi message is a note off message.
-bool is_midi_off_note_message(midi_data_t);
+bool is_midi_off_note_message(const midi_data_t&);
 
 /// @brief determines if a midi message is a cc message.
-bool is_midi_cc_message(midi_data_t);
+bool is_midi_cc_message(const midi_data_t&);
+
+/// @brief determines if a midi message is a synchronization message (see `MidiSync`).
+bool is_midi_sync_message(const midi_data_t&);
+
+/// @brief gets the song position (in midi beats) from a song position pointer message.
+unsigned int midi_song_position(const midi_data_t&);
 
 #endif
@@ -10,6 +10,8 @@
 #define ANEMONE_TYPES_IO_MIDI_EVENT_H
 
 
+#include <chrono>
+
 #include "anemone/types/io/midi/data.hpp"
 
 
@@ -18,6 +20,9 @@ public:
   std::string source;
   std::string destination;
   midi_data_t data;
+
+  /// @brief when the message was received by the input device (monotonic clock).
+  std::chrono::steady_clock::time_point timestamp = {};
 };
 
 
@@ -0,0 +1,79 @@
+/**
+ * @file   types/io/midi/sysex.hpp
+ * @brief  Midi System Exclusive Messages
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+
+#ifndef ANEMONE_TYPES_IO_MIDI_SYSEX_H
+#define ANEMONE_TYPES_IO_MIDI_SYSEX_H
+
+#include <vector>
+#include <cstddef>
+#include <initializer_list>
+
+
+/// @brief a non-owning view of a system exclusive message (including its 0xF0 & 0xF7
+/// framing bytes), see `SysexArena`.
+struct midi_sysex_t {
+  const unsigned char* bytes;
+  std::size_t          size;
+
+  const unsigned char* begin() const { return bytes; };
+  const unsigned char* end() const { return bytes + size; };
+  bool empty() const { return size == 0; };
+};
+
+/// @brief Arena of system exclusive messages.
+///
+/// @details
+/// sysex messages are arbitrarily long, so they don't fit in a `midi_data_t`. rather
+/// than allocating each one, they are copied into a buffer allocated once, handing out
+/// views of them. the buffer is used as a ring: once it is full, the oldest messages
+/// are overwritten, so a view is only valid until `capacity` more bytes are stored.
+/// this is plenty for messages which are emitted as soon as they are stored.
+///
+/// @remark the arena is not thread safe, it is meant to be owned by a single thread.
+///
+class SysexArena {
+public:
+  /// @param capacity   the size of the buffer, in bytes. this is the longest message
+  ///                   which can be stored.
+  SysexArena(std::size_t capacity = 4096)
+    : buffer(capacity)
+  {};
+
+  /// @brief stores a message, adding the 0xF0 & 0xF7 framing bytes.
+  ///
+  /// @param data   the bytes of the message (without framing bytes).
+  ///
+  /// @return a view of the message, empty if it is too long to be stored.
+  ///
+  midi_sysex_t store(std::initializer_list<unsigned char> data) {
+    return store(data.begin(), data.size());
+  };
+
+  midi_sysex_t store(const unsigned char* data, std::size_t size) {
+    auto framed = size + 2;
+    if (framed > buffer.size()) return { .bytes = nullptr, .size = 0 };
+
+    // wrap around rather than splitting a message.
+    if (head + framed > buffer.size()) head = 0;
+
+    auto bytes = buffer.data() + head;
+    bytes[0] = 0xF0;
+    for (std::size_t i = 0; i < size; i++) bytes[i + 1] = data[i];
+    bytes[framed - 1] = 0xF7;
+
+    head += framed;
+
+    return { .bytes = bytes, .size = framed };
+  };
+
+private:
+  std::vector<unsigned char> buffer;
+  std::size_t                head = 0;
+};
+
+#endif
@@ -34,6 +34,14 @@ void UIComponent::turn_on_leds(std::vector<grid_section_index_t> indices) {
   }
 }
 
+void UIComponent::turn_on_leds(page_mask_t mask) {
+  // visit the set bits only, lowest first.
+  while (mask != 0) {
+    turn_on_led(__builtin_ctzll(mask));
+    mask &= mask - 1;
+  }
+}
+
 void UIComponent::turn_off_led(grid_section_index_t index) {
   // removes animation and sets intensity to 0
   remove_animation(index, 0);
@@ -25,6 +25,7 @@ public:
 protected:
   void turn_on_led(grid_section_index_t index);
   void turn_on_leds(std::vector<grid_section_index_t> indices);
+  void turn_on_leds(page_mask_t mask);
   void turn_off_led(grid_section_index_t index);
   void set_led(grid_section_index_t index, unsigned int intensity);
   void set_leds(std::vector<grid_section_index_t> indices, unsigned int intensity);
@@ -40,6 +41,12 @@ protected:
   /// @brief clears the ui section to a tabula rasa
   void clear();
 
+  /// @brief the number of leds in the ui section.
+  unsigned int size() const { return section_size; };
+
+  /// @brief whether an index is within the ui section.
+  bool contains(grid_section_index_t index) const { return index < section_size; };
+
 private:
   LayoutName layout;
   GridSectionName section;
@@ -3,8 +3,13 @@
 #include "anemone/ui/page.hpp"
 
 
-PageUI::PageUI(LayoutName layout, GridSectionName section, std::shared_ptr<IO> io, std::shared_ptr<State> state)
-  : UIComponent(layout, section, io, state)
+PageUI::PageUI(LayoutName layout,
+               GridSectionName section,
+               std::shared_ptr<IO> io,
+               std::shared_ptr<State> state,
+               std::shared_ptr<UIThread> ui_thread)
+  : UIComponent(layout, section, io, state),
+    ui_thread(ui_thread)
 {
   auto rendered_part = state->instruments->rendered.get_observable()
     | rx::map([] (std::shared_ptr<Instrument> rendered_instrument) {
@@ -34,71 +39,132 @@ PageUI::PageUI(LayoutName layout, GridSectionName section, std::shared_ptr<IO> i
     | rx::switch_on_next()
     | rx::map([this] (page_idx_t last_page) {
                 // side-effects only map
+                this->ui_thread->post<&PageUI::render_last_page>(this, last_page);
 
-                clear();
-                
-                // fill pages up to last page.
-                std::vector<grid_section_index_t> indices;
-                for (auto i = 0; i <= last_page; i++) { indices.push_back(i); }
-                set_leds(indices, led_level.active_pages);
-                
                 return last_page;
               });
   
-  // page in playback observable
-  auto page_in_playback = rendered_part
-    | rx::map([] (std::shared_ptr<Part> rendered_part) {
-                return rendered_part->step.current.get_observable();
-              })
-    | rx::switch_on_next()  
-    | rx::map([state] (granular_step_idx_t granular_step) {
-                auto page_size = state->layouts->sequencer->steps->size();
-
-                return granular_to_paged_step(granular_step, page_size).page;
-              })
-    | rx::distinct_until_changed();
-  
+  // the page in playback is high frequency state, so it is observed directly (on the
+  // tick thread) rather than chained, and only the rendered part's is observed, when it
+  // shows on this section.
+  rendered_part
+    .subscribe([this] (std::shared_ptr<Part> rendered_part) {
+                 observe_page_in_playback_of(rendered_part);
+               });
 
   // page ui logic.
-  rendered_page.combine_latest(page_in_playback, last_page)
-    .subscribe([this] (std::tuple<page_idx_t, page_idx_t, page_idx_t> t) {
-                 auto rendered_page    = std::get<0>(t);
-                 auto page_in_playback = std::get<1>(t);
-                 auto last_page        = std::get<2>(t);
-
-                 // clear previous rendered page when current changes
-                 if (previous.rendered_page != rendered_page)
-                   set_led(previous.rendered_page,
-                           previous.rendered_page > last_page ?
-                           led_level.inactive_pages :
-                           led_level.active_pages);
-
-                 // clear previous playing page when current changes
-                 if (previous.page_in_playback != page_in_playback)
-                   set_led(previous.page_in_playback,
-                           previous.page_in_playback > last_page ?
-                           led_level.inactive_pages :
-                           led_level.active_pages);
-
-                 
-                 if (page_in_playback == rendered_page) {
-                   // if the playing page and rendered pages are overlapping, animate the led
-                   add_animation(led_level.animate.rendered_and_playing_overlapping, page_in_playback);
-                 } else {
-                   // if the current playing & rendered pages are nont the same, but the previous
-                   // playing & rendered pages *were* the same, remove the animation!
-                   if (previous.page_in_playback == previous.rendered_page)
-                     remove_animation(previous.page_in_playback, led_level.active_pages);
-                   
-                   // set the currently rendered page
-                   set_led(rendered_page, led_level.rendered_page);
-
-                   // set the currently playing page
-                   set_led(page_in_playback, led_level.playing_page);
+  rendered_page.combine_latest(last_page)
+    .subscribe([this] (std::tuple<page_idx_t, page_idx_t> t) {
+                 // the pages in playback past this section weren't told about, so catch up.
+                 if (playback.part) {
+                   auto page_in_playback = playback.part->page.in_playback.get();
+                   this->ui_thread->post<&PageUI::follow_page_in_playback>(this, playback_move(playback.generation, page_in_playback));
                  }
 
-                 // update previous pages.
-                 previous.rendered_page = rendered_page;
-                 previous.page_in_playback = page_in_playback;
+                 auto pages = std::uint64_t(std::get<1>(t)) << 32 | std::get<0>(t);
+                 this->ui_thread->post<&PageUI::render_pages>(this, pages);
                });
 }
+
+void PageUI::observe_page_in_playback_of(std::shared_ptr<Part> part) {
+  if (playback.part) playback.part->page.in_playback.unsubscribe(playback.subscription);
+
+  // the page in playback changes on the tick thread, which hands it over to the ui
+  // thread. the pages are tagged with the part's generation, so the pages of the
+  // previous part still in flight are dropped.
+  auto generation = ++playback.generation;
+  auto on_page    = [this, generation] (page_idx_t page_in_playback) {
+                      ui_thread->post<&PageUI::render_page_in_playback>(this, playback_move(generation, page_in_playback));
+                    };
+
+  playback.part         = part;
+  playback.subscription =
+    part->page.in_playback.subscribe(on_page, std::make_shared<PageOnSection>(size(), part->page.in_playback.get()));
+
+  ui_thread->post<&PageUI::switch_page_in_playback>(this, playback_move(generation, part->page.in_playback.get()));
+}
+
+void PageUI::switch_page_in_playback(std::uint64_t move) {
+  latest.generation = move >> 32;
+  render_page_in_playback(move);
+}
+
+void PageUI::render_page_in_playback(std::uint64_t move) {
+  if ((move >> 32) != latest.generation) return;
+
+  follow_page_in_playback(move);
+  render();
+}
+
+void PageUI::follow_page_in_playback(std::uint64_t move) {
+  if ((move >> 32) != latest.generation) return;
+
+  latest.page_in_playback = page_idx_t(move);
+}
+
+void PageUI::render_last_page(page_idx_t last_page) {
+  clear();
+
+  // fill pages up to last page (or the end of the section).
+  std::vector<grid_section_index_t> indices;
+  for (page_idx_t i = 0; i <= last_page && contains(i); i++) { indices.push_back(i); }
+  set_leds(indices, led_level.active_pages);
+}
+
+void PageUI::render_pages(std::uint64_t pages) {
+  latest.rendered_page = page_idx_t(pages);
+  latest.last_page     = page_idx_t(pages >> 32);
+  latest.ready         = true;
+
+  render();
+}
+
+void PageUI::render() {
+  // wait for the rendered & last pages.
+  if (!latest.ready) return;
+
+  auto rendered_page    = latest.rendered_page;
+  auto page_in_playback = latest.page_in_playback;
+  auto last_page        = latest.last_page;
+
+  // clear previous rendered page when current changes
+  if (previous.rendered_page != rendered_page)
+    set_page_led(previous.rendered_page,
+                 previous.rendered_page > last_page ?
+                 led_level.inactive_pages :
+                 led_level.active_pages);
+
+  // clear previous playing page when current changes
+  if (previous.page_in_playback != page_in_playback)
+    set_page_led(previous.page_in_playback,
+                 previous.page_in_playback > last_page ?
+                 led_level.inactive_pages :
+                 led_level.active_pages);
+
+  
+  if (page_in_playback == rendered_page) {
+    // if the playing page and rendered pages are overlapping, animate the led
+    if (contains(page_in_playback))
+      add_animation(led_level.animate.rendered_and_playing_overlapping, page_in_playback);
+  } else {
+    // if the current playing & rendered pages are nont the same, but the previous
+    // playing & rendered pages *were* the same, remove the animation!
+    if (previous.page_in_playback == previous.rendered_page && contains(previous.page_in_playback))
+      remove_animation(previous.page_in_playback, led_level.active_pages);
+    
+    // set the currently rendered page
+    set_page_led(rendered_page, led_level.rendered_page);
+
+    // set the currently playing page
+    set_page_led(page_in_playback, led_level.playing_page);
+  }
+
+  // update previous pages.
+  previous.rendered_page = rendered_page;
+  previous.page_in_playback = page_in_playback;
+}
+
+void PageUI::set_page_led(page_idx_t page, unsigned int intensity) {
+  // pages past the end of the section have no led.
+  if (contains(page)) set_led(page, intensity);
+}
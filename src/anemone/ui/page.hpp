@@ -9,18 +9,80 @@
 #define UI_PAGE_H
 
 #include <memory>
+#include <cstdint>
 
 #include "anemone/io.hpp"
 #include "anemone/types.hpp"
 #include "anemone/state.hpp"
 
+#include "anemone/ui/thread.hpp"
 #include "anemone/ui/component.hpp"
 
 
 class PageUI : public UIComponent {
 public:
-  PageUI(LayoutName, GridSectionName, std::shared_ptr<IO>, std::shared_ptr<State>);
+  PageUI(LayoutName, GridSectionName, std::shared_ptr<IO>, std::shared_ptr<State>, std::shared_ptr<UIThread>);
+
+  /// @brief lets through the pages in playback which show on a section of a given
+  /// size, and the first one past it (to turn off the page the playback left).
+  class PageOnSection : public SubscriptionPredicate<page_idx_t> {
+  public:
+    PageOnSection(unsigned int size, page_idx_t page_in_playback)
+      : size(size), previous(page_in_playback)
+    {};
+
+    bool operator()(page_idx_t page) override {
+      auto shown = page < size || previous < size;
+      previous   = page;
+
+      return shown;
+    };
+
+  private:
+    unsigned int size;
+
+    /// @brief the previous page in playback (set on the tick thread only).
+    page_idx_t previous;
+  };
+
 private:
+  /// @brief the thread everything is rendered on.
+  ///
+  /// @details the pages change on the state store's thread (and the page in playback
+  /// on the tick thread), which only post them to the ui thread. so only the ui thread
+  /// renders, and it needs no lock.
+  ///
+  std::shared_ptr<UIThread> ui_thread;
+
+  /// @brief the part whose page in playback is observed, only when it shows (store
+  /// thread).
+  struct {
+    std::shared_ptr<Part>                            part;
+    HighFrequencyState<page_idx_t>::subscription_t subscription = 0;
+
+    /// @brief bumped each time another part is observed, so the ui thread can tell
+    /// the pages of the previous part apart (and drop them).
+    std::uint32_t generation = 0;
+  } playback;
+
+  /// @brief packs a page in playback of the part observed in a generation.
+  static std::uint64_t playback_move(std::uint32_t generation, page_idx_t page) {
+    return std::uint64_t(generation) << 32 | page;
+  };
+
+  /// @brief the latest pages to render (ui thread).
+  struct {
+    page_idx_t rendered_page    = 0;
+    page_idx_t page_in_playback = 0;
+    page_idx_t last_page        = 1;
+
+    /// @brief the generation of the part whose page in playback is rendered.
+    std::uint32_t generation = 0;
+
+    /// @brief whether the (low frequency) pages have been received.
+    bool ready = false;
+  } latest;
+
   /// @brief values of previous pages
   struct {
     page_idx_t rendered_page    = 0;
@@ -42,6 +104,34 @@ private:
     } animate
     ;
   } led_level;
+
+  /// @brief observes the page in playback of a part, instead of the previous one
+  /// (store thread).
+  void observe_page_in_playback_of(std::shared_ptr<Part>);
+
+  /// @brief renders the page in playback of the part just observed (ui thread).
+  void switch_page_in_playback(std::uint64_t);
+
+  /// @brief renders the page in playback, unless its part is no longer observed (ui
+  /// thread).
+  void render_page_in_playback(std::uint64_t);
+
+  /// @brief moves the page in playback without rendering it, unless its part is no
+  /// longer observed (ui thread).
+  void follow_page_in_playback(std::uint64_t);
+
+  /// @brief renders the pages up to the last page (ui thread).
+  void render_last_page(page_idx_t);
+
+  /// @brief renders the rendered & last pages, packed in an integral (ui thread).
+  void render_pages(std::uint64_t);
+
+  /// @brief renders the pages from the latest values.
+  void render();
+
+  /// @brief sets the led of a page, if it has one (long parts have more pages than the
+  /// section has leds).
+  void set_page_led(page_idx_t, unsigned int);
 };
 
 #endif
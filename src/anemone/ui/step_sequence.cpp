@@ -3,9 +3,17 @@
 #include "anemone/ui/step_sequence.hpp"
 
 
-StepSequenceUI::StepSequenceUI(LayoutName layout, GridSectionName section, std::shared_ptr<IO> io, std::shared_ptr<State> state)
-  : UIComponent(layout, section, io, state)
+StepSequenceUI::StepSequenceUI(LayoutName layout,
+                               GridSectionName section,
+                               std::shared_ptr<IO> io,
+                               std::shared_ptr<State> state,
+                               std::shared_ptr<UIThread> ui_thread)
+  : UIComponent(layout, section, io, state),
+    page_size(state->layouts->sequencer->steps->size()),
+    ui_thread(ui_thread)
 {
+  cursor.on_rendered_page = std::make_shared<CursorOnPage>(page_size);
+
   auto rendered_part = state->instruments->rendered.get_observable()
     | rx::map([] (std::shared_ptr<Instrument> rendered_instrument) {
                 return rendered_instrument->status.part.under_edit.get_observable();
@@ -23,27 +31,9 @@ StepSequenceUI::StepSequenceUI(LayoutName layout, GridSectionName section, std::
                 auto rendered_instrument = state->instruments->rendered.get_value();
                 auto rendered_part = rendered_instrument->status.part.under_edit.get_value();
 
-                // since this is a new page, lets clear the page
-                if (rendered_page != previous.rendered_page)
-                  clear();
-
-                try {
-                  // collect all rendered steps for this page into a vector
-                  std::vector<grid_section_index_t> rendered_steps_vector;
-                  auto rendered_steps_set = rendered_part->sequence.rendered_steps.at(rendered_page);
-                  for (auto rendered_step : rendered_steps_set) {
-                    rendered_steps_vector.push_back(rendered_step);
-                  }
-
-                  // set internal rendered steps
-                  rendered_steps = rendered_steps_set;
-                  
-                  // now lets render all steps for this page.
-                  turn_on_leds(rendered_steps_vector);
-                } catch (std::out_of_range &error) {
-                  // there are no rendered steps on this page....carry on.
-                  rendered_steps = {};
-                }
+                // render all steps for this page (on the ui thread).
+                this->ui_thread->post<&StepSequenceUI::render_page>(this, rendered_page);
+                this->ui_thread->post<&StepSequenceUI::render_steps>(this, rendered_part->sequence.rendered_steps.page(rendered_page));
 
                 // return the stream of added rendered steps only for this page.
                 return rendered_part->sequence.added_steps.get_observable()
@@ -55,17 +45,14 @@ StepSequenceUI::StepSequenceUI(LayoutName layout, GridSectionName section, std::
                             });
               })
     | rx::switch_on_next();
- 
-  auto current_step = rendered_part
-    | rx::map([] (std::shared_ptr<Part> rendered_part) {
-                return rendered_part->step.current.get_observable();
-              })
-    | rx::switch_on_next()  
-    | rx::map([state] (granular_step_idx_t granular_step) {
-                auto page_size = state->layouts->sequencer->steps->size();
 
-                return granular_to_paged_step(granular_step, page_size);
-              });
+  // the cursor is high frequency state, so it is observed directly (on the tick thread)
+  // rather than chained, and only the rendered part's cursor is observed, when it is
+  // on the rendered page.
+  rendered_part
+    .subscribe([this] (std::shared_ptr<Part> rendered_part) {
+                 observe_cursor_of(rendered_part);
+               });
 
   auto last_step = rendered_part
     | rx::map([] (std::shared_ptr<Part> rendered_part) {
@@ -82,93 +69,173 @@ StepSequenceUI::StepSequenceUI(LayoutName layout, GridSectionName section, std::
   // render newly added steps to this page
   added_steps
     .subscribe([this] (page_relative_step_idx_t step) {
-                 rendered_steps.insert(step);
-
-                 turn_on_led(step);
+                 this->ui_thread->post<&StepSequenceUI::render_added_step>(this, step);
                });
   
-  rendered_page.combine_latest(current_step, show_last_step, last_step)
-    .subscribe([this, state] (std::tuple<page_idx_t, paged_step_idx_t, bool, paged_step_idx_t> p) {
-                 auto rendered_page      = std::get<0>(p);
-                 auto current_paged_step = std::get<1>(p);
-                 auto show_last_step     = std::get<2>(p);
-                 auto last_step          = std::get<3>(p);
-
-                 if (rendered_page == current_paged_step.page) {
-                   // when the rendered page is the same as the playing page (cursor is on this page).
-                   // we want to:
-                   // 1) turn on the step where the cursor is located
-                   //      - set the led brightness appropriately if the cursor step is on an active step
-                   // 2) turn off the previous cursor step if if is on this page
-                   //      - set the previous step led brighntess appropriately if it was on an active step
-                   
-                   auto current_step_active =
-                     rendered_page == current_paged_step.page &&
-                     rendered_steps.find(current_paged_step.step) != rendered_steps.end();
-                   auto previous_step_active =
-                     rendered_steps.find(current_paged_step.step - 1) != rendered_steps.end();
-
-                   // 1) turn the current cursor step on (to the appropriate led brightness)
-                   set_led(current_paged_step.step,
-                           current_step_active ? led_level.cursor_on_active_step : led_level.cursor);
-
-                   // 2) turn off the previous cursor step (to the appropriate led brightness)
-                   // when the current step is *not* the first step on the page
-                   // and the previous step is *not* an active (on) step, turn off the previous step.
-                   if (current_paged_step.step != 0) {
-                     set_led(current_paged_step.step - 1,
-                             previous_step_active ? led_level.active : led_level.inactive);
-                   }
+  rendered_page.combine_latest(show_last_step, last_step)
+    .subscribe([this] (std::tuple<page_idx_t, bool, paged_step_idx_t> p) {
+                 values_t values = { .rendered_page  = std::get<0>(p),
+                                     .show_last_step = std::get<1>(p),
+                                     .last_step      = std::get<2>(p),
+                 };
+
+                 // the cursor moves off the rendered page weren't told about, so catch up.
+                 cursor.on_rendered_page->follow(values.rendered_page, values.last_step.page);
+                 if (cursor.part) {
+                   auto step = cursor.part->step.current.get();
+                   this->ui_thread->post<&StepSequenceUI::follow_cursor>(this, cursor_move(cursor.generation, step));
                  }
 
-                 // turn off the last step on the rendered page if the cursor just moved to a new page.
-                 auto cursor_moved_to_next_page =
-                   (rendered_page != last_step.page && current_paged_step == paged_step_idx_t{ .page=rendered_page + 1, .step=0 }) ||
-                   (rendered_page == last_step.page && current_paged_step == paged_step_idx_t{ .page=0, .step=0 } );
-                 if (cursor_moved_to_next_page) {
-                   // get the last step on the rendered page
-                   auto last_step_on_rendered_page =
-                     rendered_page == last_step.page ?
-                     last_step.step : state->layouts->sequencer->steps->size() - 1;
-                     
-                   // is the final step on this page activated (on)?
-                   auto final_step_on_page_activated = rendered_steps.find(last_step_on_rendered_page) != rendered_steps.end();
-
-                   // if the previous step was the final step on the page, set the led to the appropraite brightness.
-                   // spdlog::warn("WAS FINAL STEP ON PAGE"); TODO: this fires a bunch of times, we can optimize so it only fires once
-                   set_led(last_step_on_rendered_page,
-                           final_step_on_page_activated ? led_level.active : led_level.inactive);                     
-                 }
-                 
-                 // if show_last_step has been activated, we want to add an animation for the last step.
-                 // since we are observing both rendered_page AND show_last_step (via combine_latest), they
-                 // will not change in lock-step, but one-by-one, meaninng that we will never have a situation
-                 // in which the previous rendered_page != current rendered_page AND previous show_last_step !=
-                 // current show_last_step.
-                 if (rendered_page == last_step.page &&
-                     show_last_step &&
-                     (previous.rendered_page != rendered_page || previous.show_last_step != show_last_step))
-                   add_animation(led_level.animate.last_step, last_step.step);
-
-                 // turn off the previous last step if it has changed!
-                 if (rendered_page == previous.last_step.page &&
-                     last_step != previous.last_step)
-                   remove_animation(previous.last_step.step, 0);
-                   
-                 // turn on new last step animation if it has changed!
-                 if (rendered_page == last_step.page &&
-                     last_step != previous.last_step)
-                   add_animation(led_level.animate.last_step, last_step.step);
-                 
-                 // remove last step animation if show_last_step has changed
-                 // set the led to the appropriate brightness if the last_step was active
-                 if (rendered_page == last_step.page && !show_last_step && previous.show_last_step)
-                   remove_animation(last_step.step, 0);
-                   
-
-                 // update previous values
-                 previous.rendered_page = rendered_page;
-                 previous.last_step = last_step;
-                 previous.show_last_step = show_last_step;
+                 this->ui_thread->post<&StepSequenceUI::render_values>(this, values.pack());
                });
 }
+
+void StepSequenceUI::observe_cursor_of(std::shared_ptr<Part> part) {
+  if (cursor.part) cursor.part->step.current.unsubscribe(cursor.subscription);
+
+  // the cursor moves on the tick thread, which hands them over to the ui thread. they
+  // are tagged with the part's generation, so the moves of the previous part still in
+  // flight are dropped.
+  auto generation = ++cursor.generation;
+  auto on_step    = [this, generation] (granular_step_idx_t granular_step) {
+                      ui_thread->post<&StepSequenceUI::render_cursor>(this, cursor_move(generation, granular_step));
+                    };
+
+  cursor.part         = part;
+  cursor.subscription = part->step.current.subscribe(on_step, cursor.on_rendered_page);
+
+  ui_thread->post<&StepSequenceUI::switch_cursor>(this, cursor_move(generation, part->step.current.get()));
+}
+
+void StepSequenceUI::switch_cursor(std::uint64_t move) {
+  latest.generation = move >> 32;
+  render_cursor(move);
+}
+
+void StepSequenceUI::render_cursor(std::uint64_t move) {
+  if ((move >> 32) != latest.generation) return;
+
+  follow_cursor(move);
+  render();
+}
+
+void StepSequenceUI::follow_cursor(std::uint64_t move) {
+  if ((move >> 32) != latest.generation) return;
+
+  latest.current_step = granular_to_paged_step(granular_step_idx_t(move), page_size);
+}
+
+void StepSequenceUI::render_page(page_idx_t rendered_page) {
+  // since this is a new page, lets clear the page
+  if (rendered_page != previous.rendered_page) clear();
+}
+
+void StepSequenceUI::render_steps(page_mask_t steps) {
+  // set internal rendered steps and render all steps for this page.
+  rendered_steps = steps;
+  turn_on_leds(rendered_steps);
+}
+
+void StepSequenceUI::render_added_step(page_relative_step_idx_t step) {
+  if (step < RenderedSteps::max_page_size) rendered_steps |= page_mask_t(1) << step;
+
+  turn_on_led(step);
+}
+
+void StepSequenceUI::render_values(std::uint64_t packed) {
+  auto values = values_t::unpack(packed);
+
+  latest.rendered_page  = values.rendered_page;
+  latest.show_last_step = values.show_last_step;
+  latest.last_step      = values.last_step;
+  latest.ready          = true;
+
+  render();
+}
+
+void StepSequenceUI::render() {
+  // wait for the rendered page, last step, etc...
+  if (!latest.ready) return;
+
+  auto rendered_page      = latest.rendered_page;
+  auto current_paged_step = latest.current_step;
+  auto show_last_step     = latest.show_last_step;
+  auto last_step          = latest.last_step;
+
+  if (rendered_page == current_paged_step.page) {
+    // when the rendered page is the same as the playing page (cursor is on this page).
+    // we want to:
+    // 1) turn on the step where the cursor is located
+    //      - set the led brightness appropriately if the cursor step is on an active step
+    // 2) turn off the previous cursor step if if is on this page
+    //      - set the previous step led brighntess appropriately if it was on an active step
+    
+    auto current_step_active =
+      rendered_page == current_paged_step.page &&
+      is_rendered(current_paged_step.step);
+    auto previous_step_active =
+      is_rendered(current_paged_step.step - 1);
+
+    // 1) turn the current cursor step on (to the appropriate led brightness)
+    set_led(current_paged_step.step,
+            current_step_active ? led_level.cursor_on_active_step : led_level.cursor);
+
+    // 2) turn off the previous cursor step (to the appropriate led brightness)
+    // when the current step is *not* the first step on the page
+    // and the previous step is *not* an active (on) step, turn off the previous step.
+    if (current_paged_step.step != 0) {
+      set_led(current_paged_step.step - 1,
+              previous_step_active ? led_level.active : led_level.inactive);
+    }
+  }
+
+  // turn off the last step on the rendered page if the cursor just moved to a new page.
+  auto cursor_moved_to_next_page =
+    (rendered_page != last_step.page && current_paged_step == paged_step_idx_t{ .page=rendered_page + 1, .step=0 }) ||
+    (rendered_page == last_step.page && current_paged_step == paged_step_idx_t{ .page=0, .step=0 } );
+  if (cursor_moved_to_next_page) {
+    // get the last step on the rendered page
+    auto last_step_on_rendered_page =
+      rendered_page == last_step.page ?
+      last_step.step : page_size - 1;
+      
+    // is the final step on this page activated (on)?
+    auto final_step_on_page_activated = is_rendered(last_step_on_rendered_page);
+
+    // if the previous step was the final step on the page, set the led to the appropraite brightness.
+    // spdlog::warn("WAS FINAL STEP ON PAGE"); TODO: this fires a bunch of times, we can optimize so it only fires once
+    set_led(last_step_on_rendered_page,
+            final_step_on_page_activated ? led_level.active : led_level.inactive);                     
+  }
+  
+  // if show_last_step has been activated, we want to add an animation for the last step.
+  // since we are observing both rendered_page AND show_last_step (via combine_latest), they
+  // will not change in lock-step, but one-by-one, meaninng that we will never have a situation
+  // in which the previous rendered_page != current rendered_page AND previous show_last_step !=
+  // current show_last_step.
+  if (rendered_page == last_step.page &&
+      show_last_step &&
+      (previous.rendered_page != rendered_page || previous.show_last_step != show_last_step))
+    add_animation(led_level.animate.last_step, last_step.step);
+
+  // turn off the previous last step if it has changed!
+  if (rendered_page == previous.last_step.page &&
+      last_step != previous.last_step)
+    remove_animation(previous.last_step.step, 0);
+    
+  // turn on new last step animation if it has changed!
+  if (rendered_page == last_step.page &&
+      last_step != previous.last_step)
+    add_animation(led_level.animate.last_step, last_step.step);
+  
+  // remove last step animation if show_last_step has changed
+  // set the led to the appropriate brightness if the last_step was active
+  if (rendered_page == last_step.page && !show_last_step && previous.show_last_step)
+    remove_animation(last_step.step, 0);
+    
+
+  // update previous values
+  previous.rendered_page = rendered_page;
+  previous.last_step = last_step;
+  previous.show_last_step = show_last_step;
+}
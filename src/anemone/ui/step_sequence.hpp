@@ -8,21 +8,149 @@
 #ifndef UI_STEP_SEQUENCE_H
 #define UI_STEP_SEQUENCE_H
 
+#include <atomic>
 #include <memory>
+#include <cstdint>
 
 #include "anemone/io.hpp"
 #include "anemone/types.hpp"
 #include "anemone/state.hpp"
 
+#include "anemone/ui/thread.hpp"
 #include "anemone/ui/component.hpp"
 
 
 class StepSequenceUI : public UIComponent {
 public:
-  StepSequenceUI(LayoutName, GridSectionName, std::shared_ptr<IO>, std::shared_ptr<State>);
+  StepSequenceUI(LayoutName, GridSectionName, std::shared_ptr<IO>, std::shared_ptr<State>, std::shared_ptr<UIThread>);
+
+  /// @brief lets through the cursor moves which show on a page, i.e. the steps on the
+  /// page and the first step after it (the cursor leaving the page).
+  class CursorOnPage : public SubscriptionPredicate<granular_step_idx_t> {
+  public:
+    explicit CursorOnPage(unsigned int page_size) : page_size(page_size) {};
+
+    /// @brief follows a page, of a part whose last page is given.
+    void follow(page_idx_t page, page_idx_t last_page) {
+      this->page.store(page, std::memory_order_relaxed);
+      this->last_page.store(last_page, std::memory_order_relaxed);
+    };
+
+    bool operator()(granular_step_idx_t granular_step) override {
+      auto step      = granular_to_paged_step(granular_step, page_size);
+      auto page      = this->page.load(std::memory_order_relaxed);
+      auto next_page = page == last_page.load(std::memory_order_relaxed) ? 0 : page + 1;
+
+      return step.page == page || (step.page == next_page && step.step == 0);
+    };
+
+  private:
+    unsigned int            page_size;
+    std::atomic<page_idx_t> page      = { 0 };
+    std::atomic<page_idx_t> last_page = { 0 };
+  };
 
 private:
-  std::set<page_relative_step_idx_t> rendered_steps;
+  /// @brief the size of a page.
+  unsigned int page_size;
+
+  /// @brief the thread everything is rendered on.
+  ///
+  /// @details the values change on the state store's thread (and the cursor on the
+  /// tick thread), which only post them to the ui thread. so only the ui thread
+  /// renders, and it needs no lock.
+  ///
+  std::shared_ptr<UIThread> ui_thread;
+
+  /// @brief the part whose cursor is observed, only on the rendered page (store thread).
+  struct {
+    std::shared_ptr<Part>                                     part;
+    HighFrequencyState<granular_step_idx_t>::subscription_t subscription = 0;
+    std::shared_ptr<CursorOnPage>                             on_rendered_page;
+
+    /// @brief bumped each time another part is observed, so the ui thread can tell
+    /// the moves of the previous part apart (and drop them).
+    std::uint32_t generation = 0;
+  } cursor;
+
+  /// @brief the low frequency values to render, as posted to the ui thread.
+  struct values_t {
+    page_idx_t       rendered_page;
+    bool             show_last_step;
+    paged_step_idx_t last_step;
+
+    /// @brief packs the values into an integral (24 bits per page, 8 per step).
+    std::uint64_t pack() const {
+      return
+        std::uint64_t(rendered_page & 0xFFFFFF)       |
+        std::uint64_t(last_step.page & 0xFFFFFF) << 24 |
+        std::uint64_t(last_step.step & 0xFF) << 48     |
+        std::uint64_t(show_last_step) << 56;
+    };
+
+    static values_t unpack(std::uint64_t packed) {
+      return { .rendered_page  = page_idx_t(packed & 0xFFFFFF),
+               .show_last_step = ((packed >> 56) & 1) != 0,
+               .last_step      = { .page = page_idx_t((packed >> 24) & 0xFFFFFF),
+                                   .step = page_relative_step_idx_t((packed >> 48) & 0xFF) },
+      };
+    };
+  };
+
+  /// @brief packs a cursor move of the part observed in a generation (see `cursor`).
+  static std::uint64_t cursor_move(std::uint32_t generation, granular_step_idx_t step) {
+    return std::uint64_t(generation) << 32 | step;
+  };
+
+  /// @brief the latest values to render (ui thread).
+  struct {
+    page_idx_t       rendered_page  = 0;
+    paged_step_idx_t current_step   = { .page = 0, .step = 0 };
+    bool             show_last_step = false;
+    paged_step_idx_t last_step      = { .page = 1, .step = 31 };
+
+    /// @brief the generation of the part whose cursor is rendered.
+    std::uint32_t generation = 0;
+
+    /// @brief whether the (low frequency) values have been received.
+    bool ready = false;
+  } latest;
+
+  /// @brief observes the cursor of a part, instead of the previous one (store thread).
+  void observe_cursor_of(std::shared_ptr<Part>);
+
+  /// @brief renders the cursor of the part just observed (ui thread).
+  void switch_cursor(std::uint64_t);
+
+  /// @brief renders a cursor move, unless its part is no longer observed (ui thread).
+  void render_cursor(std::uint64_t);
+
+  /// @brief moves the cursor without rendering it, unless its part is no longer
+  /// observed (ui thread).
+  void follow_cursor(std::uint64_t);
+
+  /// @brief renders a page being shown, clearing the previous one (ui thread).
+  void render_page(page_idx_t);
+
+  /// @brief renders the steps of the page being shown (ui thread).
+  void render_steps(page_mask_t);
+
+  /// @brief renders a step added to the page being shown (ui thread).
+  void render_added_step(page_relative_step_idx_t);
+
+  /// @brief renders changed low frequency values (ui thread).
+  void render_values(std::uint64_t);
+
+  /// @brief renders the cursor & last step from the latest values.
+  void render();
+
+  /// @brief the rendered steps on the rendered page.
+  page_mask_t rendered_steps = 0;
+
+  /// @brief whether a step on the rendered page is rendered.
+  bool is_rendered(page_relative_step_idx_t step) const {
+    return step < RenderedSteps::max_page_size && (rendered_steps >> step) & 1;
+  };
 
   /// @brief previous values
   struct {
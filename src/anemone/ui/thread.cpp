@@ -0,0 +1,43 @@
+#include <spdlog/spdlog.h>
+
+#include "anemone/ui/thread.hpp"
+
+
+UIThread::~UIThread() {
+  stop();
+}
+
+void UIThread::start() {
+  if (thread.joinable()) return;
+
+  running.store(true, std::memory_order_release);
+  thread = std::thread([this] { run(); });
+}
+
+void UIThread::stop() {
+  if (!thread.joinable()) return;
+
+  running.store(false, std::memory_order_release);
+
+  // if the ring is full, the thread isn't asleep anyway.
+  changes.try_push({ .render = wake_up, .component = nullptr, .value = 0 });
+
+  thread.join();
+}
+
+void UIThread::run() {
+  while (true) {
+    // check before draining, so everything posted before stopping is rendered.
+    auto keep_running = running.load(std::memory_order_acquire);
+
+    auto rendered = changes.drain([] (change_t change) {
+                                    change.render(change.component, change.value);
+                                  });
+
+    if (!keep_running) return;
+    if (rendered > 0) continue;
+
+    changes.wait();
+    wakeup_count.fetch_add(1, std::memory_order_relaxed);
+  }
+}
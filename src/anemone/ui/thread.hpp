@@ -0,0 +1,104 @@
+/**
+ * @file   ui/thread.hpp
+ * @brief  Non Real-Time UI Thread
+ * @author coco
+ * @date   2026-10-18
+ *************************************************/
+
+#ifndef UI_THREAD_H
+#define UI_THREAD_H
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <type_traits>
+
+#include "anemone/util/ring.hpp"
+
+
+/// @brief Thread on which the ui renders the changes of high frequency state.
+///
+/// @details
+/// high frequency state (e.g. a part's cursor) changes on the tick thread, which must
+/// do nothing but advance the cursors and emit midi: rendering a change writes to the
+/// grid, and a slow write would delay the next midi event. so the ui components hand
+/// the changes they observe over to this thread through a lock-free ring, and this
+/// thread renders them, in order.
+///
+/// the thread sleeps on the ring while there is nothing to render, so it only wakes
+/// up when a change is handed over (the only time posting makes a system call, i.e.
+/// a futex wake, is when the thread is asleep). changes handed over while the ring is
+/// full are dropped (and counted), rather than waited for.
+///
+/// @remark changes are posted from the tick thread, but also from the state store's
+/// thread (the low frequency changes, e.g. another page or part being shown), so that
+/// this thread is the only one rendering. the ring takes multiple producers, and keeps
+/// the changes of each producer in order.
+///
+class UIThread {
+public:
+  /// @brief the number of changes waiting to be rendered the ring holds.
+  static constexpr std::size_t capacity = 1024;
+
+  UIThread() = default;
+  ~UIThread();
+
+  UIThread(const UIThread&) = delete;
+  UIThread& operator=(const UIThread&) = delete;
+
+  /// @brief starts rendering the changes posted.
+  void start();
+
+  /// @brief stops rendering, once the changes posted are rendered.
+  void stop();
+
+  /// @brief posts a change for a component to render.
+  ///
+  /// @details e.g. `thread->post<&StepSequenceUI::render_added_step>(this, step)`.
+  ///
+  /// @tparam Render   the component's method rendering the change.
+  ///
+  template <auto Render, typename Component, typename T>
+  void post(Component* component, T value) {
+    static_assert(std::is_integral<T>::value, "only integral values can be posted");
+
+    change_t change = {
+      .render    = [] (void* component, std::uint64_t value) {
+                     (static_cast<Component*>(component)->*Render)(static_cast<T>(value));
+                   },
+      .component = component,
+      .value     = static_cast<std::uint64_t>(value),
+    };
+
+    if (!changes.try_push(change)) dropped_count.fetch_add(1, std::memory_order_relaxed);
+  };
+
+  /// @brief the number of changes dropped because the ring was full.
+  unsigned long dropped() const { return dropped_count.load(std::memory_order_relaxed); };
+
+  /// @brief the number of times the thread woke up to render changes.
+  unsigned long wakeups() const { return wakeup_count.load(std::memory_order_relaxed); };
+
+private:
+  /// @brief a change, i.e. a value and the component method which renders it.
+  struct change_t {
+    void          (*render)(void*, std::uint64_t);
+    void*         component;
+    std::uint64_t value;
+  };
+
+  MpscRing<change_t, capacity> changes;
+
+  std::thread                thread;
+  std::atomic<bool>          running = { false };
+  std::atomic<unsigned long> dropped_count = { 0 };
+  std::atomic<unsigned long> wakeup_count  = { 0 };
+
+  /// @brief renders the changes posted until stopped.
+  void run();
+
+  /// @brief a change rendering nothing, posted to wake the thread up when stopping.
+  static void wake_up(void*, std::uint64_t) {};
+};
+
+#endif
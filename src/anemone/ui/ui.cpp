@@ -13,11 +13,17 @@ UI::UI(std::shared_ptr<Config> config,
     plugin_manager(plugin_manager)
 {}
 
+UI::~UI() {
+  // stop rendering before the components are destroyed.
+  if (thread) thread->stop();
+}
 
 void UI::connect() {
+  thread = std::make_shared<UIThread>();
+
   shift             = std::make_unique<ShiftUI>(LayoutName::SequencerAndInstrument, GridSectionName::Shift, io, state);
-  step_sequence     = std::make_unique<StepSequenceUI>(LayoutName::SequencerAndInstrument, GridSectionName::Steps, io, state);
-  pages             = std::make_unique<PageUI>(LayoutName::SequencerAndInstrument, GridSectionName::Pages, io, state);
+  step_sequence     = std::make_unique<StepSequenceUI>(LayoutName::SequencerAndInstrument, GridSectionName::Steps, io, state, thread);
+  pages             = std::make_unique<PageUI>(LayoutName::SequencerAndInstrument, GridSectionName::Pages, io, state, thread);
   parts             = std::make_unique<PartsUI>(LayoutName::SequencerAndInstrument, GridSectionName::Parts, io, state);
   banks             = std::make_unique<BanksUI>(LayoutName::SequencerAndInstrument, GridSectionName::Banks, io, state);
   ppqn              = std::make_unique<PPQNUI>(LayoutName::SequencerAndInstrument, GridSectionName::PPQN, io, state);
@@ -30,6 +36,26 @@ void UI::connect() {
   for (auto plugin : plugin_manager->plugins) {
     ui_plugins.push_back(plugin->make_ui(io, state));
   }
+
+  thread->start();
+  last_report = { .time = std::chrono::steady_clock::now(), .wakeups = 0 };
   
   spdlog::info("  connected -> ui");
 }
+
+void UI::log_stats() {
+  if (!thread) return;
+
+  // wakeups of the ui thread since the previous report.
+  auto now     = std::chrono::steady_clock::now();
+  auto seconds = std::chrono::duration<double>(now - last_report.time).count();
+  auto wakeups = thread->wakeups();
+
+  if (seconds > 0) {
+    spdlog::info("ui -> {:.1f} wakeups/s | {} changes dropped",
+                 (double)(wakeups - last_report.wakeups) / seconds,
+                 thread->dropped());
+  }
+
+  last_report = { .time = now, .wakeups = wakeups };
+}
@@ -8,6 +8,7 @@
 #ifndef UI_UI_H
 #define UI_UI_H
 
+#include <chrono>
 #include <memory>
 
 #include "anemone/io.hpp"
@@ -16,6 +17,7 @@
 #include "anemone/types.hpp"
 #include "anemone/state.hpp"
 
+#include "anemone/ui/thread.hpp"
 #include "anemone/ui/layout_ui.hpp"
 #include "anemone/ui/component.hpp"
 #include "anemone/ui/shift.hpp"
@@ -36,9 +38,14 @@ public:
      std::shared_ptr<IO>,
      std::shared_ptr<State>,
      std::shared_ptr<PluginManager>);
+  UI(UI&&) = default;
+  ~UI();
 
   void connect();
 
+  /// @brief logs the wakeups of the ui thread, and the changes it dropped.
+  void log_stats();
+
 private:
   std::shared_ptr<Config> config;
   std::shared_ptr<IO> io;
@@ -57,6 +64,15 @@ private:
   std::unique_ptr<InstrumentSelectUI> instrument_select;
 
   std::vector< std::shared_ptr<LayoutUI> > ui_plugins;
+
+  /// @brief the thread high frequency state is rendered on.
+  std::shared_ptr<UIThread> thread;
+
+  /// @brief ui thread counts as of the previous stats report.
+  struct {
+    std::chrono::steady_clock::time_point time;
+    unsigned long                         wakeups;
+  } last_report;
 };
 
 #endif
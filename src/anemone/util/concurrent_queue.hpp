@@ -3,6 +3,8 @@
 
 #include <queue>
 #include <mutex>
+#include <vector>
+#include <cstddef>
 #include <condition_variable>
 
 #include <spdlog/spdlog.h>
@@ -12,6 +14,24 @@ template<typename T>
 class Queue {
 public:
   T pop();
+
+  /// @brief pops a batch of items, waiting for at least one.
+  ///
+  /// @param batch   the batch the items are appended to.
+  /// @param max     the maximum number of items popped.
+  ///
+  /// @return the number of items popped.
+  ///
+  std::size_t pop(std::vector<T>& batch, std::size_t max);
+
+  /// @brief pops a batch of items, without waiting.
+  ///
+  /// @return the number of items popped (none if the queue is empty).
+  ///
+  std::size_t try_pop(std::vector<T>& batch, std::size_t max);
+
+  bool empty();
+
   void push(const T&);
   void push(T&&);
   
@@ -33,6 +53,39 @@ T Queue<T>::pop() {
   return item;
 }
 
+template<typename T>
+std::size_t Queue<T>::pop(std::vector<T>& batch, std::size_t max) {
+  std::unique_lock<std::mutex> mlock(mutex);
+  condition.wait(mlock, [this]{ return !queue.empty(); });
+
+  std::size_t popped = 0;
+  for (; popped < max && !queue.empty(); popped++) {
+    batch.push_back(std::move(queue.front()));
+    queue.pop();
+  }
+
+  return popped;
+}
+
+template<typename T>
+std::size_t Queue<T>::try_pop(std::vector<T>& batch, std::size_t max) {
+  std::unique_lock<std::mutex> mlock(mutex);
+
+  std::size_t popped = 0;
+  for (; popped < max && !queue.empty(); popped++) {
+    batch.push_back(std::move(queue.front()));
+    queue.pop();
+  }
+
+  return popped;
+}
+
+template<typename T>
+bool Queue<T>::empty() {
+  std::unique_lock<std::mutex> mlock(mutex);
+  return queue.empty();
+}
+
 template<typename T>
 void Queue<T>::push(const T& item) {
   std::unique_lock<std::mutex> mlock(mutex);
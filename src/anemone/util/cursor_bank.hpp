@@ -0,0 +1,122 @@
+#ifndef ANEMONE_UTIL_CURSOR_BANK_H
+#define ANEMONE_UTIL_CURSOR_BANK_H
+
+#include <vector>
+#include <cstddef>
+
+
+/// @brief Bank of looping cursors, advanced together.
+///
+/// @details
+/// each cursor moves by its own stride on every tick and comes back to the top once
+/// it is past its own end, so cursors of different lengths & rates drift against each
+/// other (i.e. polymeters). the positions, strides & ends of the cursors are kept in
+/// parallel arrays, which are advanced in a single branch free pass the compiler can
+/// vectorize, however many cursors there are.
+///
+/// cursors are finer than what is observed of them (e.g. granular steps vs. steps), so
+/// the pass also flags the cursors which landed on a new observable position. only
+/// those need to be told about.
+///
+/// @remark the bank is not thread safe, it is meant to be owned by the tick thread.
+///
+class CursorBank {
+public:
+  /// @brief a cursor position, stride or end.
+  typedef unsigned int position_t;
+
+  /// @brief a cursor, which stays valid until it is removed.
+  typedef std::size_t slot_t;
+
+  /// @param granularity   the number of positions per observable position (a power of
+  ///                      two), e.g. the number of granular steps per step.
+  explicit CursorBank(position_t granularity) {
+    while ((position_t(1) << shift) < granularity) shift++;
+  };
+
+  /// @brief adds a cursor, which stays put until it is given a stride & an end.
+  slot_t add(position_t position = 0) {
+    slot_t slot;
+    if (!released.empty()) {
+      slot = released.back();
+      released.pop_back();
+    } else {
+      slot = positions.size();
+      positions.push_back(0);
+      strides.push_back(0);
+      ends.push_back(0);
+      changes.push_back(0);
+    }
+
+    positions[slot] = position;
+    strides[slot]   = 0;
+    ends[slot]      = 0;
+    changes[slot]   = 0;
+
+    return slot;
+  };
+
+  /// @brief removes a cursor, so its slot can be reused.
+  void remove(slot_t slot) {
+    strides[slot] = 0;
+    ends[slot]    = 0;
+    changes[slot] = 0;
+    released.push_back(slot);
+  };
+
+  /// @brief moves a cursor.
+  void move(slot_t slot, position_t position) { positions[slot] = position; };
+
+  /// @brief sets how far a cursor moves on each tick.
+  void set_stride(slot_t slot, position_t stride) { strides[slot] = stride; };
+
+  /// @brief sets the end of a cursor, i.e. the position it comes back to the top from.
+  void set_end(slot_t slot, position_t end) { ends[slot] = end; };
+
+  /// @brief the position of a cursor.
+  position_t at(slot_t slot) const { return positions[slot]; };
+
+  /// @brief whether a cursor landed on a new observable position (or came back to the
+  /// top) when the bank was last advanced.
+  bool moved(slot_t slot) const { return changes[slot] != 0; };
+
+  /// @brief the number of cursors in the bank.
+  std::size_t size() const { return positions.size() - released.size(); };
+
+  /// @brief advances every cursor by its stride, bringing those past their end back
+  /// to the top.
+  void advance() {
+    auto n     = positions.size();
+    auto shift = this->shift;
+
+    auto* __restrict position = positions.data();
+    auto* __restrict stride   = strides.data();
+    auto* __restrict end      = ends.data();
+    auto* __restrict changed  = changes.data();
+
+    for (std::size_t i = 0; i < n; i++) {
+      // masks rather than branches, so the loop is vectorized. a cursor without an end
+      // (i.e. a removed one) never comes back to the top.
+      position_t at   = position[i];
+      position_t keep = -position_t(at <= end[i] - 1);
+      position_t next = (at + stride[i]) & keep;
+
+      changed[i]  = position_t((next >> shift) != (at >> shift)) | position_t(next < at);
+      position[i] = next;
+    }
+  };
+
+private:
+  std::vector<position_t> positions;
+  std::vector<position_t> strides;
+  std::vector<position_t> ends;
+  std::vector<position_t> changes;
+
+  /// @brief the slots of removed cursors.
+  std::vector<slot_t> released;
+
+  /// @brief log2 of the granularity.
+  unsigned int shift = 0;
+};
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef ANEMONE_UTIL_HIGH_FREQUENCY_H
+#define ANEMONE_UTIL_HIGH_FREQUENCY_H
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+
+
+/// @brief Predicate guarding a subscription to high frequency state.
+///
+/// @details
+/// it is evaluated by the writer with each new value, before the observer is called,
+/// so a value the observer doesn't care about costs a call rather than a notification
+/// and everything downstream of it. a predicate may keep its own state (e.g. the last
+/// value it let through) or follow other state (e.g. the rendered page).
+///
+/// @remark predicates are evaluated on the writer's (i.e. the tick) thread, against the
+/// published snapshot of observers and without any lock held, so they must be cheap and
+/// wait-free (e.g. compare against atomics, never take a lock).
+///
+template <typename T>
+class SubscriptionPredicate {
+public:
+  virtual ~SubscriptionPredicate() = default;
+
+  /// @brief whether the observer should be told about a value.
+  virtual bool operator()(T value) = 0;
+};
+
+
+/// @brief High frequency state, i.e. a value driven by the clock.
+///
+/// @details
+/// an `rx::behavior` suits state changed by the user: each change locks its subject
+/// and fans out through the operators chained on it. state driven by the clock (e.g. a
+/// part's cursor) changes up to 64 times per beat, and only a few observers which come
+/// and go care about it (e.g. the step ui only cares about the cursor of the rendered
+/// part). so it is kept flat, in plain memory (see notes/high_vs_low_freq_states.md):
+///   * the value is an atomic written by a single thread (the tick thread), and read
+///     from any thread without locking.
+///   * observers are called directly by the writer, in the order they subscribed.
+///     subscribing hands out a token to unsubscribe with, and both are cheap.
+///   * an observer may be guarded by a predicate, so it is only told about the values
+///     it cares about (see `SubscriptionPredicate`).
+///   * observers should only hand the value over (e.g. post it to the `UIThread`),
+///     since whatever they do adds to the writer's latency.
+///   * setting a value never locks, whether it is observed or not.
+///
+/// the observers are published as an immutable snapshot: (un)subscribing copies the
+/// current one, swaps the copy in and retires the previous one once the writer isn't
+/// reading it anymore. the writer announces the snapshot it reads through a hazard
+/// pointer, so it only ever does a few atomic loads & stores on top of notifying.
+///
+/// @remark observers are called on the writer's thread. once `unsubscribe` returns, the
+/// observer is not called anymore, so an observer must not (un)subscribe from within a
+/// notification (it would wait on itself).
+///
+template <typename T>
+class HighFrequencyState {
+public:
+  /// @brief an observer, called with each new value.
+  typedef std::function<void(T)> observer_t;
+
+  /// @brief a predicate guarding an observer.
+  typedef SubscriptionPredicate<T> predicate_t;
+
+  /// @brief a subscription token, handed back to unsubscribe.
+  typedef unsigned long subscription_t;
+
+  HighFrequencyState(T initial = T())
+    : value(initial)
+  {};
+
+  ~HighFrequencyState() {
+    delete observers.load(std::memory_order_relaxed);
+  };
+
+  HighFrequencyState(const HighFrequencyState&) = delete;
+  HighFrequencyState& operator=(const HighFrequencyState&) = delete;
+
+  /// @brief the current value.
+  T get() const { return value.load(std::memory_order_acquire); };
+
+  /// @brief sets the value, and tells the observers about it.
+  ///
+  /// @remark only one thread may set the value.
+  ///
+  void set(T next) {
+    value.store(next, std::memory_order_release);
+
+    if (observed.load(std::memory_order_acquire) == 0) return;
+
+    // announce the snapshot about to be read, and make sure it wasn't retired meanwhile.
+    auto snapshot = observers.load(std::memory_order_seq_cst);
+    while (true) {
+      reading.store(snapshot, std::memory_order_seq_cst);
+
+      auto current = observers.load(std::memory_order_seq_cst);
+      if (current == snapshot) break;
+
+      snapshot = current;
+    }
+
+    if (snapshot != nullptr) {
+      for (auto& entry : *snapshot) {
+        if (entry.predicate && !(*entry.predicate)(next)) continue;
+
+        entry.observer(next);
+      }
+    }
+
+    reading.store(nullptr, std::memory_order_release);
+  };
+
+  /// @brief subscribes an observer.
+  ///
+  /// @param observer    the observer.
+  /// @param predicate   the predicate a value must satisfy for the observer to be told
+  ///                    about it (all values if none).
+  ///
+  /// @return the token to unsubscribe it with.
+  ///
+  subscription_t subscribe(observer_t observer, std::shared_ptr<predicate_t> predicate = nullptr) {
+    std::lock_guard<std::mutex> guard(publish_mutex);
+
+    auto next = copy_observers();
+    next->push_back({
+        .id        = ++last_subscription,
+        .observer  = std::move(observer),
+        .predicate = std::move(predicate),
+      });
+    publish(next);
+
+    return last_subscription;
+  };
+
+  /// @brief unsubscribes an observer (unsubscribing twice is harmless).
+  void unsubscribe(subscription_t subscription) {
+    std::lock_guard<std::mutex> guard(publish_mutex);
+
+    auto next = copy_observers();
+    next->erase(std::remove_if(next->begin(), next->end(),
+                               [subscription] (const entry_t& entry) {
+                                 return entry.id == subscription;
+                               }),
+                next->end());
+    publish(next);
+  };
+
+  /// @brief the number of observers.
+  std::size_t observers_count() const { return observed.load(std::memory_order_acquire); };
+
+private:
+  struct entry_t {
+    subscription_t               id;
+    observer_t                   observer;
+    std::shared_ptr<predicate_t> predicate;
+  };
+
+  typedef std::vector<entry_t> observers_t;
+
+  std::atomic<T> value;
+
+  /// @brief the published observers (none until the first subscription).
+  std::atomic<const observers_t*> observers = { nullptr };
+
+  /// @brief the observers the writer is reading, if any.
+  std::atomic<const observers_t*> reading   = { nullptr };
+
+  std::atomic<std::size_t> observed = { 0 };
+
+  /// @brief serializes (un)subscribing (never taken by the writer).
+  std::mutex     publish_mutex;
+  subscription_t last_subscription = 0;
+
+  /// @brief a copy of the published observers (publish_mutex held).
+  observers_t* copy_observers() {
+    auto current = observers.load(std::memory_order_acquire);
+    return current != nullptr ? new observers_t(*current) : new observers_t();
+  };
+
+  /// @brief publishes observers, and retires the previous ones once the writer isn't
+  /// reading them anymore (publish_mutex held).
+  void publish(const observers_t* next) {
+    observed.store(next->size(), std::memory_order_release);
+
+    auto previous = observers.exchange(next, std::memory_order_seq_cst);
+    while (reading.load(std::memory_order_seq_cst) == previous && previous != nullptr) {
+      std::this_thread::yield();
+    }
+
+    delete previous;
+  };
+};
+
+#endif
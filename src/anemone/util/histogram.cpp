@@ -0,0 +1,80 @@
+#include <cmath>
+#include <algorithm>
+
+#include "anemone/util/histogram.hpp"
+
+
+Histogram::Histogram() {
+  reset();
+}
+
+void Histogram::record(std::uint64_t value) {
+  buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+  total.fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(value, std::memory_order_relaxed);
+
+  auto current = largest.load(std::memory_order_relaxed);
+  while (value > current && !largest.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+std::uint64_t Histogram::count() {
+  return total.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Histogram::max() {
+  return largest.load(std::memory_order_relaxed);
+}
+
+double Histogram::mean() {
+  auto n = count();
+  if (n == 0) return 0;
+
+  return (double)sum.load(std::memory_order_relaxed) / (double)n;
+}
+
+std::uint64_t Histogram::percentile(double percentile) {
+  auto n = count();
+  if (n == 0) return 0;
+
+  // the rank of the value at this percentile (at least the first value).
+  auto rank = static_cast<std::uint64_t>(std::ceil((percentile / 100.0) * (double)n));
+  if (rank == 0) rank = 1;
+
+  std::uint64_t seen = 0;
+  for (unsigned int i = 0; i < BUCKETS; i++) {
+    seen += buckets[i].load(std::memory_order_relaxed);
+    if (seen >= rank) return std::min(highest_in(i), max());
+  }
+
+  return max();
+}
+
+void Histogram::reset() {
+  for (auto &bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+  total.store(0, std::memory_order_relaxed);
+  sum.store(0, std::memory_order_relaxed);
+  largest.store(0, std::memory_order_relaxed);
+}
+
+unsigned int Histogram::bucket_of(std::uint64_t value) {
+  // small values each get their own bucket.
+  if (value < SUB_BUCKETS) return static_cast<unsigned int>(value);
+
+  // otherwise, the bucket is determined by the position of the leading bit and the
+  // sub-bucket by the bits right below it.
+  unsigned int exponent = 63 - __builtin_clzll(value);
+  unsigned int sub      = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+
+  return ((exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS) + sub;
+}
+
+std::uint64_t Histogram::highest_in(unsigned int bucket) {
+  if (bucket < SUB_BUCKETS) return bucket;
+
+  unsigned int exponent = (bucket / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+  std::uint64_t sub     = bucket % SUB_BUCKETS;
+  std::uint64_t width   = std::uint64_t(1) << (exponent - SUB_BUCKET_BITS);
+  std::uint64_t lowest  = (SUB_BUCKETS + sub) * width;
+
+  return lowest + (width - 1);
+}
@@ -0,0 +1,65 @@
+#ifndef ANEMONE_UTIL_HISTOGRAM_H
+#define ANEMONE_UTIL_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+
+/// @brief Lock-free histogram with logarithmic buckets (à la HdrHistogram).
+///
+/// @details
+/// each power of two range of values is split into 32 linear sub-buckets, so any
+/// recorded value is reported within ~3% of its actual value, from 0 up to 2^64.
+/// recording is a couple of relaxed atomic increments and never allocates, so it is
+/// safe to use from the hot path while another thread reads the histogram.
+///
+/// @remark reads are not a consistent snapshot while values are being recorded, which
+/// is fine for reporting.
+///
+class Histogram {
+public:
+  Histogram();
+
+  /// @brief records a value.
+  void record(std::uint64_t);
+
+  /// @brief the number of recorded values.
+  std::uint64_t count();
+
+  /// @brief the largest recorded value.
+  std::uint64_t max();
+
+  /// @brief the mean of the recorded values.
+  double mean();
+
+  /// @brief the value below which the provided percentage of recorded values fall.
+  ///
+  /// @param percentile   a percentile in [0, 100].
+  ///
+  /// @return the (highest equivalent) value at the percentile, or 0 if nothing has
+  /// been recorded.
+  ///
+  std::uint64_t percentile(double);
+
+  /// @brief forgets all recorded values.
+  void reset();
+
+private:
+  static const unsigned int SUB_BUCKET_BITS = 5;
+  static const unsigned int SUB_BUCKETS     = 1 << SUB_BUCKET_BITS;
+  static const unsigned int BUCKETS         = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+  std::array<std::atomic<std::uint64_t>, BUCKETS> buckets;
+  std::atomic<std::uint64_t> total;
+  std::atomic<std::uint64_t> sum;
+  std::atomic<std::uint64_t> largest;
+
+  /// @brief the bucket a value falls in.
+  static unsigned int bucket_of(std::uint64_t);
+
+  /// @brief the largest value which falls in a bucket.
+  static std::uint64_t highest_in(unsigned int);
+};
+
+#endif
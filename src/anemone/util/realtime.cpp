@@ -0,0 +1,128 @@
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <alloca.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "anemone/util/realtime.hpp"
+
+
+realtime_thread_t realtime_thread_from_config(std::shared_ptr<Config> config, std::string thread) {
+  auto realtime = config->at("realtime");
+  auto settings = realtime["threads"][thread];
+
+  return { .enabled        = realtime["enabled"].as<bool>(false),
+           .priority       = settings["priority"].as<int>(0),
+           .cpu            = settings["cpu"].as<int>(-1),
+           .stack_prefault = realtime["stack_prefault"].as<std::size_t>(256) * 1024,
+  };
+}
+
+#ifdef __linux__
+
+bool make_realtime(std::string name, realtime_thread_t settings) {
+  pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+
+  if (!settings.enabled) return false;
+
+  bool ok = true;
+
+  if (settings.cpu >= 0) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(settings.cpu, &cpus);
+
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (err != 0) {
+      spdlog::warn("  realtime -> {} thread could not be pinned to cpu {} ({}), running on any cpu",
+                   name, settings.cpu, std::strerror(err));
+      ok = false;
+    }
+  }
+
+  if (settings.priority > 0) {
+    sched_param param = {};
+    param.sched_priority = settings.priority;
+
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0) {
+      spdlog::warn("  realtime -> {} thread could not get SCHED_FIFO priority {} ({}), running at normal priority. "
+                   "(needs CAP_SYS_NICE or an rtprio limit)",
+                   name, settings.priority, std::strerror(err));
+      ok = false;
+    }
+  }
+
+  prefault_stack(settings.stack_prefault);
+
+  if (ok) spdlog::info("  realtime -> {} thread (SCHED_FIFO {}, cpu {})", name, settings.priority, settings.cpu);
+
+  return ok;
+}
+
+bool lock_memory(std::size_t heap_reserve) {
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    spdlog::warn("  realtime -> could not lock memory ({}), pages may fault on the hot path. "
+                 "(needs CAP_IPC_LOCK or a memlock limit)",
+                 std::strerror(errno));
+    return false;
+  }
+
+#ifdef __GLIBC__
+  // never give heap back to the os and never satisfy allocations with their own mmap,
+  // so that the heap we reserve below stays mapped (and locked) for later allocations.
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+#endif
+
+  if (heap_reserve > 0) {
+    // touch every page of a large allocation so it gets mapped, then return it to the heap.
+    auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    auto heap = static_cast<volatile unsigned char *>(std::malloc(heap_reserve));
+    if (heap != nullptr) {
+      for (std::size_t i = 0; i < heap_reserve; i += page) heap[i] = 0;
+      std::free(const_cast<unsigned char *>(heap));
+    }
+  }
+
+  spdlog::info("  realtime -> memory locked ({} MiB heap reserved)", heap_reserve / (1024 * 1024));
+
+  return true;
+}
+
+void prefault_stack(std::size_t bytes) {
+  if (bytes == 0) return;
+
+  // the stack grows into these pages once we return, so they stay mapped.
+  auto page  = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  auto stack = static_cast<volatile unsigned char *>(alloca(bytes));
+  for (std::size_t i = 0; i < bytes; i += page) stack[i] = 0;
+}
+
+#else
+
+bool make_realtime(std::string name, realtime_thread_t settings) {
+  if (settings.enabled) spdlog::warn("  realtime -> not supported on this platform, {} thread running at normal priority", name);
+  return false;
+}
+
+bool lock_memory(std::size_t heap_reserve) {
+  spdlog::warn("  realtime -> memory locking is not supported on this platform");
+  return false;
+}
+
+void prefault_stack(std::size_t bytes) {}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef ANEMONE_UTIL_REALTIME_H
+#define ANEMONE_UTIL_REALTIME_H
+
+#include <string>
+#include <memory>
+#include <cstddef>
+
+#include "anemone/config.hpp"
+
+
+/// @brief real-time settings for a thread.
+struct realtime_thread_t {
+  /// @brief whether to make the thread real-time at all.
+  bool enabled = false;
+
+  /// @brief SCHED_FIFO priority (1-99). 0 leaves the scheduling policy alone.
+  int priority = 0;
+
+  /// @brief cpu to pin the thread to. -1 leaves the affinity alone.
+  int cpu = -1;
+
+  /// @brief how much of the thread's stack to prefault (in bytes).
+  std::size_t stack_prefault = 0;
+};
+
+/// @brief reads the real-time settings of a thread from the `realtime` section of the config.
+///
+/// @param config   the config.
+/// @param thread   the name of the thread under `realtime.threads`.
+///
+realtime_thread_t realtime_thread_from_config(std::shared_ptr<Config> config, std::string thread);
+
+/// @brief names the calling thread and makes it real-time according to the provided settings.
+///
+/// @details
+/// pins the thread to its cpu, switches it to SCHED_FIFO at its priority and prefaults
+/// its stack. if any of this isn't permitted (e.g. missing CAP_SYS_NICE or rtprio limit),
+/// a warning is logged and the thread carries on as a normal thread.
+///
+/// @param name       the thread name (truncated to 15 characters).
+/// @param settings   the real-time settings.
+///
+/// @return whether the thread is running with all the requested real-time settings.
+///
+bool make_realtime(std::string name, realtime_thread_t settings);
+
+/// @brief locks the process memory and pre-reserves heap for the hot path.
+///
+/// @details
+/// locks all current and future pages into ram (mlockall) so that we never page fault
+/// on the hot path, then grows the heap by `heap_reserve` bytes, touching each page,
+/// and keeps it around for future allocations (no trimming, no mmap'd allocations).
+/// if memory can't be locked (e.g. missing CAP_IPC_LOCK or memlock limit), a warning
+/// is logged and we carry on without it.
+///
+/// @param heap_reserve   how much heap to pre-reserve (in bytes).
+///
+/// @return whether the memory has been locked.
+///
+bool lock_memory(std::size_t heap_reserve);
+
+/// @brief touches the next `bytes` of the calling thread's stack so it is mapped in advance.
+void prefault_stack(std::size_t bytes);
+
+#endif
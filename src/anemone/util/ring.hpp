@@ -0,0 +1,335 @@
+#ifndef ANEMONE_UTIL_RING_H
+#define ANEMONE_UTIL_RING_H
+
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+#if defined(__linux__)
+#include <ctime>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+
+/// @brief Lets the consumer of a ring sleep until something is pushed, without the
+/// producers ever blocking.
+///
+/// @details
+/// producers only make a system call (a futex wake) when the consumer is actually
+/// asleep, otherwise notifying is a fence and a load. off linux, the consumer naps
+/// instead of sleeping on a futex.
+///
+class RingSignal {
+public:
+  /// @brief waits until notified, or the timeout elapses (consumer only).
+  ///
+  /// @param is_ready   whether there is something to consume (checked once the
+  ///                   consumer is registered as waiting, so nothing is missed).
+  /// @param timeout    the longest the consumer waits for (`nanoseconds::max()`
+  ///                   waits until notified).
+  ///
+  template <typename Ready>
+  void wait(Ready&& is_ready, std::chrono::nanoseconds timeout) {
+    waiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    auto current = epoch.load(std::memory_order_relaxed);
+    if (!is_ready()) sleep(current, timeout);
+
+    waiting.store(0, std::memory_order_relaxed);
+  };
+
+  /// @brief wakes the consumer up, if it is waiting (producers).
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) == 0) return;
+
+    epoch.fetch_add(1, std::memory_order_relaxed);
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+  };
+
+private:
+  std::atomic<std::uint32_t> epoch   = { 0 };
+  std::atomic<std::uint32_t> waiting = { 0 };
+
+  void sleep(std::uint32_t current, std::chrono::nanoseconds timeout) {
+#if defined(__linux__)
+    struct timespec t = {
+      .tv_sec  = static_cast<time_t>(timeout.count() / 1000000000),
+      .tv_nsec = static_cast<long>(timeout.count() % 1000000000),
+    };
+    auto forever = timeout == std::chrono::nanoseconds::max();
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch), FUTEX_WAIT_PRIVATE, current, forever ? nullptr : &t, nullptr, 0);
+#else
+    (void)current;
+    std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, std::chrono::microseconds(100)));
+#endif
+  };
+};
+
+
+/// @brief Bounded single producer, single consumer ring buffer.
+///
+/// @details
+/// the producer only writes the tail and the consumer only writes the head, so
+/// pushing & popping are wait-free: a few loads, a move and a store, whatever the
+/// other side is doing. each side caches the other side's index, so it only touches
+/// the other side's cache line when the ring looks full (or empty). draining pops a
+/// batch of items and publishes the head once.
+///
+/// items are moved in & out (so move-only items are fine), and must be default
+/// constructible. neither side ever allocates or blocks, except the consumer when it
+/// explicitly waits.
+///
+/// @remark only one thread may push, and only one thread may pop.
+///
+template <typename T, std::size_t Capacity>
+class SpscRing {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "the capacity must be a power of two");
+
+public:
+  /// @brief pushes an item, unless the ring is full (producer only).
+  ///
+  /// @return whether the item was pushed.
+  ///
+  bool try_push(T item) {
+    auto tail = this->tail.load(std::memory_order_relaxed);
+
+    if (tail - head_cache == Capacity) {
+      head_cache = head.load(std::memory_order_acquire);
+      if (tail - head_cache == Capacity) return false;
+    }
+
+    slots[tail & mask] = std::move(item);
+    this->tail.store(tail + 1, std::memory_order_release);
+    signal.notify();
+
+    return true;
+  };
+
+  /// @brief pops an item, unless the ring is empty (consumer only).
+  ///
+  /// @return whether an item was popped.
+  ///
+  bool try_pop(T& item) {
+    auto head = this->head.load(std::memory_order_relaxed);
+
+    if (head == tail_cache) {
+      tail_cache = tail.load(std::memory_order_acquire);
+      if (head == tail_cache) return false;
+    }
+
+    item = std::move(slots[head & mask]);
+    this->head.store(head + 1, std::memory_order_release);
+
+    return true;
+  };
+
+  /// @brief pops up to `max` items, handing each to `consume` (consumer only).
+  ///
+  /// @return the number of items popped.
+  ///
+  template <typename Consume>
+  std::size_t drain(Consume&& consume, std::size_t max = Capacity) {
+    auto head = this->head.load(std::memory_order_relaxed);
+    tail_cache = tail.load(std::memory_order_acquire);
+
+    std::size_t popped = 0;
+    for (; popped < max && head + popped != tail_cache; popped++) {
+      consume(std::move(slots[(head + popped) & mask]));
+    }
+
+    this->head.store(head + popped, std::memory_order_release);
+
+    return popped;
+  };
+
+  /// @brief the next item to pop, or null if the ring is empty (consumer only).
+  ///
+  /// @remark the item stays in the ring (and valid) until it is popped.
+  ///
+  T* front() {
+    auto head = this->head.load(std::memory_order_relaxed);
+
+    if (head == tail_cache) {
+      tail_cache = tail.load(std::memory_order_acquire);
+      if (head == tail_cache) return nullptr;
+    }
+
+    return &slots[head & mask];
+  };
+
+  /// @brief waits until the ring isn't empty, or the timeout elapses (consumer only).
+  ///
+  /// @remark it may return early, i.e. the ring may still be empty.
+  ///
+  void wait(std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) {
+    signal.wait([this] { return !empty(); }, timeout);
+  };
+
+  /// @brief whether the ring is empty (approximate while in use).
+  bool empty() const { return size() == 0; };
+
+  /// @brief the number of items in the ring (approximate while in use).
+  std::size_t size() const {
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+  };
+
+  /// @brief the number of items the ring holds.
+  static constexpr std::size_t capacity() { return Capacity; };
+
+private:
+  static constexpr std::size_t mask = Capacity - 1;
+
+  /// @brief the consumer's side.
+  alignas(64) std::atomic<std::size_t> head = { 0 };
+  std::size_t                          tail_cache = 0;
+
+  /// @brief the producer's side.
+  alignas(64) std::atomic<std::size_t> tail = { 0 };
+  std::size_t                          head_cache = 0;
+
+  alignas(64) RingSignal signal;
+
+  alignas(64) std::array<T, Capacity> slots;
+};
+
+
+/// @brief Bounded multiple producer, single consumer ring buffer.
+///
+/// @details
+/// each slot carries a sequence number telling whose turn it is (à la Vyukov's bounded
+/// queue): producers claim a slot by moving the tail on with a compare & swap, fill it
+/// and hand it over by bumping its sequence, and the consumer hands it back the same
+/// way. pushing is lock-free (a producer only retries when another one claimed the
+/// slot first) and popping is wait-free. a producer preempted while filling its slot
+/// holds up the consumer at that slot, but never the other producers.
+///
+/// items are moved in & out (so move-only items are fine), and must be default
+/// constructible. neither side ever allocates or blocks, except the consumer when it
+/// explicitly waits.
+///
+/// @remark any thread may push, only one thread may pop.
+///
+template <typename T, std::size_t Capacity>
+class MpscRing {
+  static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "the capacity must be a power of two");
+
+public:
+  MpscRing() {
+    for (std::size_t i = 0; i < Capacity; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+  };
+
+  MpscRing(const MpscRing&) = delete;
+  MpscRing& operator=(const MpscRing&) = delete;
+
+  /// @brief pushes an item, unless the ring is full.
+  ///
+  /// @return whether the item was pushed.
+  ///
+  bool try_push(T item) {
+    auto tail = this->tail.load(std::memory_order_relaxed);
+
+    slot_t* slot;
+    while (true) {
+      slot = &slots[tail & mask];
+
+      auto sequence = slot->sequence.load(std::memory_order_acquire);
+      auto lag      = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(tail);
+
+      if (lag == 0) {
+        if (this->tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) break;
+      } else if (lag < 0) {
+        // the slot hasn't been popped since the last lap, i.e. the ring is full.
+        return false;
+      } else {
+        tail = this->tail.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->item = std::move(item);
+    slot->sequence.store(tail + 1, std::memory_order_release);
+    signal.notify();
+
+    return true;
+  };
+
+  /// @brief pops an item, unless the ring is empty (consumer only).
+  ///
+  /// @return whether an item was popped.
+  ///
+  bool try_pop(T& item) {
+    auto& slot = slots[head & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != head + 1) return false;
+
+    item = std::move(slot.item);
+    slot.sequence.store(head + Capacity, std::memory_order_release);
+    head++;
+
+    return true;
+  };
+
+  /// @brief pops up to `max` items, handing each to `consume` (consumer only).
+  ///
+  /// @return the number of items popped.
+  ///
+  template <typename Consume>
+  std::size_t drain(Consume&& consume, std::size_t max = Capacity) {
+    std::size_t popped = 0;
+    for (; popped < max; popped++) {
+      auto& slot = slots[head & mask];
+      if (slot.sequence.load(std::memory_order_acquire) != head + 1) break;
+
+      consume(std::move(slot.item));
+      slot.sequence.store(head + Capacity, std::memory_order_release);
+      head++;
+    }
+
+    return popped;
+  };
+
+  /// @brief waits until the ring isn't empty, or the timeout elapses (consumer only).
+  ///
+  /// @remark it may return early, i.e. the ring may still be empty.
+  ///
+  void wait(std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) {
+    signal.wait([this] { return !empty(); }, timeout);
+  };
+
+  /// @brief whether there is nothing to pop (consumer only).
+  bool empty() const {
+    return slots[head & mask].sequence.load(std::memory_order_acquire) != head + 1;
+  };
+
+  /// @brief the number of items the ring holds.
+  static constexpr std::size_t capacity() { return Capacity; };
+
+private:
+  static constexpr std::size_t mask = Capacity - 1;
+
+  struct slot_t {
+    std::atomic<std::size_t> sequence;
+    T                        item;
+  };
+
+  /// @brief the consumer's side.
+  alignas(64) std::size_t head = 0;
+
+  /// @brief the producers' side.
+  alignas(64) std::atomic<std::size_t> tail = { 0 };
+
+  alignas(64) RingSignal signal;
+
+  alignas(64) std::array<slot_t, Capacity> slots;
+};
+
+#endif
@@ -0,0 +1,258 @@
+#ifndef ANEMONE_UTIL_TIMING_WHEEL_H
+#define ANEMONE_UTIL_TIMING_WHEEL_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+
+/// @brief Hashed timing wheel of items due on a tick.
+///
+/// @details
+/// items are hashed into a fixed ring of slots by the tick they are due on, so
+/// scheduling an item and advancing the wheel by a tick only touch a single slot,
+/// however many items are pending. items due more than a revolution ahead share a
+/// slot with nearer ones and wait for their turn. advancing the wheel costs nothing
+/// while nothing is pending.
+///
+/// the items live in a pool of nodes allocated up front, and each slot is a list of
+/// nodes, so scheduling an item takes a node off the free list rather than
+/// allocating. the occupied slots are tracked in a bitmask, so flushing the wheel or
+/// removing items only visits the slots which hold items.
+///
+/// @remark the wheel is not thread safe, it is meant to be owned by the tick thread.
+///
+/// @remark the pool only grows (i.e. allocates) when more items than its capacity
+/// are pending at once.
+///
+template<typename T, std::size_t Slots = 256>
+class TimingWheel {
+public:
+  /// @brief makes a wheel, with room for a number of pending items.
+  ///
+  /// @param capacity   the number of items which can be pending without allocating.
+  ///
+  explicit TimingWheel(std::size_t capacity = Slots) {
+    nodes.reserve(capacity);
+    heads.fill(none);
+    tails.fill(none);
+  };
+
+  /// @brief schedules an item.
+  ///
+  /// @remark items scheduled at or before the current tick are due on the next one.
+  ///
+  /// @param tick   the tick the item is due on.
+  /// @param item   the item.
+  ///
+  void schedule(long tick, T item);
+
+  /// @brief advances the wheel, handing out the items due on the way.
+  ///
+  /// @param to   the tick to advance to.
+  /// @param f    called with each due item, as `f(tick, item)`. it must not schedule
+  ///             items on this wheel.
+  ///
+  template<typename F>
+  void advance(long to, F&& f);
+
+  /// @brief hands out all pending items, whenever they are due, and empties the wheel.
+  ///
+  /// @param f    called with each pending item, as `f(tick, item)`. it must not
+  ///             schedule items on this wheel.
+  ///
+  template<typename F>
+  void flush(F&& f);
+
+  /// @brief hands out the items due on a tick, leaving them pending.
+  ///
+  /// @param tick   the tick whose items to visit.
+  /// @param f      called with each item due on the tick, as `f(tick, item)`.
+  ///
+  template<typename F>
+  void visit(long tick, F&& f) const;
+
+  /// @brief removes the pending items matching a predicate.
+  ///
+  /// @param pred   called with each pending item, as `pred(tick, item)`.
+  ///
+  template<typename P>
+  void remove_if(P&& pred);
+
+  /// @brief the number of pending items.
+  std::size_t size() const { return pending; };
+
+  /// @brief whether there are no pending items.
+  bool empty() const { return pending == 0; };
+
+  /// @brief the tick the wheel is at.
+  long tick() const { return now; };
+
+  /// @brief the number of items which can be pending without allocating.
+  std::size_t capacity() const { return nodes.capacity(); };
+
+private:
+  typedef std::uint32_t node_idx_t;
+
+  /// @brief no node, i.e. the end of a list.
+  static constexpr node_idx_t none = ~node_idx_t(0);
+
+  struct node_t {
+    long       tick;
+    T          item;
+    node_idx_t next;
+  };
+
+  /// @brief the nodes, pending or free.
+  std::vector<node_t> nodes;
+
+  /// @brief the first free node.
+  node_idx_t first_free = none;
+
+  /// @brief the first and last nodes of each slot, in the order they were scheduled.
+  std::array<node_idx_t, Slots> heads;
+  std::array<node_idx_t, Slots> tails;
+
+  /// @brief the slots which hold items, the nth bit is the nth slot.
+  std::array<std::uint64_t, (Slots + 63) / 64> occupied = {};
+
+  std::size_t pending = 0;
+
+  long now = -1;
+
+  static std::size_t slot(long tick) { return static_cast<std::size_t>(tick) % Slots; };
+
+  bool is_occupied(std::size_t slot) const { return (occupied[slot / 64] >> (slot % 64)) & 1; };
+
+  /// @brief calls `f(slot)` with each occupied slot.
+  template<typename F>
+  void each_occupied(F&& f) {
+    for (std::size_t word = 0; word < occupied.size(); word++) {
+      auto bits = occupied[word];
+      while (bits != 0) {
+        f(word * 64 + __builtin_ctzll(bits));
+        bits &= bits - 1;
+      }
+    }
+  };
+
+  /// @brief removes the items of a slot matching a predicate, keeping the others in
+  /// order, and returns them to the free list.
+  template<typename P>
+  void remove_from(std::size_t slot, P&& pred) {
+    node_idx_t prev = none;
+    node_idx_t idx  = heads[slot];
+
+    while (idx != none) {
+      auto next = nodes[idx].next;
+
+      if (pred(nodes[idx])) {
+        if (prev == none) heads[slot] = next; else nodes[prev].next = next;
+        if (tails[slot] == idx) tails[slot] = prev;
+
+        // drop the item now, rather than whenever the node is reused.
+        nodes[idx].item = T();
+        nodes[idx].next = first_free;
+        first_free      = idx;
+        pending--;
+      } else {
+        prev = idx;
+      }
+
+      idx = next;
+    }
+
+    if (heads[slot] == none) occupied[slot / 64] &= ~(std::uint64_t(1) << (slot % 64));
+  };
+};
+
+
+template<typename T, std::size_t Slots>
+void TimingWheel<T, Slots>::schedule(long tick, T item) {
+  if (tick <= now) tick = now + 1;
+
+  // take a free node, or a new one if there are none left.
+  node_idx_t idx = first_free;
+  if (idx != none) {
+    first_free = nodes[idx].next;
+    nodes[idx].tick = tick;
+    nodes[idx].item = std::move(item);
+    nodes[idx].next = none;
+  } else {
+    idx = static_cast<node_idx_t>(nodes.size());
+    nodes.push_back({ tick, std::move(item), none });
+  }
+
+  // append it to its slot, after the items scheduled before it.
+  auto s = slot(tick);
+  if (heads[s] == none) heads[s] = idx; else nodes[tails[s]].next = idx;
+  tails[s] = idx;
+
+  occupied[s / 64] |= std::uint64_t(1) << (s % 64);
+  pending++;
+}
+
+template<typename T, std::size_t Slots>
+template<typename F>
+void TimingWheel<T, Slots>::advance(long to, F&& f) {
+  if (to <= now) return;
+
+  if (pending > 0) {
+    // visit each slot at most once, even when advancing by more than a revolution.
+    long from = now + 1;
+    if (to - from >= static_cast<long>(Slots)) from = to - Slots + 1;
+
+    for (long t = from; t <= to && pending > 0; t++) {
+      auto s = slot(t);
+      if (!is_occupied(s)) continue;
+
+      // hand out the due items, keeping the others (in order) for a later revolution.
+      remove_from(s, [&f, to] (node_t& node) {
+                       if (node.tick > to) return false;
+
+                       f(node.tick, node.item);
+                       return true;
+                     });
+    }
+  }
+
+  now = to;
+}
+
+template<typename T, std::size_t Slots>
+template<typename F>
+void TimingWheel<T, Slots>::flush(F&& f) {
+  if (pending == 0) return;
+
+  each_occupied([this, &f] (std::size_t s) {
+                  remove_from(s, [&f] (node_t& node) {
+                                   f(node.tick, node.item);
+                                   return true;
+                                 });
+                });
+}
+
+template<typename T, std::size_t Slots>
+template<typename F>
+void TimingWheel<T, Slots>::visit(long tick, F&& f) const {
+  if (pending == 0) return;
+
+  // the slot is shared with the items of other revolutions.
+  for (auto idx = heads[slot(tick)]; idx != none; idx = nodes[idx].next) {
+    if (nodes[idx].tick == tick) f(nodes[idx].tick, nodes[idx].item);
+  }
+}
+
+template<typename T, std::size_t Slots>
+template<typename P>
+void TimingWheel<T, Slots>::remove_if(P&& pred) {
+  if (pending == 0) return;
+
+  each_occupied([this, &pred] (std::size_t s) {
+                  remove_from(s, [&pred] (const node_t& node) { return pred(node.tick, node.item); });
+                });
+}
+
+#endif
@@ -1,9 +1,35 @@
 #include <thread>
 #include <chrono>
 
+#ifdef __linux__
+#include <time.h>
+#include <errno.h>
+#endif
+
 #include "anemone/util/wait.hpp"
 
 
 void wait_for(unsigned int ms) {
   std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 };
+
+void wait_until(std::chrono::steady_clock::time_point deadline, std::chrono::microseconds spin) {
+  auto wake = deadline - spin;
+
+  if (wake > std::chrono::steady_clock::now()) {
+#ifdef __linux__
+    // steady_clock is CLOCK_MONOTONIC on linux, so we can sleep against the absolute
+    // deadline directly and retry if we are interrupted by a signal.
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wake.time_since_epoch()).count();
+    struct timespec ts = { .tv_sec  = static_cast<time_t>(ns / 1000000000),
+                           .tv_nsec = static_cast<long>(ns % 1000000000),
+    };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+#else
+    std::this_thread::sleep_until(wake);
+#endif
+  }
+
+  // busy-wait for whatever is left.
+  while (std::chrono::steady_clock::now() < deadline) {}
+};
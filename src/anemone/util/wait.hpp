@@ -1,6 +1,8 @@
 #ifndef ANEMONE_UTIL_WAIT_H
 #define ANEMONE_UTIL_WAIT_H
 
+#include <chrono>
+
 
 /// @brief waits for the specified amount of milliseconds within the current thread.
 ///
@@ -8,4 +10,18 @@
 ///
 void wait_for(unsigned int ms);
 
+/// @brief waits until an absolute deadline on the monotonic clock.
+///
+/// @param deadline   the `steady_clock` time point to wait until.
+/// @param spin       how long before the deadline to stop sleeping and busy-wait.
+///
+/// @details
+/// sleeping is cheap but the kernel may wake us up late, while busy-waiting is
+/// precise but burns cpu. so we sleep against the absolute deadline minus the spin
+/// window and then busy-wait for the remainder. since the deadline is absolute,
+/// however long the caller took before calling this doesn't accumulate as drift.
+///
+void wait_until(std::chrono::steady_clock::time_point deadline,
+                std::chrono::microseconds spin = std::chrono::microseconds(0));
+
 #endif
@@ -3,6 +3,7 @@
 
 #include "anemone/io.hpp"
 #include "anemone/anemone.hpp"
+#include "anemone/render/render.hpp"
 
 #include <execinfo.h>
 #include <signal.h>
@@ -25,15 +26,25 @@ void seg_fault_handler(int sig) {
 int main(int argc, char *argv[]) {
   signal(SIGSEGV, seg_fault_handler);
 
+  // offline render: anemone <config> render <project> <midi file>
+  if ( argc == 5 && std::string(argv[2]) == "render" ) {
+    Renderer renderer(argv[1], argv[3]);
+
+    return renderer.render(argv[4]) ? 0 : 1;
+  }
+
   if ( argc != 2 ) {
     std::cout << "Error: you must provide the path to the configuration file!\n";
+    std::cout << "usage: anemone <config>\n";
+    std::cout << "       anemone <config> render <project> <midi file>\n";
     return -1;
   }
 
 
   Anemone anemone(argv[1],
                   std::make_shared<Monome>(),
-                  std::make_shared< MidiDeviceFactoryFor<RTMidiIn, RTMidiOut> >());
+                  std::make_shared< MidiDeviceFactoryFor<RTMidiIn, RTMidiOut> >(),
+                  std::make_shared<SystemClock>());
 
   anemone.run();
 
@@ -0,0 +1,93 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include "anemone/rx.hpp"
+#include "anemone/types.hpp"
+#include "anemone/io/clock/clock.hpp"
+#include "anemone/io/clock/device/system.hpp"
+
+
+namespace {
+  using namespace std::chrono;
+
+  /// @brief how long each clock runs for.
+  const auto run_duration = seconds(10);
+
+  /// @brief simulated cost of the tick fan-out (step controller, ui, midi out...).
+  const auto fan_out_cost = microseconds(250);
+
+  const double bpm = 120;
+
+  /// @brief records tick timestamps and reports drift relative to the ideal grid.
+  struct drift_recorder_t {
+    nanoseconds period = nanoseconds(static_cast<long>((60.0 * 1e9) / (bpm * (double)PPQN::Max)));
+    steady_clock::time_point first;
+    steady_clock::time_point last;
+    unsigned long ticks = 0;
+
+    void on_tick() {
+      auto now = steady_clock::now();
+      if (ticks == 0) first = now;
+      last = now;
+      ticks++;
+
+      // simulate subscriber work.
+      while (steady_clock::now() - now < fan_out_cost) {}
+    }
+
+    /// @brief drift of the last tick relative to where it should be, in µs/minute.
+    double drift_per_minute() {
+      auto actual   = duration_cast<nanoseconds>(last - first);
+      auto expected = period * static_cast<long>(ticks - 1);
+      auto drift    = duration<double, std::micro>(actual - expected).count();
+
+      return drift * (60.0 / duration<double>(actual).count());
+    }
+  };
+}
+
+
+TEST_CASE( "clock drift per minute: absolute deadlines vs. relative sleeps", "[benchmark][clock]" ) {
+
+  // the previous clock loop, which slept for a period relative to when the fan-out finished.
+  drift_recorder_t legacy;
+  {
+    auto period = microseconds(static_cast<int>((60 * 1000 * 1000)/(bpm * (float)PPQN::Max)));
+    auto start  = steady_clock::now();
+    while (steady_clock::now() - start < run_duration) {
+      auto t1 = high_resolution_clock::now();
+
+      legacy.on_tick();
+
+      auto t2 = high_resolution_clock::now();
+      auto wait = period - duration_cast<microseconds>(t1 - t2);
+
+      std::this_thread::sleep_for(wait);
+    }
+  }
+
+  // the deadline scheduled clock.
+  drift_recorder_t deadline;
+  {
+    auto clock = std::make_shared<Clock>(std::make_shared<SystemClock>(),
+                                         Clock::settings_t{ .spin = microseconds(300), .catch_up = PPQN::Max },
+                                         rx::behavior<double>(bpm).get_observable());
+
+    clock->connect().subscribe([&deadline] (tick_t) { deadline.on_tick(); });
+
+    std::this_thread::sleep_for(run_duration);
+    clock->disconnect();
+    clock->log_stats(false);
+  }
+
+  spdlog::info("clock drift @ {} bpm, {} ppqn, {}µs fan-out:", bpm, PPQN::Max, fan_out_cost.count());
+  spdlog::info("  relative sleep loop   {:>12.1f} µs/min ({} ticks)", legacy.drift_per_minute(), legacy.ticks);
+  spdlog::info("  absolute deadlines    {:>12.1f} µs/min ({} ticks)", deadline.drift_per_minute(), deadline.ticks);
+
+  REQUIRE( std::abs(deadline.drift_per_minute()) < std::abs(legacy.drift_per_minute()) );
+}
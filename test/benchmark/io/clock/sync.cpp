@@ -0,0 +1,140 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include <catch.hpp>
+#include <spdlog/spdlog.h>
+#include <yaml-cpp/yaml.h>
+
+#include "anemone/rx.hpp"
+#include "anemone/types.hpp"
+#include "anemone/config.hpp"
+#include "anemone/io/midi/midi.hpp"
+#include "anemone/io/midi/scheduler.hpp"
+#include "anemone/io/clock/clock.hpp"
+#include "anemone/io/clock/device/system.hpp"
+
+
+namespace {
+  using namespace std::chrono;
+
+  /// @brief how long the clock runs for.
+  const auto run_duration = seconds(5);
+
+  /// @brief how long the output takes to send a message.
+  const auto write_cost = microseconds(20);
+
+  /// @brief number of notes in the burst sent around every midi clock message.
+  const unsigned int burst_size = 32;
+
+  const double bpm = 120;
+
+  /// @brief midi output which takes a while to send each message, and records when
+  /// midi clock messages are sent.
+  class SlowOutput : public MidiOutputDevice {
+  public:
+    SlowOutput(std::string name) : device_name(name) { pulses.reserve(1024); };
+
+    void connect() override {};
+    std::map<std::string, unsigned int> list_devices() override { return {}; };
+    std::string name() override { return device_name; };
+
+    void emit(midi_data_t data) override {
+      auto now = steady_clock::now();
+      if (data[0] == static_cast<unsigned char>(MidiSync::TimingClock)) pulses.push_back(now);
+      while (steady_clock::now() - now < write_cost) {}
+    };
+
+    void emit(midi_sysex_t) override {};
+
+    std::vector<steady_clock::time_point> pulses;
+
+  private:
+    std::string device_name;
+  };
+
+  class SlowOutputFactory : public MidiDeviceFactory {
+  public:
+    std::shared_ptr<MidiInputDevice> make_input(std::string, rx::subscriber<midi_event_t>) override {
+      return nullptr;
+    };
+
+    std::shared_ptr<MidiOutputDevice> make_output(std::string name) override {
+      output = std::make_shared<SlowOutput>(name);
+      return output;
+    };
+
+    std::shared_ptr<SlowOutput> output;
+  };
+
+  /// @brief jitter (absolute deviation from the ideal grid) of a series of timestamps, in µs.
+  std::vector<double> jitter(std::vector<steady_clock::time_point> timestamps, nanoseconds period) {
+    std::vector<double> result;
+    for (unsigned long i = 0; i < timestamps.size(); i++) {
+      auto ideal = timestamps[0] + (period * static_cast<long>(i));
+      result.push_back(std::abs(duration<double, std::micro>(timestamps[i] - ideal).count()));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+}
+
+
+TEST_CASE( "midi clock output jitter while note bursts contend the same output", "[benchmark][clock]" ) {
+  auto pulse_period = nanoseconds(static_cast<long>((60.0 * 1e9) / (bpm * (double)MIDI_CLOCK_PPQN)));
+
+  auto factory = std::make_shared<SlowOutputFactory>();
+  auto config  = std::make_shared<Config>(YAML::Load("ports: { midi: { in: [], out: [ { name: synth, clock: true } ] } }"), "");
+  auto midi    = std::make_shared<Midi>(config, factory);
+
+  {
+    auto scheduler = std::make_shared<MidiScheduler>(MidiScheduler::settings_t{ .lookahead = duration_cast<microseconds>(pulse_period * 2),
+                                                                                .spin      = microseconds(200) },
+                                                     midi);
+    auto clock = std::make_shared<Clock>(std::make_shared<SystemClock>(),
+                                         Clock::settings_t{ .spin = microseconds(300), .catch_up = PPQN::Max },
+                                         rx::behavior<double>(bpm).get_observable());
+
+    clock->sync_events()
+      .subscribe([scheduler] (clock_sync_t sync) {
+                   scheduler->schedule_sync(sync.data, sync.due);
+                 });
+
+    scheduler->connect();
+
+    // on every midi clock, schedule a burst of notes starting just before the midi
+    // clock two pulses later, so that the clock message is due in the middle of it.
+    unsigned long ticks = 0;
+    auto tick_events = clock->connect();
+    tick_events.subscribe([&ticks, scheduler, pulse_period] (tick_t) {
+                            if (ticks++ % (PPQN::Max / MIDI_CLOCK_PPQN) != 0) return;
+
+                            auto due = steady_clock::now() + (pulse_period * 2) - microseconds(100);
+                            for (unsigned int i = 0; i < burst_size; i++) {
+                              scheduler->schedule({ .due   = due,
+                                                    .event = { .source = "", .destination = "", .data = midi_note_on(60, 0, 100) },
+                                                    .owner = nullptr });
+                            }
+                          });
+
+    std::this_thread::sleep_for(run_duration);
+    clock->disconnect();
+    scheduler->disconnect();
+  }
+
+  // skip the first beat while things settle.
+  auto pulses = factory->output->pulses;
+  pulses.erase(pulses.begin(), pulses.begin() + MIDI_CLOCK_PPQN);
+  auto j = jitter(pulses, pulse_period);
+
+  spdlog::info("midi clock jitter @ {} bpm with {} note bursts on the same output ({} clocks):", bpm, burst_size, j.size());
+  spdlog::info("  median  {:>8.1f} µs", j[j.size() / 2]);
+  spdlog::info("  p99     {:>8.1f} µs", j[(j.size() * 99) / 100]);
+  spdlog::info("  max     {:>8.1f} µs", j.back());
+
+  // the jitter depends on the host (and the bursts), so it is only reported.
+  REQUIRE( !j.empty() );
+}
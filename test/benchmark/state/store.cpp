@@ -0,0 +1,87 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include "anemone/types.hpp"
+#include "anemone/state/store/store.hpp"
+
+
+namespace {
+  using namespace std::chrono;
+
+  /// @brief the number of mutations made by each thread.
+  const unsigned int mutations = 20000;
+
+  /// @brief mutates a part from a few threads at once (e.g. the grid, midi & clock
+  /// threads), and gives the time taken per mutation, in ns.
+  template <typename F>
+  double per_mutation(unsigned int threads, F&& mutate) {
+    std::vector<std::thread> mutators;
+
+    auto start = steady_clock::now();
+    for (unsigned int t = 0; t < threads; t++) {
+      mutators.emplace_back([&mutate, t] {
+                              for (unsigned int i = 0; i < mutations; i++) mutate(t, i);
+                            });
+    }
+    for (auto& m : mutators) m.join();
+
+    return duration<double, std::nano>(steady_clock::now() - start).count() / (threads * mutations);
+  }
+}
+
+TEST_CASE( "mutation throughput: concurrent writers vs. single writer store", "[benchmark][state]" ) {
+  const PPQN rates[] = { PPQN::One, PPQN::Two, PPQN::Four, PPQN::Eight };
+
+  for (unsigned int threads : { 1, 2, 4 }) {
+    // each mutation sets a part's ppqn & page, as the grid controllers do.
+    auto mutation = [&rates] (std::shared_ptr<Part> part, unsigned int i) {
+                      part->ppqn.current.get_subscriber().on_next(rates[i % 4]);
+                      part->page.rendered.get_subscriber().on_next(i % 4);
+                    };
+
+    // every thread mutates the part itself, contending on its subjects.
+    auto concurrent_part = std::make_shared<Part>(0);
+    unsigned long concurrent_notifications = 0;
+    concurrent_part->page.rendered.get_observable().subscribe([&concurrent_notifications] (page_idx_t) {
+                                                                 concurrent_notifications++;
+                                                               });
+
+    auto concurrent = per_mutation(threads, [&] (unsigned int, unsigned int i) {
+                                              mutation(concurrent_part, i);
+                                            });
+
+    // every thread dispatches its mutations to the store's writer.
+    auto store_part = std::make_shared<Part>(0);
+    unsigned long store_notifications = 0;
+    store_part->page.rendered.get_observable().subscribe([&store_notifications] (page_idx_t) {
+                                                           store_notifications++;
+                                                         });
+
+    Store store;
+    store.start();
+
+    auto dispatched = per_mutation(threads, [&] (unsigned int, unsigned int i) {
+                                              store.dispatch([&mutation, store_part, i] { mutation(store_part, i); });
+                                            });
+
+    // the time until every mutation has been applied.
+    auto start = steady_clock::now();
+    store.dispatch([] {});
+    store.stop();
+    auto applied = dispatched + duration<double, std::nano>(steady_clock::now() - start).count() / (threads * mutations);
+
+    spdlog::info("mutation throughput with {} writing thread(s):", threads);
+    spdlog::info("  concurrent writers  {:>8.1f} ns/mutation", concurrent);
+    spdlog::info("  single writer store {:>8.1f} ns/mutation dispatched {:>8.1f} ns/mutation applied {:>6.1f} mutations/batch",
+                 dispatched, applied, (double)store.applied() / store.batches());
+
+    // the store's subscribers (e.g. the ui) are told about each mutation once.
+    REQUIRE( store.applied() == threads * mutations + 1 );
+    REQUIRE( store_notifications == concurrent_notifications );
+  }
+}
@@ -0,0 +1,451 @@
+#include <map>
+#include <malloc.h>
+#include <algorithm>
+#include <set>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+#include <catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include "anemone/types.hpp"
+
+
+namespace {
+  using namespace std::chrono;
+
+  /// @brief the length of the benchmarked sequences, in steps.
+  const unsigned int steps = 64;
+
+  /// @brief how many times each sequence is played through.
+  const unsigned int cycles = 10;
+
+  /// @brief fills a sequence with notes on every `every` steps, with `layers` voices each.
+  ///
+  /// @remark voices are put on different midi channels so they land on different layers.
+  ///
+  void fill(Sequence& sequence, unsigned int every, unsigned int layers) {
+    for (step_idx_t step = 0; step < steps; step += every) {
+      sequence_layer_t layer;
+      for (unsigned char voice = 0; voice < layers; voice++) {
+        step_event_t event(step_event_protocol_t::Midi,
+                           { (unsigned char)(0x90 | voice), (unsigned char)(0x70 | voice), 100 });
+        layer.insert_or_assign(event.id, event);
+      }
+
+      sequence.add_midi_note_events_at({ .page = step / 16, .step = step % 16 }, step * PPQN::Max, layer);
+    }
+  }
+
+  /// @brief the previous lookup, which copied each sequence map and used exceptions to
+  /// find out that a step or layer was empty.
+  void legacy_collect_events_at(sequence_t sequence,
+                                granular_step_idx_t step,
+                                const std::vector<step_event_id_t> &selected_layers,
+                                std::vector<step_event_t>& results)
+  {
+    try {
+      auto layers_at_step = sequence.at(step);
+
+      if (selected_layers.size() == 0) {
+        for (auto itr : layers_at_step) {
+          results.push_back(itr.second);
+        }
+        return;
+      }
+
+      for (auto layer_id : selected_layers) {
+        try {
+          results.push_back(layers_at_step.at(layer_id));
+        } catch (std::out_of_range &error) {}
+      }
+
+    } catch (std::out_of_range &error) {}
+  }
+
+  std::vector<step_event_t> legacy_get_events_at(Sequence& sequence,
+                                                 granular_step_idx_t step,
+                                                 const std::vector<step_event_id_t> &layers = {})
+  {
+    std::vector<step_event_t> step_events;
+
+    legacy_collect_events_at(sequence.midi_on, step, layers, step_events);
+    legacy_collect_events_at(sequence.midi_cc, step, layers, step_events);
+    legacy_collect_events_at(sequence.midi_nrpn, step, layers, step_events);
+
+    return step_events;
+  }
+
+  /// @brief bytes held by the legacy rendered steps containers.
+  std::size_t legacy_bytes = 0;
+
+  /// @brief an allocator which counts the bytes held by the legacy rendered steps.
+  template <typename T>
+  struct counting_allocator_t {
+    typedef T value_type;
+
+    counting_allocator_t() = default;
+    template <typename U> counting_allocator_t(const counting_allocator_t<U>&) {};
+
+    T* allocate(std::size_t n) {
+      legacy_bytes += n * sizeof(T);
+      return std::allocator<T>().allocate(n);
+    };
+
+    void deallocate(T* p, std::size_t n) {
+      legacy_bytes -= n * sizeof(T);
+      std::allocator<T>().deallocate(p, n);
+    };
+
+    template <typename U> bool operator==(const counting_allocator_t<U>&) const { return true; };
+    template <typename U> bool operator!=(const counting_allocator_t<U>&) const { return false; };
+  };
+
+  /// @brief the previous rendered steps, a set of steps per page.
+  typedef std::set<page_relative_step_idx_t,
+                   std::less<page_relative_step_idx_t>,
+                   counting_allocator_t<page_relative_step_idx_t> > legacy_page_t;
+  typedef std::map<page_idx_t,
+                   legacy_page_t,
+                   std::less<page_idx_t>,
+                   counting_allocator_t<std::pair<const page_idx_t, legacy_page_t> > > legacy_rendered_steps_t;
+
+  /// @brief plays a sequence through, tick by tick, and reports the average cost of a tick.
+  template <typename F>
+  double per_tick(F&& tick, unsigned long& events) {
+    auto ticks = steps * PPQN::Max;
+    auto start = steady_clock::now();
+
+    for (unsigned int cycle = 0; cycle < cycles; cycle++) {
+      for (granular_step_idx_t step = 0; step < ticks; step++) {
+        events += tick(step);
+      }
+    }
+
+    return duration<double, std::nano>(steady_clock::now() - start).count() / (cycles * ticks);
+  }
+
+  /// @brief the playing parts in the tick path benchmark (16 instruments × 8 parts).
+  const unsigned int parts = 16 * 8;
+
+  /// @brief plays `parts` copies of a sequence through together and reports the average
+  /// cost of a tick, i.e. of moving every part to its next step.
+  template <typename F>
+  double per_tick_all_parts(F&& tick, unsigned long& events) {
+    auto ticks = steps * PPQN::Max;
+    auto start = steady_clock::now();
+
+    for (unsigned int cycle = 0; cycle < cycles; cycle++) {
+      for (granular_step_idx_t step = 0; step < ticks; step++) {
+        for (unsigned int part = 0; part < parts; part++) {
+          events += tick(part, step);
+        }
+      }
+    }
+
+    return duration<double, std::nano>(steady_clock::now() - start).count() / (cycles * ticks);
+  }
+
+  void compare_tick_path(std::string name, unsigned int every, unsigned int layers) {
+    std::vector<Sequence> sequences(parts);
+    for (auto& sequence : sequences) fill(sequence, every, layers);
+
+    // looking each step up in the compiled schedule.
+    unsigned long search_events = 0;
+    auto search = per_tick_all_parts([&sequences] (unsigned int part, granular_step_idx_t step) {
+                                       auto schedule = sequences[part].schedule();
+                                       auto events   = Sequence::events_at(*schedule, step);
+                                       return (unsigned long)(events.end() - events.begin());
+                                     }, search_events);
+
+    // moving each part's cursor forward.
+    unsigned long cursor_events = 0;
+    std::vector<schedule_cursor_t> cursors(parts);
+    auto cursor = per_tick_all_parts([&sequences, &cursors] (unsigned int part, granular_step_idx_t step) {
+                                       auto schedule = sequences[part].schedule();
+                                       auto events = cursors[part].advance(*schedule, step);
+                                       return (unsigned long)(events.end() - events.begin());
+                                     }, cursor_events);
+
+    spdlog::info("{} sequences x {} parts:", name, parts);
+    spdlog::info("  schedule search       {:>8.1f} ns/tick", search);
+    spdlog::info("  schedule cursor       {:>8.1f} ns/tick", cursor);
+
+    REQUIRE( search_events == cursor_events );
+  }
+
+  void compare(std::string name, unsigned int every, unsigned int layers) {
+    Sequence sequence;
+    fill(sequence, every, layers);
+
+    // the previous path, which looks the step up in each of the sequence maps.
+    unsigned long map_events = 0;
+    auto map = per_tick([&sequence] (granular_step_idx_t step) {
+                          unsigned long bytes = 0;
+                          for (auto event : legacy_get_events_at(sequence, step)) {
+                            midi_data_t data = event.data;
+                            bytes += data.size();
+                          }
+                          return bytes;
+                        }, map_events);
+
+    // the compiled path, as the step controller reads it.
+    unsigned long compiled_events = 0;
+    auto compiled = per_tick([&sequence] (granular_step_idx_t step) {
+                               unsigned long bytes = 0;
+                               auto schedule = sequence.schedule();
+                               for (auto& event : Sequence::events_at(*schedule, step)) {
+                                 bytes += event.data.size();
+                               }
+                               return bytes;
+                             }, compiled_events);
+
+    spdlog::info("{} sequence ({} steps, a step every {}, {} layers):", name, steps, every, layers);
+    spdlog::info("  map lookup            {:>8.1f} ns/tick", map);
+    spdlog::info("  compiled schedule     {:>8.1f} ns/tick", compiled);
+
+    REQUIRE( map_events == compiled_events );
+    REQUIRE( compiled < map );
+  }
+}
+
+
+TEST_CASE( "per tick cost of sequence playback: maps vs. compiled schedule", "[benchmark][sequence]" ) {
+  compare("sparse", 4, 1);
+  compare("dense", 1, 8);
+}
+
+TEST_CASE( "per tick cost of the tick path across sequence densities", "[benchmark][sequence]" ) {
+  compare_tick_path("empty", steps, 0);
+  compare_tick_path("sparse", 4, 1);
+  compare_tick_path("dense", 1, 8);
+}
+
+TEST_CASE( "per tick cost of looking up step events: copies & exceptions vs. views", "[benchmark][sequence]" ) {
+  Sequence sequence;
+  fill(sequence, 4, 8);
+
+  // the layers of two of the voices.
+  std::vector<step_event_id_t> layers = { 0x9171, 0x9373 };
+
+  for (auto filtered : { false, true }) {
+    const std::vector<step_event_id_t> selected = filtered ? layers : std::vector<step_event_id_t>{};
+
+    unsigned long legacy_events = 0;
+    auto legacy = per_tick([&sequence, &selected] (granular_step_idx_t step) {
+                             return (unsigned long)legacy_get_events_at(sequence, step, selected).size();
+                           }, legacy_events);
+
+    unsigned long view_events = 0;
+    auto view = per_tick([&sequence, &selected] (granular_step_idx_t step) {
+                           unsigned long events = 0;
+                           for (auto& event : sequence.events_at(step, selected)) events += event.data.size() > 0;
+                           return events;
+                         }, view_events);
+
+    spdlog::info("step event lookup ({}):", filtered ? "two layers" : "all layers");
+    spdlog::info("  copies & exceptions   {:>8.1f} ns/tick", legacy);
+    spdlog::info("  view                  {:>8.1f} ns/tick", view);
+
+    REQUIRE( legacy_events == view_events );
+    REQUIRE( view < legacy );
+  }
+}
+
+TEST_CASE( "memory & page render cost of rendered steps: sets vs. bitmasks", "[benchmark][sequence]" ) {
+  // 64 pages x 16 parts x 8 instruments, with a step rendered every other step.
+  const unsigned int pages = 64, page_size = 16, all_parts = 16 * 8;
+
+  std::vector<legacy_rendered_steps_t> legacy(all_parts);
+  std::vector<RenderedSteps> rendered(all_parts);
+
+  for (unsigned int part = 0; part < all_parts; part++) {
+    for (page_idx_t page = 0; page < pages; page++) {
+      for (page_relative_step_idx_t step = 0; step < page_size; step += 2) {
+        legacy[part][page].insert(step);
+        rendered[part].set({ .page = page, .step = step });
+      }
+    }
+  }
+
+  // rendering a page, i.e. visiting each of its rendered steps.
+  const unsigned int renders = 1000;
+
+  unsigned long legacy_steps = 0;
+  auto start = steady_clock::now();
+  for (unsigned int i = 0; i < renders; i++) {
+    auto& page = legacy[i % all_parts].find(i % pages)->second;
+    std::vector<page_relative_step_idx_t> steps(page.begin(), page.end());
+    for (auto step : steps) legacy_steps += step + 1;
+  }
+  auto legacy_render = duration<double, std::nano>(steady_clock::now() - start).count() / renders;
+
+  unsigned long rendered_steps = 0;
+  start = steady_clock::now();
+  for (unsigned int i = 0; i < renders; i++) {
+    for (auto mask = rendered[i % all_parts].page(i % pages); mask != 0; mask &= mask - 1) {
+      rendered_steps += __builtin_ctzll(mask) + 1;
+    }
+  }
+  auto rendered_render = duration<double, std::nano>(steady_clock::now() - start).count() / renders;
+
+  std::size_t rendered_bytes = 0;
+  for (auto& part : rendered) rendered_bytes += part.bytes();
+
+  spdlog::info("rendered steps ({} pages x {} parts x {} instruments):", pages, 16, 8);
+  spdlog::info("  sets                  {:>8} KiB {:>8.1f} ns/page", legacy_bytes / 1024, legacy_render);
+  spdlog::info("  bitmasks              {:>8} KiB {:>8.1f} ns/page", rendered_bytes / 1024, rendered_render);
+
+  REQUIRE( legacy_steps == rendered_steps );
+  REQUIRE( rendered_bytes < 2 * 64 * 1024 );
+  REQUIRE( rendered_bytes < legacy_bytes );
+}
+
+TEST_CASE( "per tick cost of muting layers: id lists vs. layer masks", "[benchmark][sequence]" ) {
+  std::vector<Sequence> sequences(parts);
+  for (auto& sequence : sequences) fill(sequence, 1, 8);
+
+  // two of the voices are muted.
+  std::vector<step_event_id_t> muted = { 0x9171, 0x9373 };
+  auto audible = ~sequences[0].layers.mask(muted);
+
+  // the cursor plays everything.
+  unsigned long all_events = 0;
+  std::vector<schedule_cursor_t> all_cursors(parts);
+  auto all = per_tick_all_parts([&sequences, &all_cursors] (unsigned int part, granular_step_idx_t step) {
+                                  auto schedule = sequences[part].schedule();
+                                  auto events = all_cursors[part].advance(*schedule, step);
+                                  return (unsigned long)(events.end() - events.begin());
+                                }, all_events);
+
+  // each event's layer id is looked up in the muted ids.
+  unsigned long list_events = 0;
+  std::vector<schedule_cursor_t> list_cursors(parts);
+  auto list = per_tick_all_parts([&sequences, &list_cursors, &muted] (unsigned int part, granular_step_idx_t step) {
+                                   unsigned long events = 0;
+                                   auto schedule = sequences[part].schedule();
+                                   for (auto& event : list_cursors[part].advance(*schedule, step)) {
+                                     events += std::find(muted.begin(), muted.end(), event.id) == muted.end();
+                                   }
+                                   return events;
+                                 }, list_events);
+
+  // each event's dense layer is tested against the audible layers.
+  unsigned long mask_events = 0;
+  std::vector<schedule_cursor_t> mask_cursors(parts);
+  auto mask = per_tick_all_parts([&sequences, &mask_cursors, audible] (unsigned int part, granular_step_idx_t step) {
+                                   unsigned long events = 0;
+                                   auto schedule = sequences[part].schedule();
+                                   for (auto& event : mask_cursors[part].advance(*schedule, step)) {
+                                     events += (audible >> event.layer) & 1;
+                                   }
+                                   return events;
+                                 }, mask_events);
+
+  spdlog::info("muting 2 of 8 layers x {} parts:", parts);
+  spdlog::info("  nothing muted         {:>8.1f} ns/tick", all);
+  spdlog::info("  id lists              {:>8.1f} ns/tick", list);
+  spdlog::info("  layer masks           {:>8.1f} ns/tick", mask);
+
+  REQUIRE( list_events == mask_events );
+  REQUIRE( mask_events == all_events / 8 * 6 );
+}
+
+namespace {
+  /// @brief the heap memory in use, in bytes.
+  std::size_t heap_in_use() {
+    return mallinfo2().uordblks;
+  }
+
+  struct long_sequence_t {
+    std::size_t bytes;
+    double      edit;
+    double      tick;
+    double      redraw;
+  };
+
+  /// @brief measures a part of the provided length, with a note on every step.
+  long_sequence_t measure_long_sequence(unsigned int length) {
+    const unsigned int page_size = 16;
+
+    auto note = [] (std::string spn) {
+                  sequence_layer_t layer;
+                  auto event = step_event_t::make_midi_note_on(spn, 10, 100);
+                  layer.insert_or_assign(event.id, event);
+                  return layer;
+                };
+    auto c2 = note("c2"), d2 = note("d2");
+
+    auto before   = heap_in_use();
+    auto sequence = std::make_unique<Sequence>();
+    for (step_idx_t step = 0; step < length; step++) {
+      sequence->add_midi_note_events_at(absolute_to_paged_step(step, page_size), step * PPQN::Max, c2);
+    }
+
+    long_sequence_t measured;
+    measured.bytes = heap_in_use() - before;
+
+    // editing a step in the middle of the part, as pressing a step on the grid does.
+    const unsigned int edits = 1000;
+    auto middle = absolute_to_paged_step(length / 2, page_size);
+    auto start  = steady_clock::now();
+    for (unsigned int i = 0; i < edits; i++) {
+      sequence->add_midi_note_events_at(middle, (length / 2) * PPQN::Max, i % 2 ? c2 : d2);
+    }
+    measured.edit = duration<double, std::nano>(steady_clock::now() - start).count() / edits;
+
+    // playing the part through, as the step controller does.
+    auto ticks = length * PPQN::Max;
+    unsigned long events = 0;
+    schedule_cursor_t cursor;
+    start = steady_clock::now();
+    for (granular_step_idx_t step = 0; step < ticks; step++) {
+      auto schedule = sequence->schedule();
+      auto played = cursor.advance(*schedule, step);
+      events += played.end() - played.begin();
+    }
+    measured.tick = duration<double, std::nano>(steady_clock::now() - start).count() / ticks;
+
+    // redrawing each page, as the step sequence ui does.
+    auto pages = length / page_size;
+    unsigned long steps = 0;
+    start = steady_clock::now();
+    for (page_idx_t page = 0; page < pages; page++) {
+      for (auto mask = sequence->rendered_steps.page(page); mask != 0; mask &= mask - 1) {
+        steps += __builtin_ctzll(mask) + 1;
+      }
+    }
+    measured.redraw = duration<double, std::nano>(steady_clock::now() - start).count() / pages;
+
+    REQUIRE( events == length );
+    REQUIRE( sequence->rendered_steps.count() == length );
+
+    return measured;
+  }
+}
+
+TEST_CASE( "long sequences: edit latency, tick cost & memory at 256, 1024 & 4096 steps", "[benchmark][sequence]" ) {
+  std::map<unsigned int, long_sequence_t> measured;
+
+  spdlog::info("long sequences (a note on every step, 16 step pages):");
+  for (auto length : { 256u, 1024u, 4096u }) {
+    measured[length] = measure_long_sequence(length);
+
+    spdlog::info("  {:>4} steps  {:>6} KiB {:>6.0f} B/step {:>8.1f} ns/edit {:>6.1f} ns/tick {:>6.1f} ns/page",
+                 length,
+                 measured[length].bytes / 1024,
+                 (double)measured[length].bytes / length,
+                 measured[length].edit,
+                 measured[length].tick,
+                 measured[length].redraw);
+  }
+
+  // ticks & redraws don't depend on the length of the part, and neither does the memory
+  // taken per step.
+  REQUIRE( measured[4096].tick < 2 * measured[256].tick );
+  REQUIRE( measured[4096].redraw < 2 * measured[256].redraw );
+  REQUIRE( measured[4096].bytes / 4096 < 2 * measured[256].bytes / 256 );
+}
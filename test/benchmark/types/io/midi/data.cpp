@@ -0,0 +1,107 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include "anemone/types.hpp"
+
+
+namespace {
+  /// @brief heap allocations made so far (by anything in the benchmarks).
+  std::atomic<unsigned long> allocations { 0 };
+}
+
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+
+  if (auto p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+  /// @brief the length of the benchmarked sequence, in steps.
+  const unsigned int steps = 64;
+
+  /// @brief a midi event as it was before messages were kept inline.
+  struct legacy_midi_event_t {
+    std::string                source;
+    std::string                destination;
+    std::vector<unsigned char> data;
+  };
+
+  /// @brief stands in for a midi output, which is handed messages by value.
+  template <typename T>
+  __attribute__((noinline)) unsigned long emit(T data) {
+    return data.size();
+  }
+
+  /// @brief plays a sequence through, as the step controller does, and counts the heap
+  /// allocations made per tick.
+  template <typename F>
+  double allocations_per_tick(Sequence& sequence, F&& play, unsigned long& bytes) {
+    schedule_cursor_t cursor;
+
+    auto ticks  = steps * PPQN::Max;
+    auto before = allocations.load();
+
+    for (granular_step_idx_t step = 0; step < ticks; step++) {
+      auto schedule = sequence.schedule();
+      for (auto& event : cursor.advance(*schedule, step)) {
+        bytes += play(event);
+      }
+    }
+
+    return (double)(allocations.load() - before) / ticks;
+  }
+}
+
+TEST_CASE( "heap allocations on the playback path: vectors vs. inline messages", "[benchmark][midi]" ) {
+  // a chord on every step.
+  Sequence sequence;
+  for (step_idx_t step = 0; step < steps; step++) {
+    sequence_layer_t layer;
+    for (unsigned int voice = 0; voice < 8; voice++) {
+      auto event = step_event_t::make_midi_note_on("c3", voice + 1, 100);
+      layer.insert_or_assign(event.id, event);
+    }
+    sequence.add_midi_note_events_at({ .page = step / 16, .step = step % 16 }, step * PPQN::Max, layer);
+  }
+
+  // each event is made into a midi event, emitted, and has its note off made & emitted.
+  unsigned long legacy_bytes = 0;
+  auto legacy = allocations_per_tick(sequence, [] (const compiled_step_event_t& event) {
+                                       legacy_midi_event_t on = { .source      = "",
+                                                                  .destination = "",
+                                                                  .data        = { event.data.begin(), event.data.end() },
+                                       };
+                                       auto off = on.data;
+                                       off[0] -= 16;
+
+                                       return emit(on.data) + emit(off);
+                                     }, legacy_bytes);
+
+  unsigned long inline_bytes = 0;
+  auto inlined = allocations_per_tick(sequence, [] (const compiled_step_event_t& event) {
+                                        midi_event_t on = { .source      = "",
+                                                            .destination = "",
+                                                            .data        = event.data,
+                                        };
+
+                                        return emit(on.data) + emit(midi_note_off_from_on(on.data));
+                                      }, inline_bytes);
+
+  spdlog::info("heap allocations on the playback path ({} steps, a chord on every step):", steps);
+  spdlog::info("  vectors               {:>8.2f} allocs/tick", legacy);
+  spdlog::info("  inline messages       {:>8.2f} allocs/tick", inlined);
+
+  REQUIRE( legacy_bytes == inline_bytes );
+  REQUIRE( inlined == 0 );
+  REQUIRE( legacy > 0 );
+}
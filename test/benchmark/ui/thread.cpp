@@ -0,0 +1,92 @@
+#include <chrono>
+#include <thread>
+
+#include <catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include "anemone/types.hpp"
+#include "anemone/ui/thread.hpp"
+#include "anemone/util/histogram.hpp"
+#include "anemone/util/high_frequency.hpp"
+
+
+namespace {
+  using namespace std::chrono;
+
+  /// @brief the number of ticks played.
+  const unsigned int ticks = 2000;
+
+  /// @brief the period of a tick.
+  const microseconds period = microseconds(1000);
+
+  /// @brief a ui whose rendering of each cursor move redraws a row of leds on a slow
+  /// (serial) grid.
+  struct SlowGridUI {
+    unsigned long rendered = 0;
+
+    void render_cursor(granular_step_idx_t) {
+      std::this_thread::sleep_for(microseconds(300));
+      rendered++;
+    };
+  };
+
+  /// @brief plays ticks, moving the cursor on every 4th one, and records how late the
+  /// midi of those ticks is emitted (i.e. once the cursor has moved), in ns.
+  void play(HighFrequencyState<granular_step_idx_t>& cursor, Histogram& lateness) {
+    auto next = steady_clock::now();
+    for (unsigned int tick = 0; tick < ticks; tick++) {
+      next += period;
+      std::this_thread::sleep_until(next);
+
+      if (tick % 4 != 0) continue;
+
+      cursor.set(tick);
+
+      // the midi is emitted here.
+      lateness.record(duration_cast<nanoseconds>(steady_clock::now() - next).count());
+    }
+  }
+}
+
+TEST_CASE( "midi out jitter under heavy led activity: rendering on the tick thread vs. the ui thread", "[benchmark][ui]" ) {
+  // the cursor is rendered by the tick thread, before the midi is emitted.
+  SlowGridUI inline_ui;
+  HighFrequencyState<granular_step_idx_t> inline_cursor;
+  inline_cursor.subscribe([&inline_ui] (granular_step_idx_t step) { inline_ui.render_cursor(step); });
+
+  Histogram inline_lateness;
+  play(inline_cursor, inline_lateness);
+
+  // the cursor is handed over to the ui thread.
+  SlowGridUI threaded_ui;
+  UIThread ui_thread;
+  ui_thread.start();
+
+  HighFrequencyState<granular_step_idx_t> threaded_cursor;
+  threaded_cursor.subscribe([&ui_thread, &threaded_ui] (granular_step_idx_t step) {
+                              ui_thread.post<&SlowGridUI::render_cursor>(&threaded_ui, step);
+                            });
+
+  Histogram threaded_lateness;
+  play(threaded_cursor, threaded_lateness);
+  ui_thread.stop();
+
+  auto us = [] (std::uint64_t ns) { return ns / 1000.0; };
+
+  spdlog::info("midi out lateness on the ticks of a cursor move (with a 300us led redraw), every 4 ticks of {}us:", period.count());
+  spdlog::info("  rendered on the tick thread  mean {:>7.1f}us p50 {:>7.1f}us p99 {:>7.1f}us max {:>7.1f}us",
+               us(inline_lateness.mean()), us(inline_lateness.percentile(50)),
+               us(inline_lateness.percentile(99)), us(inline_lateness.max()));
+  spdlog::info("  rendered on the ui thread    mean {:>7.1f}us p50 {:>7.1f}us p99 {:>7.1f}us max {:>7.1f}us",
+               us(threaded_lateness.mean()), us(threaded_lateness.percentile(50)),
+               us(threaded_lateness.percentile(99)), us(threaded_lateness.max()));
+
+  // every move is rendered either way.
+  REQUIRE( inline_ui.rendered == ticks / 4 );
+  REQUIRE( threaded_ui.rendered == ticks / 4 );
+  REQUIRE( ui_thread.dropped() == 0 );
+
+  // the tick thread doesn't wait for the leds anymore (the tail is mostly down to
+  // the scheduler, so the median is compared).
+  REQUIRE( threaded_lateness.percentile(50) < inline_lateness.percentile(50) );
+}
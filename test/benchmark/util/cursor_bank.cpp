@@ -0,0 +1,118 @@
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include "anemone/rx.hpp"
+#include "anemone/types.hpp"
+#include "anemone/io/clock/tempo.hpp"
+#include "anemone/util/cursor_bank.hpp"
+
+
+namespace {
+  using namespace std::chrono;
+
+  /// @brief the number of parts playing at once.
+  const unsigned int parts = 256;
+
+  /// @brief the number of ticks the parts are played for.
+  const unsigned int ticks = 64 * PPQN::Max;
+
+  /// @brief makes parts of various lengths & rates (i.e. polymeters), with their cursor
+  /// observed, as it is by the grid.
+  std::vector<std::shared_ptr<Part>> make_parts(unsigned long& observed) {
+    const PPQN rates[] = { PPQN::One, PPQN::Two, PPQN::Four, PPQN::Eight, PPQN::Sixteen };
+
+    std::vector<std::shared_ptr<Part>> made;
+    for (unsigned int i = 0; i < parts; i++) {
+      auto part = std::make_shared<Part>(i);
+      part->ppqn.current.get_subscriber().on_next(rates[i % 5]);
+      part->step.last.get_subscriber().on_next(paged_step_idx_t{ .page = 0, .step = 3 + i % 13 });
+      part->step.current.subscribe([&observed] (granular_step_idx_t) { observed++; });
+      made.push_back(part);
+    }
+
+    return made;
+  }
+
+  /// @brief the mean time taken per tick by a function advancing all the parts.
+  template <typename F>
+  nanoseconds per_tick(F&& tick) {
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < ticks; i++) tick();
+
+    return duration_cast<nanoseconds>(steady_clock::now() - start) / ticks;
+  }
+}
+
+TEST_CASE( "per tick cost of advancing playing parts: behaviors vs. cursor bank", "[benchmark][step]" ) {
+  auto page_size = 16;
+
+  // each part's cursor is read from & written back to a behavior, as it was.
+  unsigned long behavior_notifications = 0;
+  auto behavior_parts = make_parts(behavior_notifications);
+
+  std::vector<rx::behavior<granular_step_idx_t>> behavior_cursors;
+  for (unsigned int i = 0; i < parts; i++) {
+    behavior_cursors.push_back(rx::behavior<granular_step_idx_t>(0));
+    behavior_cursors.back().get_observable().subscribe([&behavior_notifications] (granular_step_idx_t) {
+                                                          behavior_notifications++;
+                                                        });
+  }
+  behavior_notifications = 0;
+
+  auto behaviors = per_tick([&] {
+                              for (unsigned int i = 0; i < parts; i++) {
+                                auto& part = behavior_parts[i];
+                                auto  step = behavior_cursors[i].get_value();
+                                auto  last = part->step.last.get_value().to_absolute_idx(page_size) * PPQN::Max;
+                                auto  next = step > last - 1 ? 0 : step + part->ppqn.current.get_value();
+                                behavior_cursors[i].get_subscriber().on_next(next);
+                              }
+                            });
+
+  // the cursors live in a bank, and only the steps landed on are published.
+  unsigned long bank_notifications = 0;
+  auto bank_parts = make_parts(bank_notifications);
+  bank_notifications = 0;
+
+  CursorBank cursors(PPQN::Max);
+  std::vector<CursorBank::slot_t> slots;
+  for (auto& part : bank_parts) {
+    auto slot = cursors.add(part->step.cursor.load());
+    cursors.set_stride(slot, part->ppqn.current.get_value());
+    cursors.set_end(slot, part->step.last.get_value().to_absolute_idx(page_size) * PPQN::Max);
+    slots.push_back(slot);
+  }
+
+  auto bank = per_tick([&] {
+                         cursors.advance();
+                         for (unsigned int i = 0; i < parts; i++) {
+                           auto next = cursors.at(slots[i]);
+                           bank_parts[i]->step.cursor.store(next, std::memory_order_relaxed);
+                           if (cursors.moved(slots[i])) bank_parts[i]->step.current.set(next);
+                         }
+                       });
+
+  // both ways leave the parts in the same place.
+  bool same = true;
+  for (unsigned int i = 0; i < parts; i++) {
+    same &= behavior_cursors[i].get_value() == bank_parts[i]->step.cursor.load();
+  }
+
+  // the share of a core spent at 120 bpm.
+  auto period = TempoMap::period(120);
+  auto share  = [&period] (nanoseconds cost) { return 100.0 * cost.count() / period.count(); };
+
+  spdlog::info("per tick cost of advancing {} polymetric parts:", parts);
+  spdlog::info("  behaviors    {:>8} ns/tick {:>6.2f}% of a core @ 120bpm {:>8} notifications",
+               behaviors.count(), share(behaviors), behavior_notifications);
+  spdlog::info("  cursor bank  {:>8} ns/tick {:>6.2f}% of a core @ 120bpm {:>8} notifications",
+               bank.count(), share(bank), bank_notifications);
+
+  REQUIRE( same );
+  REQUIRE( bank_notifications < behavior_notifications );
+  REQUIRE( bank < behaviors );
+}
@@ -0,0 +1,168 @@
+#include <chrono>
+#include <memory>
+#include <tuple>
+
+#include <catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include "anemone/rx.hpp"
+#include "anemone/types.hpp"
+#include "anemone/util/high_frequency.hpp"
+#include "anemone/ui/page.hpp"
+#include "anemone/ui/step_sequence.hpp"
+
+
+namespace {
+  using namespace std::chrono;
+
+  /// @brief the number of cursor moves published.
+  const unsigned int moves = 100000;
+
+  /// @brief the number of times the observed part is switched.
+  const unsigned int switches = 10000;
+
+  const unsigned int page_size = 16;
+
+  /// @brief the mean time taken by a function, in ns.
+  template <typename F>
+  double mean(unsigned int times, F&& f) {
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < times; i++) f(i);
+
+    return duration<double, std::nano>(steady_clock::now() - start).count() / times;
+  }
+}
+
+TEST_CASE( "publishing the cursor to the step ui: behaviors vs. high frequency state", "[benchmark][state]" ) {
+  // the other (low frequency) values the step ui renders the cursor with.
+  rx::behavior<page_idx_t>       rendered_page(0);
+  rx::behavior<bool>             show_last(false);
+  rx::behavior<paged_step_idx_t> last_step(paged_step_idx_t{ .page = 3, .step = 15 });
+
+  // the cursor as a behavior, chained like the step ui chained it: switched on the
+  // rendered part and combined with the rest.
+  rx::behavior<granular_step_idx_t> cursors[2] = { rx::behavior<granular_step_idx_t>(0),
+                                                   rx::behavior<granular_step_idx_t>(0) };
+  rx::behavior<int> rendered_part(0);
+
+  unsigned long behavior_renders = 0;
+  auto current_step = rendered_part.get_observable()
+    | rx::map([&cursors] (int part) { return cursors[part].get_observable(); })
+    | rx::switch_on_next()
+    | rx::map([] (granular_step_idx_t step) { return granular_to_paged_step(step, page_size); });
+
+  rendered_page.get_observable()
+    .combine_latest(current_step, show_last.get_observable(), last_step.get_observable())
+    .subscribe([&behavior_renders] (std::tuple<page_idx_t, paged_step_idx_t, bool, paged_step_idx_t> p) {
+                 behavior_renders += std::get<1>(p).step == std::get<0>(p);
+               });
+
+  auto behavior_publish = mean(moves, [&cursors] (unsigned int i) {
+                                        cursors[0].get_subscriber().on_next(i * PPQN::Max);
+                                      });
+  auto behavior_switch = mean(switches, [&rendered_part] (unsigned int i) {
+                                          rendered_part.get_subscriber().on_next((i + 1) % 2);
+                                        });
+  auto behavior_unobserved = mean(moves, [&cursors] (unsigned int i) {
+                                           cursors[1].get_subscriber().on_next(i * PPQN::Max);
+                                         });
+
+  // the cursor as high frequency state, observed directly with the latest low
+  // frequency values.
+  HighFrequencyState<granular_step_idx_t> states[2];
+
+  unsigned long state_renders = 0;
+  auto render = [&state_renders, &rendered_page] (granular_step_idx_t step) {
+                  state_renders += granular_to_paged_step(step, page_size).step == rendered_page.get_value();
+                };
+
+  auto observed     = 0;
+  auto subscription = states[observed].subscribe(render);
+
+  auto state_publish = mean(moves, [&states] (unsigned int i) {
+                                     states[0].set(i * PPQN::Max);
+                                   });
+  auto state_switch = mean(switches, [&] (unsigned int i) {
+                                       states[observed].unsubscribe(subscription);
+                                       observed     = (i + 1) % 2;
+                                       subscription = states[observed].subscribe(render);
+                                     });
+  auto state_unobserved = mean(moves, [&states] (unsigned int i) {
+                                        states[1].set(i * PPQN::Max);
+                                      });
+
+  spdlog::info("publishing the cursor to the step ui:");
+  spdlog::info("  behaviors             {:>8.1f} ns/move {:>8.1f} ns/switch {:>8.1f} ns/unobserved move",
+               behavior_publish, behavior_switch, behavior_unobserved);
+  spdlog::info("  high frequency state  {:>8.1f} ns/move {:>8.1f} ns/switch {:>8.1f} ns/unobserved move",
+               state_publish, state_switch, state_unobserved);
+
+  REQUIRE( behavior_renders > 0 );
+  REQUIRE( state_renders > 0 );
+  REQUIRE( state_publish < behavior_publish );
+  REQUIRE( state_switch < behavior_switch );
+  REQUIRE( state_unobserved < behavior_unobserved );
+}
+
+TEST_CASE( "cursor callbacks avoided by subscription predicates", "[benchmark][state]" ) {
+  // a long part, played for a while, rendered on its first page of a section of 8 pages.
+  const page_idx_t   pages         = 64;
+  const unsigned int section_pages = 8;
+  const unsigned int ticks         = 8 * pages * page_size * PPQN::Max;
+
+  // plays the part, setting the cursor & page in playback as the step controller does.
+  auto play = [&] (HighFrequencyState<granular_step_idx_t>& cursor, HighFrequencyState<page_idx_t>& page) {
+                auto start = steady_clock::now();
+                for (unsigned int tick = 0; tick < ticks; tick++) {
+                  granular_step_idx_t step = tick % (pages * page_size * PPQN::Max);
+                  if (step % PPQN::Max != 0) continue;
+
+                  cursor.set(step);
+
+                  page_idx_t playing_page = step / PPQN::Max / page_size;
+                  if (page.get() != playing_page) page.set(playing_page);
+                }
+
+                return duration<double, std::nano>(steady_clock::now() - start).count() / ticks;
+              };
+
+  auto observe = [] (unsigned long& calls) {
+                   return [&calls] (auto) { calls++; };
+                 };
+
+  // every move is told about, and filtered downstream.
+  HighFrequencyState<granular_step_idx_t> cursor;
+  HighFrequencyState<page_idx_t>          page;
+  unsigned long unguarded_cursor_calls = 0, unguarded_page_calls = 0;
+  cursor.subscribe(observe(unguarded_cursor_calls));
+  page.subscribe(observe(unguarded_page_calls));
+
+  auto unguarded = play(cursor, page);
+
+  // only the moves which show are told about.
+  HighFrequencyState<granular_step_idx_t> guarded_cursor;
+  HighFrequencyState<page_idx_t>          guarded_page;
+  unsigned long guarded_cursor_calls = 0, guarded_page_calls = 0;
+
+  auto on_rendered_page = std::make_shared<StepSequenceUI::CursorOnPage>(page_size);
+  on_rendered_page->follow(0, pages - 1);
+  guarded_cursor.subscribe(observe(guarded_cursor_calls), on_rendered_page);
+  guarded_page.subscribe(observe(guarded_page_calls),
+                         std::make_shared<PageUI::PageOnSection>(section_pages, guarded_page.get()));
+
+  auto guarded = play(guarded_cursor, guarded_page);
+
+  // per 1000 ticks.
+  auto rate = [&ticks] (unsigned long calls) { return 1000.0 * calls / ticks; };
+
+  spdlog::info("cursor callbacks of a {} page part, rendered on its first page:", pages);
+  spdlog::info("  unguarded  {:>8.2f} step ui + {:>6.3f} page ui callbacks/1000 ticks {:>6.1f} ns/tick",
+               rate(unguarded_cursor_calls), rate(unguarded_page_calls), unguarded);
+  spdlog::info("  guarded    {:>8.2f} step ui + {:>6.3f} page ui callbacks/1000 ticks {:>6.1f} ns/tick",
+               rate(guarded_cursor_calls), rate(guarded_page_calls), guarded);
+
+  // the cursor shows on one page out of 64 (and when leaving it), the page in playback
+  // on 8 pages out of 64 (and when leaving them).
+  REQUIRE( guarded_cursor_calls * pages == unguarded_cursor_calls * (page_size + 1) / page_size );
+  REQUIRE( guarded_page_calls * pages < unguarded_page_calls * (section_pages + 2) );
+}
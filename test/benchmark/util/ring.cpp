@@ -0,0 +1,110 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include <catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include "anemone/util/ring.hpp"
+#include "anemone/util/histogram.hpp"
+#include "anemone/util/concurrent_queue.hpp"
+
+
+namespace {
+  using namespace std::chrono;
+
+  /// @brief the number of items pushed by each producer.
+  const unsigned int items = 100000;
+
+  /// @brief an item, stamped when it is pushed.
+  struct item_t {
+    std::int64_t pushed_at = 0;
+  };
+
+  std::int64_t now() {
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+  }
+
+  struct result_t {
+    double    throughput;
+    Histogram latency;
+  };
+
+  /// @brief has producers push items as fast as they can while a consumer pops them,
+  /// and measures the throughput (items/s) and latency (ns from push to pop).
+  template <typename Push, typename Consume>
+  void run(unsigned int producers, Push&& push, Consume&& consume, result_t& result) {
+    std::vector<std::thread> pushers;
+
+    auto start = steady_clock::now();
+    for (unsigned int p = 0; p < producers; p++) {
+      pushers.emplace_back([&push] {
+                             for (unsigned int i = 0; i < items; i++) push(item_t{ .pushed_at = now() });
+                           });
+    }
+
+    unsigned long popped = 0;
+    auto record = [&result, &popped] (item_t item) {
+                    result.latency.record(now() - item.pushed_at);
+                    popped++;
+                  };
+    while (popped < producers * items) consume(record);
+
+    for (auto& p : pushers) p.join();
+
+    result.throughput = popped / duration<double>(steady_clock::now() - start).count();
+  }
+
+  void report(const char* name, result_t& result) {
+    spdlog::info("  {:<8} {:>6.2f}M items/s latency p50 {:>9.1f}us p99 {:>9.1f}us p99.9 {:>9.1f}us",
+                 name, result.throughput / 1e6,
+                 result.latency.percentile(50) / 1000.0,
+                 result.latency.percentile(99) / 1000.0,
+                 result.latency.percentile(99.9) / 1000.0);
+  }
+}
+
+TEST_CASE( "queue throughput & latency: Queue vs. lock-free rings at 1, 2 & 4 producers", "[benchmark][queue]" ) {
+  for (unsigned int producers : { 1, 2, 4 }) {
+    spdlog::info("{} producer(s), {} items each:", producers, items);
+
+    // a std::queue behind a mutex & condition variable, popped one at a time.
+    result_t queued;
+    Queue<item_t> queue;
+    run(producers,
+        [&queue] (item_t item) { queue.push(item); },
+        [&queue] (auto& record) { record(queue.pop()); },
+        queued);
+    report("Queue", queued);
+
+    // a bounded mpsc ring, drained in batches, producers yielding while it is full.
+    result_t mpsc;
+    MpscRing<item_t, 1024> ring;
+    run(producers,
+        [&ring] (item_t item) { while (!ring.try_push(item)) std::this_thread::yield(); },
+        [&ring] (auto& record) {
+          if (ring.drain(record) == 0) ring.wait(milliseconds(1));
+        },
+        mpsc);
+    report("MpscRing", mpsc);
+
+    REQUIRE( queued.latency.count() == producers * items );
+    REQUIRE( mpsc.latency.count() == producers * items );
+
+    if (producers > 1) continue;
+
+    // a bounded spsc ring, for a single producer.
+    result_t spsc;
+    SpscRing<item_t, 1024> spsc_ring;
+    run(producers,
+        [&spsc_ring] (item_t item) { while (!spsc_ring.try_push(item)) std::this_thread::yield(); },
+        [&spsc_ring] (auto& record) {
+          if (spsc_ring.drain(record) == 0) spsc_ring.wait(milliseconds(1));
+        },
+        spsc);
+    report("SpscRing", spsc);
+
+    REQUIRE( spsc.latency.count() == items );
+  }
+}
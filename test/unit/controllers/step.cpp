@@ -0,0 +1,114 @@
+#include <catch.hpp>
+
+#include <map>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "anemone/rx.hpp"
+#include "anemone/io.hpp"
+#include "anemone/types.hpp"
+#include "anemone/state.hpp"
+#include "anemone/config.hpp"
+#include "anemone/plugins.hpp"
+#include "anemone/controllers/step.hpp"
+
+
+SCENARIO( "a StepController ends every note it plays, even when the part is edited while playing" ) {
+  using namespace std::chrono;
+
+  GIVEN( "a part whose notes are rendered well ahead of time" ) {
+    auto config  = std::make_shared<Config>("./conf/config.yml");
+    auto plugins = std::make_shared<PluginManager>(config);
+    auto state   = std::make_shared<State>(State(config, plugins));
+    auto io      = std::make_shared<IO>(config,
+                                        std::make_shared<NullGrid>(),
+                                        std::make_shared< MidiDeviceFactoryFor<NullMidiIn, NullMidiOut> >(),
+                                        std::make_shared<VirtualClock>(VirtualClock::Mode::Stepped),
+                                        state);
+    state->connect();
+
+    // the ticks are played by hand, and are due long after they are rendered, so the
+    // part is always edited before any of its events are sent.
+    rx::subject<tick_t> ticks;
+    io->clock_events     = ticks.get_observable();
+    io->transport_events = rx::never<ClockTransport>();
+    io->scheduler        = std::make_shared<MidiScheduler>(MidiScheduler::settings_t{ .lookahead = milliseconds(20),
+                                                                                      .spin      = microseconds(100) },
+                                                           io->midi);
+    io->scheduler->connect();
+
+    auto start = steady_clock::now() + milliseconds(500);
+    auto tick  = [&ticks, start] (long i) {
+                   ticks.get_subscriber().on_next(tick_t{ .index  = i,
+                                                          .time   = start + milliseconds(i),
+                                                          .period = milliseconds(1) });
+                 };
+
+    // the state the tick engine plays from is set directly, as there are no deferred actions.
+    for (auto& itr : state->instruments->by_name) itr.second->playback.playing.store(false);
+
+    auto instrument = state->instruments->by_name.begin()->second;
+    auto part       = instrument->parts[0];
+    auto page_size  = state->layouts->sequencer->steps->size();
+
+    instrument->playback.part.store(part->id);
+    part->ppqn.in_playback.store(PPQN::Max);
+    part->step.last.get_subscriber().on_next(absolute_to_paged_step(16, page_size));
+
+    // notes 3 steps long on every other step, so they overlap the edits.
+    auto add_note = [part, page_size] (step_idx_t step) {
+                      sequence_layer_t layer;
+                      step_event_t note(step_event_protocol_t::Midi, midi_note_on(60 + step, 1, 100), 3 * PPQN::Max);
+                      layer.insert({ note.id, note });
+
+                      part->sequence.add_midi_note_events_at(absolute_to_paged_step(step, page_size), step * PPQN::Max, layer);
+                    };
+    for (step_idx_t step = 0; step < 16; step += 2) add_note(step);
+
+    StepController controller(io, state);
+
+    std::vector<midi_data_t> played;
+    instrument->playback_midi_events.get_observable()
+      .skip(1)
+      .subscribe([&played] (midi_event_t e) { played.push_back(e.data); });
+
+    instrument->playback.playing.store(true);
+
+    WHEN( "notes are added & removed while the part is played, and then it stops" ) {
+      for (long i = 0; i < 10; i++) tick(i);
+
+      part->sequence.remove_midi_note_events_at(absolute_to_paged_step(12, page_size), 12 * PPQN::Max);
+      add_note(13);
+
+      for (long i = 10; i < 40; i++) tick(i);
+
+      instrument->playback.playing.store(false);
+      tick(40);
+
+      std::this_thread::sleep_until(start + milliseconds(100));
+      io->scheduler->disconnect();
+
+      THEN( "each note on is ended by exactly one note off" ) {
+        std::map<int, int> sounding;
+        int  notes = 0;
+        bool once  = true;
+
+        for (auto& data : played) {
+          if ((data[0] & 0xF0) == 0x90) {
+            once &= sounding[data[1]]++ == 0;
+            notes++;
+          } else if ((data[0] & 0xF0) == 0x80) {
+            once &= --sounding[data[1]] == 0;
+          }
+        }
+        for (auto& note : sounding) once &= note.second == 0;
+
+        REQUIRE( notes > 0 );
+        REQUIRE( sounding.count(60 + 13) == 1 );
+        REQUIRE( once );
+      }
+    }
+  }
+}
@@ -0,0 +1,62 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "anemone/rx.hpp"
+#include "anemone/types.hpp"
+#include "anemone/io/clock/clock.hpp"
+#include "anemone/io/clock/device/system.hpp"
+
+
+SCENARIO( "a Clock can idle while nothing needs ticks" ) {
+  using namespace std::chrono;
+
+  GIVEN( "a running clock which may idle" ) {
+    auto clock = std::make_shared<Clock>(std::make_shared<SystemClock>(),
+                                         Clock::settings_t{ .spin = microseconds(0), .catch_up = PPQN::Max, .idle = true },
+                                         rx::behavior<double>(120).get_observable());
+
+    std::atomic<long> count = 0;
+    std::atomic<steady_clock::rep> last = 0;
+    clock->connect().subscribe([&count, &last] (tick_t) {
+                                 last = steady_clock::now().time_since_epoch().count();
+                                 count++;
+                               });
+    const auto period = nanoseconds(static_cast<long>((60.0 * 1e9) / (120 * (double)PPQN::Max)));
+
+    std::this_thread::sleep_for(milliseconds(50));
+    REQUIRE( count > 0 );
+
+    WHEN( "it is told to idle" ) {
+      clock->idle(true);
+      std::this_thread::sleep_for(milliseconds(30));
+
+      auto ticks   = count.load();
+      auto wakeups = clock->stats().wakeups.load();
+      std::this_thread::sleep_for(milliseconds(200));
+
+      THEN( "it stops waking up" ) {
+        REQUIRE( clock->is_idle() );
+        REQUIRE( count == ticks );
+        REQUIRE( clock->stats().wakeups == wakeups );
+      }
+
+      AND_WHEN( "it is no longer idle" ) {
+        auto resumed = steady_clock::now();
+        clock->idle(false);
+        while (count == ticks && steady_clock::now() - resumed < seconds(1)) std::this_thread::yield();
+
+        THEN( "the next tick is emitted within a tick period" ) {
+          REQUIRE( !clock->is_idle() );
+          REQUIRE( count > ticks );
+          REQUIRE( steady_clock::time_point(steady_clock::duration(last.load())) - resumed < period );
+        }
+      }
+    }
+
+    clock->disconnect();
+  }
+}
@@ -0,0 +1,80 @@
+#include <catch.hpp>
+
+#include <random>
+#include <chrono>
+#include <vector>
+
+#include "anemone/io/clock/pll.hpp"
+
+
+SCENARIO( "a PhaseLockedLoop can follow a jittery stream of pulses" ) {
+
+  GIVEN( "midi clock pulses at 120 bpm (24 ppqn) with up to ±1ms of jitter" ) {
+    using namespace std::chrono;
+
+    const auto period = nanoseconds(20833333); // 60s / (120 * 24)
+    const auto start  = steady_clock::now();
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<long> jitter(-1000000, 1000000);
+
+    PhaseLockedLoop pll;
+
+    WHEN( "nothing has been received" ) {
+      THEN( "it can't predict anything" ) {
+        REQUIRE( !pll.predict(0).has_value() );
+      }
+    }
+
+    WHEN( "a single pulse has been received" ) {
+      pll.pulse(start);
+
+      THEN( "it can only predict the past" ) {
+        REQUIRE( pll.predict(0).has_value() );
+        REQUIRE( !pll.predict(0.5).has_value() );
+      }
+    }
+
+    WHEN( "a few beats worth of pulses have been received" ) {
+      for (long i = 0; i < 96; i++) {
+        pll.pulse(start + (period * i) + nanoseconds(jitter(rng)));
+      }
+
+      THEN( "the period has converged" ) {
+        auto error = duration_cast<nanoseconds>(pll.period() - period).count();
+        REQUIRE( std::abs(error) < 100000 );
+      }
+
+      THEN( "upsampled ticks are evenly spaced" ) {
+        std::vector<steady_clock::time_point> ticks;
+        for (int i = 0; i <= 64; i++) {
+          ticks.push_back(*pll.predict(95 + (i * 24.0 / 64.0)));
+        }
+
+        for (std::size_t i = 1; i < ticks.size(); i++) {
+          auto spacing = duration_cast<nanoseconds>(ticks[i] - ticks[i-1]);
+          auto error   = std::abs((spacing - (period * 24 / 64)).count());
+          REQUIRE( error < 100000 );
+        }
+      }
+
+      THEN( "the phase is within the jitter" ) {
+        auto error = duration_cast<nanoseconds>(*pll.predict(95) - (start + period * 95)).count();
+        REQUIRE( std::abs(error) < 1000000 );
+      }
+    }
+
+    WHEN( "the loop is reset" ) {
+      for (long i = 0; i < 96; i++) {
+        pll.pulse(start + (period * i));
+      }
+      pll.reset();
+
+      THEN( "the phase is forgotten but the period is kept" ) {
+        REQUIRE( pll.pulses() == 0 );
+        REQUIRE( !pll.predict(0).has_value() );
+        REQUIRE( pll.period() > nanoseconds(0) );
+      }
+    }
+  }
+}
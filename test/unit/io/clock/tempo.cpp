@@ -0,0 +1,129 @@
+#include <catch.hpp>
+
+#include <cmath>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "anemone/rx.hpp"
+#include "anemone/types.hpp"
+#include "anemone/io/clock/clock.hpp"
+#include "anemone/io/clock/tempo.hpp"
+#include "anemone/io/clock/device/virtual.hpp"
+
+
+SCENARIO( "a TempoMap computes the tempo over a ramp" ) {
+
+  GIVEN( "a linear ramp from 120 to 180 bpm over a beat" ) {
+    TempoMap::segment_t ramp = { .from = 120, .to = 180, .ticks = PPQN::Max, .curve = TempoMap::Ramp::Linear };
+
+    THEN( "the tempo moves by the same amount every tick and holds at the end" ) {
+      REQUIRE( TempoMap::bpm_at(ramp, 0) == 120 );
+      REQUIRE( TempoMap::bpm_at(ramp, PPQN::Max / 2) == Approx(150) );
+      REQUIRE( TempoMap::bpm_at(ramp, PPQN::Max) == 180 );
+      REQUIRE( TempoMap::bpm_at(ramp, 10 * PPQN::Max) == 180 );
+    }
+  }
+
+  GIVEN( "an exponential ramp from 100 to 400 bpm over a beat" ) {
+    TempoMap::segment_t ramp = { .from = 100, .to = 400, .ticks = PPQN::Max, .curve = TempoMap::Ramp::Exponential };
+
+    THEN( "the tempo moves by the same ratio every tick" ) {
+      REQUIRE( TempoMap::bpm_at(ramp, PPQN::Max / 2) == Approx(200) );
+      REQUIRE( TempoMap::bpm_at(ramp, PPQN::Max / 4) == Approx(100 * std::sqrt(2)) );
+      REQUIRE( TempoMap::bpm_at(ramp, PPQN::Max) == 400 );
+    }
+  }
+
+  GIVEN( "a tempo map" ) {
+    TempoMap tempo(120);
+    unsigned long version = 0;
+    TempoMap::segment_t segment;
+
+    THEN( "nothing is picked up until something is published" ) {
+      REQUIRE( !tempo.poll(version, segment) );
+    }
+
+    WHEN( "a ramp is published" ) {
+      tempo.ramp(90, 2, TempoMap::Ramp::Exponential);
+
+      THEN( "it is picked up once, starting from the current tempo" ) {
+        REQUIRE( tempo.poll(version, segment) );
+        REQUIRE( segment.from < 0 );
+        REQUIRE( segment.to == 90 );
+        REQUIRE( segment.ticks == 2 * PPQN::Max );
+        REQUIRE( segment.curve == TempoMap::Ramp::Exponential );
+        REQUIRE( !tempo.poll(version, segment) );
+        REQUIRE( tempo.bpm() == 90 );
+      }
+    }
+  }
+}
+
+SCENARIO( "a Clock changes tempo on tick boundaries" ) {
+  using namespace std::chrono;
+
+  GIVEN( "a clock at 120 bpm on a stepped virtual clock device" ) {
+    rx::behavior<double> bpm(120);
+
+    auto device = std::make_shared<VirtualClock>(VirtualClock::Mode::Stepped);
+    auto clock  = std::make_shared<Clock>(device,
+                                          Clock::settings_t{ .spin = microseconds(0), .catch_up = PPQN::Max },
+                                          bpm.get_observable());
+
+    std::vector<tick_t> ticks;
+    clock->connect().subscribe([&ticks] (tick_t t) { ticks.push_back(t); });
+
+    // every tick is due exactly one period after the previous one, i.e. no tick is
+    // ever late or early relative to the tempo it follows.
+    auto continuous = [&ticks] {
+                        for (unsigned int i = 1; i < ticks.size(); i++) {
+                          if (ticks[i].index != ticks[i - 1].index + 1) return false;
+                          if (ticks[i].time - ticks[i - 1].time != ticks[i - 1].period) return false;
+                        }
+                        return true;
+                      };
+
+    WHEN( "the tempo changes in the middle of a beat" ) {
+      device->step(PPQN::Max + 10);
+      bpm.get_subscriber().on_next(150);
+      device->step(2 * PPQN::Max);
+
+      THEN( "the new tempo starts exactly on the next tick and the beat phase carries on" ) {
+        REQUIRE( continuous() );
+        REQUIRE( ticks[PPQN::Max + 9].period == TempoMap::period(120) );
+        REQUIRE( ticks[PPQN::Max + 10].period == TempoMap::period(150) );
+
+        // the third beat starts 54 ticks at 150 bpm after the 10th tick of the second.
+        auto beat_2 = ticks[PPQN::Max].time;
+        auto beat_3 = ticks[2 * PPQN::Max].time;
+        REQUIRE( beat_3 - beat_2 == (10 * TempoMap::period(120)) + ((PPQN::Max - 10) * TempoMap::period(150)) );
+      }
+    }
+
+    WHEN( "the tempo ramps linearly over two beats" ) {
+      device->step(PPQN::Max);
+      clock->tempo().ramp(240, 2);
+      device->step(3 * PPQN::Max);
+
+      THEN( "the period shrinks tick by tick and then holds" ) {
+        REQUIRE( continuous() );
+        REQUIRE( ticks[PPQN::Max - 1].period == TempoMap::period(120) );
+        REQUIRE( ticks[PPQN::Max].period == TempoMap::period(120) );
+
+        for (unsigned int i = PPQN::Max + 1; i <= 3 * PPQN::Max; i++) {
+          REQUIRE( ticks[i].period < ticks[i - 1].period );
+        }
+
+        REQUIRE( ticks[3 * PPQN::Max].period == TempoMap::period(240) );
+        REQUIRE( ticks.back().period == TempoMap::period(240) );
+
+        // a linear bpm ramp from 120 to 240 over two beats lasts ln(2) seconds.
+        auto ramp = duration<double>(ticks[3 * PPQN::Max].time - ticks[PPQN::Max].time).count();
+        REQUIRE( ramp == Approx(std::log(2.0)).epsilon(0.01) );
+      }
+    }
+
+    clock->disconnect();
+  }
+}
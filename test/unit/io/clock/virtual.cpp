@@ -0,0 +1,80 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "anemone/rx.hpp"
+#include "anemone/types.hpp"
+#include "anemone/io/clock/clock.hpp"
+#include "anemone/io/clock/device/virtual.hpp"
+
+
+SCENARIO( "a Clock can run in virtual time" ) {
+  using namespace std::chrono;
+
+  const double bpm    = 120;
+  const auto   period = nanoseconds(static_cast<long>((60.0 * 1e9) / (bpm * (double)PPQN::Max)));
+
+  GIVEN( "a clock with a stepped virtual clock device" ) {
+    auto device = std::make_shared<VirtualClock>(VirtualClock::Mode::Stepped);
+    auto clock  = std::make_shared<Clock>(device,
+                                          Clock::settings_t{ .spin = microseconds(0), .catch_up = PPQN::Max },
+                                          rx::behavior<double>(bpm).get_observable());
+
+    std::vector<tick_t> ticks;
+    clock->connect().subscribe([&ticks] (tick_t t) { ticks.push_back(t); });
+
+    WHEN( "it is stepped" ) {
+      device->step(3);
+
+      THEN( "exactly that many ticks are emitted, one period apart in virtual time" ) {
+        REQUIRE( ticks.size() == 3 );
+        REQUIRE( ticks[0].index == 0 );
+        REQUIRE( ticks[2].index == 2 );
+        REQUIRE( ticks[1].time - ticks[0].time == period );
+        REQUIRE( ticks[2].time - ticks[1].time == period );
+        REQUIRE( device->now() == ticks[2].time );
+      }
+
+      AND_WHEN( "it is stepped again" ) {
+        device->step(PPQN::Max);
+
+        THEN( "the ticks pick up where they left off" ) {
+          REQUIRE( ticks.size() == 3 + PPQN::Max );
+          REQUIRE( ticks.back().time - ticks[0].time == period * (2 + PPQN::Max) );
+        }
+      }
+    }
+
+    clock->disconnect();
+  }
+
+  GIVEN( "a clock with a free running virtual clock device" ) {
+    auto device = std::make_shared<VirtualClock>(VirtualClock::Mode::FreeRunning);
+    auto clock  = std::make_shared<Clock>(device,
+                                          Clock::settings_t{ .spin = microseconds(0), .catch_up = PPQN::Max },
+                                          rx::behavior<double>(bpm).get_observable());
+
+    WHEN( "it runs for ten minutes of virtual time" ) {
+      const long ten_minutes = 10 * 60 * (bpm / 60) * PPQN::Max;
+
+      std::atomic<long> count = 0;
+      clock->connect().subscribe([&count] (tick_t) { count++; });
+
+      auto start = steady_clock::now();
+      while (count < ten_minutes && steady_clock::now() - start < seconds(10)) {
+        std::this_thread::sleep_for(milliseconds(1));
+      }
+      clock->disconnect();
+      auto elapsed = steady_clock::now() - start;
+
+      THEN( "it takes a fraction of the time" ) {
+        REQUIRE( count >= ten_minutes );
+        REQUIRE( elapsed < seconds(10) );
+      }
+    }
+  }
+}
@@ -0,0 +1,60 @@
+#include <catch.hpp>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+#include "anemone/rx.hpp"
+#include "anemone/types.hpp"
+#include "anemone/config.hpp"
+#include "anemone/io/midi/midi.hpp"
+#include "anemone/io/midi/scheduler.hpp"
+#include "anemone/io/midi/device/null.hpp"
+
+
+SCENARIO( "a MidiScheduler streams the events it sends, once they are sent" ) {
+  using namespace std::chrono;
+
+  GIVEN( "a scheduler with a lookahead" ) {
+    auto config = std::make_shared<Config>(YAML::Load("ports: { midi: { in: [], out: [ out ] } }"), "");
+    auto midi   = std::make_shared<Midi>(config, std::make_shared< MidiDeviceFactoryFor<NullMidiIn, NullMidiOut> >());
+
+    auto scheduler = std::make_shared<MidiScheduler>(MidiScheduler::settings_t{ .lookahead = milliseconds(50),
+                                                                                .spin      = microseconds(100) },
+                                                     midi);
+    scheduler->connect();
+
+    rx::behavior<midi_event_t> played({});
+    std::vector<std::pair<midi_data_t, steady_clock::time_point> > sent;
+    played.get_observable()
+      .skip(1)
+      .subscribe([&sent] (midi_event_t e) { sent.push_back({ e.data, steady_clock::now() }); });
+
+    WHEN( "events are scheduled, and some of them cancelled before they are due" ) {
+      int kept, cancelled;
+      auto now = steady_clock::now();
+
+      scheduler->schedule({ .due    = now + milliseconds(10),
+                            .event  = { .source = "", .destination = "", .data = midi_note_on(60, 0, 100) },
+                            .owner  = &kept,
+                            .played = &played });
+      scheduler->schedule({ .due    = now + milliseconds(20),
+                            .event  = { .source = "", .destination = "", .data = midi_note_on(62, 0, 100) },
+                            .owner  = &cancelled,
+                            .played = &played });
+      scheduler->cancel(&cancelled);
+
+      std::this_thread::sleep_for(milliseconds(40));
+      scheduler->disconnect();
+
+      THEN( "only the events which were sent are streamed, no earlier than they were due" ) {
+        REQUIRE( sent.size() == 1 );
+        REQUIRE( sent[0].first == midi_note_on(60, 0, 100) );
+        REQUIRE( sent[0].second >= now + milliseconds(10) );
+      }
+    }
+  }
+}
@@ -0,0 +1,57 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "anemone/io/midi/smf.hpp"
+
+
+namespace {
+  std::vector<unsigned char> read_file(std::string path) {
+    std::ifstream file(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+  }
+}
+
+SCENARIO( "a StandardMidiFile can be written as a type-1 midi file" ) {
+
+  GIVEN( "a file with a tempo change and a track with two notes" ) {
+    StandardMidiFile smf(64);
+    smf.add_tempo(0, 120);
+
+    auto track = smf.add_track("a");
+    smf.add_event(track, 0, { 0x90, 0x3C, 0x7F });
+    smf.add_event(track, 200, { 0x80, 0x3C, 0x00 });
+
+    std::string path = "/tmp/anemone_smf_test.mid";
+
+    WHEN( "it is written" ) {
+      REQUIRE( smf.write(path, 256) );
+      auto bytes = read_file(path);
+      std::remove(path.c_str());
+
+      THEN( "it has a type-1 header with two tracks and the division" ) {
+        std::vector<unsigned char> header = { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, 2, 0, 64 };
+        REQUIRE( std::vector<unsigned char>(bytes.begin(), bytes.begin() + 14) == header );
+      }
+
+      THEN( "the tempo track holds the tempo" ) {
+        std::vector<unsigned char> tempo_track = { 'M', 'T', 'r', 'k', 0, 0, 0, 12,
+                                                   0x00, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20,
+                                                   0x82, 0x00, 0xFF, 0x2F, 0x00 };
+        REQUIRE( std::vector<unsigned char>(bytes.begin() + 14, bytes.begin() + 34) == tempo_track );
+      }
+
+      THEN( "the events are delta timed with variable length quantities" ) {
+        std::vector<unsigned char> track = { 'M', 'T', 'r', 'k', 0, 0, 0, 18,
+                                             0x00, 0xFF, 0x03, 0x01, 'a',
+                                             0x00, 0x90, 0x3C, 0x7F,
+                                             0x81, 0x48, 0x80, 0x3C, 0x00,
+                                             0x38, 0xFF, 0x2F, 0x00 };
+        REQUIRE( std::vector<unsigned char>(bytes.begin() + 34, bytes.end()) == track );
+      }
+    }
+  }
+}
@@ -0,0 +1,100 @@
+#include <catch.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "anemone/state/deferred/deferred.hpp"
+
+
+SCENARIO( "DeferredActions apply state changes on musical boundaries" ) {
+
+  GIVEN( "a part playing a 4 step sequence at 4 ppqn" ) {
+    DeferredActions deferred;
+    auto part = std::make_shared<Part>(0);
+
+    const granular_step_idx_t last = 4 * PPQN::Max;
+
+    // plays ticks like the step controller does: deferred actions first, then the cursor
+    // moves, unless the part is paused.
+    long tick = 0;
+    bool paused = false;
+    auto play = [&] (long ticks) {
+                  for (long end = tick + ticks; tick < end; tick++) {
+                    deferred.apply({ .index = tick });
+
+                    part->step.advancing.store(!paused);
+                    if (paused) continue;
+
+                    auto step = part->step.current.get();
+                    part->step.update_current(step > last - 1 ? 0 : step + part->ppqn.in_playback.load());
+                  }
+                };
+
+    std::vector<long> applied;
+    auto record = [&applied, &tick] { applied.push_back(tick); };
+
+    play(10);
+
+    WHEN( "actions are deferred until the next step, beat, bar and end of sequence" ) {
+      deferred.defer(part, Quantize::Step, record);
+      deferred.defer(part, Quantize::Beat, record);
+      deferred.defer(part, Quantize::Bar, record);
+      deferred.defer(part, Quantize::Sequence, record);
+
+      play(2 * 4 * PPQN::Max);
+
+      THEN( "each is applied on the tick its boundary falls on" ) {
+        // the cursor moves 4 granular steps a tick, so it is on a step every 16 ticks.
+        // it plays the granular step right after the last before wrapping around, i.e.
+        // it comes back to the top of the sequence every 65 ticks.
+        REQUIRE( applied == std::vector<long>{ 16, PPQN::Max, 4 * 16 + 1, 4 * PPQN::Max } );
+      }
+    }
+
+    WHEN( "an action is deferred until the next tick" ) {
+      std::vector<bool> pending;
+      deferred.on_pending = [&pending, &deferred] { pending.push_back(deferred.pending()); };
+
+      deferred.defer(part, Quantize::Tick, record);
+      auto pending_before = deferred.pending();
+
+      play(2);
+
+      THEN( "it is applied on the next tick, and pending until then" ) {
+        REQUIRE( applied == std::vector<long>{ 10 } );
+        REQUIRE( pending_before );
+        REQUIRE( !deferred.pending() );
+        REQUIRE( pending == std::vector<bool>{ true, false } );
+      }
+    }
+
+    WHEN( "the part changes pace while a step aligned action is waiting" ) {
+      deferred.defer(part, Quantize::Step, record);
+      part->ppqn.in_playback.store(PPQN::Two);
+
+      play(PPQN::Max);
+
+      THEN( "the action is still applied when the cursor is on a step" ) {
+        REQUIRE( applied.size() == 1 );
+        REQUIRE( applied[0] == 10 + ((PPQN::Max - 40) / PPQN::Two) );
+      }
+    }
+
+    WHEN( "the part is paused away from the top while a sequence aligned action is waiting" ) {
+      std::vector<bool> pending;
+      deferred.on_pending = [&pending, &deferred] { pending.push_back(deferred.pending()); };
+
+      deferred.defer(part, Quantize::Sequence, record);
+      deferred.defer(part, Quantize::Step, [&paused, &record] { paused = true; record(); });
+
+      play(PPQN::Max);
+
+      THEN( "the action is applied as soon as the part stops advancing, rather than waiting for it to play" ) {
+        REQUIRE( part->step.cursor.load() != 0 );
+        REQUIRE( applied == std::vector<long>{ 16, 17 } );
+        REQUIRE( !deferred.pending() );
+        REQUIRE( pending == std::vector<bool>{ true, false } );
+      }
+    }
+  }
+}
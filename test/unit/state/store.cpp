@@ -0,0 +1,103 @@
+#include <catch.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "anemone/state/store/store.hpp"
+
+
+namespace {
+  void record(std::vector<int>* applied, int n) {
+    applied->push_back(n);
+  }
+}
+
+SCENARIO( "a Store applies the actions dispatched to it in order, on a single thread" ) {
+
+  GIVEN( "a store" ) {
+    Store store;
+
+    std::vector<int>             applied;
+    std::vector<std::thread::id> appliers;
+    auto action = [&] (int n) {
+                    return [&applied, &appliers, n] {
+                             applied.push_back(n);
+                             appliers.push_back(std::this_thread::get_id());
+                           };
+                  };
+
+    WHEN( "actions are dispatched before it is started" ) {
+      store.dispatch(action(1));
+      store.dispatch(action(2));
+
+      THEN( "they are applied as they are dispatched" ) {
+        REQUIRE( applied == std::vector<int>{ 1, 2 } );
+        REQUIRE( appliers[0] == std::this_thread::get_id() );
+      }
+    }
+
+    WHEN( "changes are posted, and actions dispatched, once it is started" ) {
+      store.start();
+
+      // fewer changes than the ring holds, since overflowing changes are dispatched.
+      std::thread poster([&store, &applied] {
+                           for (int i = 0; i < 200; i++) store.post<&record>(&applied, i);
+                         });
+      std::thread dispatcher([&store, &action] {
+                               for (int i = 0; i < 100; i++) store.dispatch(action(1000 + i));
+                             });
+      poster.join();
+      dispatcher.join();
+
+      store.stop();
+
+      THEN( "they are all applied by the writer, the changes in the order they were posted" ) {
+        REQUIRE( applied.size() == 300 );
+        REQUIRE( store.applied() == 300 );
+
+        std::vector<int> posted;
+        for (auto n : applied) if (n < 1000) posted.push_back(n);
+
+        bool in_order = posted.size() == 200;
+        for (int i = 0; in_order && i < 200; i++) in_order = posted[i] == i;
+        REQUIRE( in_order );
+      }
+    }
+
+    WHEN( "actions are dispatched from several threads once it is started" ) {
+      store.start();
+
+      std::vector<std::thread> dispatchers;
+      for (int t = 0; t < 3; t++) {
+        dispatchers.emplace_back([&store, &action, t] {
+                                   for (int i = 0; i < 100; i++) store.dispatch(action(t * 1000 + i));
+                                 });
+      }
+      for (auto& d : dispatchers) d.join();
+
+      store.dispatch(action(-1));
+      store.stop();
+
+      THEN( "they are all applied by the writer, in the order each thread dispatched them" ) {
+        REQUIRE( applied.size() == 301 );
+        REQUIRE( applied.back() == -1 );
+        REQUIRE( store.applied() == 301 );
+        REQUIRE( store.batches() <= 301 );
+
+        int last[3] = { -1, -1, -1 };
+        bool in_order = true;
+        for (auto n : applied) {
+          if (n < 0) continue;
+
+          in_order &= n % 1000 > last[n / 1000];
+          last[n / 1000] = n % 1000;
+        }
+        REQUIRE( in_order );
+
+        bool on_writer = true;
+        for (auto id : appliers) on_writer &= id != std::this_thread::get_id();
+        REQUIRE( on_writer );
+      }
+    }
+  }
+}
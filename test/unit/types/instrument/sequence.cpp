@@ -0,0 +1,242 @@
+#include <catch.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "anemone/types.hpp"
+
+
+SCENARIO( "a Sequence keeps a compiled schedule of its events" ) {
+
+  GIVEN( "a sequence with notes on two steps" ) {
+    Sequence sequence;
+
+    sequence_layer_t c2;
+    auto on = step_event_t::make_midi_note_on("c2", 10, 100);
+    c2.insert_or_assign(on.id, on);
+
+    sequence.add_midi_note_events_at({ .page = 0, .step = 4 }, 4 * PPQN::Max, c2);
+    sequence.add_midi_note_events_at({ .page = 0, .step = 1 }, 1 * PPQN::Max, c2);
+
+    auto schedule = sequence.schedule();
+
+    THEN( "the schedule holds the notes and how long they are held for, sorted by step" ) {
+      auto events = schedule->chunk_of(0);
+      REQUIRE( schedule->size() == 2 );
+      REQUIRE( events.first[0].step == 1 * PPQN::Max );
+      REQUIRE( events.first[1].step == 4 * PPQN::Max );
+      REQUIRE( events.first[0].duration == PPQN::Max );
+      REQUIRE( events.first[0].is_note_on() );
+    }
+
+    THEN( "the events at a step are the same as those in the sequence maps" ) {
+      auto events = Sequence::events_at(*schedule, 4 * PPQN::Max);
+      REQUIRE( events.end() - events.begin() == 1 );
+
+      auto event = *events.begin();
+      REQUIRE( event.data == sequence.get_events_at(4 * PPQN::Max)[0].data );
+
+      REQUIRE( Sequence::events_at(*schedule, 3 * PPQN::Max).empty() );
+    }
+
+    THEN( "the events at a step can be viewed in place, for all or some layers" ) {
+      auto all = sequence.events_at(4 * PPQN::Max);
+      REQUIRE( all.begin() != all.end() );
+      REQUIRE( all.begin()->data == on.data );
+
+      std::vector<step_event_id_t> selected = { on.id };
+      REQUIRE( !sequence.events_at(4 * PPQN::Max, selected).empty() );
+
+      std::vector<step_event_id_t> other = { (step_event_id_t)(on.id + 1) };
+      REQUIRE( sequence.events_at(4 * PPQN::Max, other).empty() );
+      REQUIRE( sequence.events_at(3 * PPQN::Max).empty() );
+    }
+
+    WHEN( "a cursor plays the sequence through twice" ) {
+      schedule_cursor_t cursor;
+      std::vector<granular_step_idx_t> played;
+
+      for (int cycle = 0; cycle < 2; cycle++) {
+        for (granular_step_idx_t step = 0; step < 8 * PPQN::Max; step += PPQN::Four) {
+          auto current = sequence.schedule();
+          for (auto& event : cursor.advance(*current, step)) played.push_back(event.step);
+        }
+      }
+
+      THEN( "it finds every event, in order, and wraps around" ) {
+        std::vector<granular_step_idx_t> expected = { 1 * PPQN::Max, 4 * PPQN::Max };
+        REQUIRE( played.size() == 4 );
+        REQUIRE( std::vector<granular_step_idx_t>(played.begin(), played.begin() + 2) == expected );
+        REQUIRE( std::vector<granular_step_idx_t>(played.begin() + 2, played.end()) == expected );
+      }
+    }
+
+    WHEN( "a step is removed" ) {
+      sequence.remove_midi_note_events_at({ .page = 0, .step = 1 }, 1 * PPQN::Max);
+
+      THEN( "a new schedule is published and the old one is left as it was" ) {
+        auto edited = sequence.schedule();
+
+        REQUIRE( edited->size() == 1 );
+        REQUIRE( Sequence::events_at(*edited, 1 * PPQN::Max).empty() );
+        REQUIRE( schedule->size() == 2 );
+        REQUIRE( edited->version != schedule->version );
+      }
+    }
+  }
+}
+
+SCENARIO( "a Sequence indexes its rendered steps by page" ) {
+
+  GIVEN( "a sequence with notes on a few steps of two pages" ) {
+    Sequence sequence;
+
+    sequence_layer_t c2;
+    auto on = step_event_t::make_midi_note_on("c2", 10, 100);
+    c2.insert_or_assign(on.id, on);
+
+    sequence.add_midi_note_events_at({ .page = 0, .step = 0 },  0 * PPQN::Max,  c2);
+    sequence.add_midi_note_events_at({ .page = 0, .step = 5 },  5 * PPQN::Max,  c2);
+    sequence.add_midi_note_events_at({ .page = 2, .step = 63 }, 191 * PPQN::Max, c2);
+
+    auto& rendered = sequence.rendered_steps;
+
+    THEN( "only the chunk of pages with rendered steps is held" ) {
+      REQUIRE( rendered.bytes() == sizeof(RenderedSteps) + RenderedSteps::chunk_pages * sizeof(page_mask_t) );
+    }
+
+    THEN( "each page is a mask of its rendered steps, summarized by popcounts" ) {
+      REQUIRE( rendered.page(0) == ((page_mask_t(1) << 5) | 1) );
+      REQUIRE( rendered.page(1) == 0 );
+      REQUIRE( rendered.test({ .page = 2, .step = 63 }) );
+      REQUIRE( !rendered.test({ .page = 2, .step = 62 }) );
+      REQUIRE( rendered.count(0) == 2 );
+      REQUIRE( rendered.count() == 3 );
+      REQUIRE( rendered.occupied() == 0b101 );
+    }
+
+    WHEN( "a step is removed" ) {
+      sequence.remove_midi_note_events_at({ .page = 2, .step = 63 }, 191 * PPQN::Max);
+
+      THEN( "its bit is cleared and its page is empty again" ) {
+        REQUIRE( !rendered.test({ .page = 2, .step = 63 }) );
+        REQUIRE( rendered.count() == 2 );
+        REQUIRE( rendered.occupied() == 0b1 );
+      }
+    }
+
+    THEN( "steps out of range are ignored" ) {
+      rendered.set({ .page = RenderedSteps::max_pages, .step = 0 });
+      rendered.set({ .page = 0, .step = RenderedSteps::max_page_size });
+
+      REQUIRE( rendered.count() == 3 );
+      REQUIRE( !rendered.test({ .page = RenderedSteps::max_pages, .step = 0 }) );
+    }
+
+    WHEN( "a step is added thousands of steps in" ) {
+      auto before = sequence.schedule();
+
+      // the 4096th step of a part with 16 step pages.
+      sequence.add_midi_note_events_at({ .page = 255, .step = 15 }, 4095 * PPQN::Max, c2);
+
+      THEN( "its chunk of pages is held too, and only its chunk of the schedule is new" ) {
+        REQUIRE( rendered.test({ .page = 255, .step = 15 }) );
+        REQUIRE( rendered.occupied(192) == std::uint64_t(1) << 63 );
+        REQUIRE( rendered.bytes() == sizeof(RenderedSteps) + 2 * RenderedSteps::chunk_pages * sizeof(page_mask_t) );
+        auto schedule = sequence.schedule();
+        REQUIRE( schedule->chunks.size() == 4096 / 64 );
+        REQUIRE( (schedule->chunk_of(4095 * PPQN::Max).last - 1)->step == 4095 * PPQN::Max );
+
+        // the chunks which weren't edited are shared with the previous schedule.
+        REQUIRE( schedule->chunks[0] == before->chunks[0] );
+        REQUIRE( schedule->chunks[2] == before->chunks[2] );
+      }
+    }
+  }
+}
+
+SCENARIO( "a Part mutes & solos the layers of its sequence by mask" ) {
+
+  GIVEN( "a part with a kick and a snare on the same channel" ) {
+    Part part(0);
+
+    auto kick  = step_event_t::make_midi_note_on("c1", 10, 100);
+    auto snare = step_event_t::make_midi_note_on("d1", 10, 100);
+
+    sequence_layer_t both;
+    both.insert_or_assign(kick.id, kick);
+    both.insert_or_assign(snare.id, snare);
+    part.sequence.add_midi_note_events_at({ .page = 0, .step = 0 }, 0, both);
+
+    THEN( "each voice has its own layer id and dense layer" ) {
+      REQUIRE( kick.id == 0x9918 );
+      REQUIRE( snare.id == 0x991A );
+
+      auto schedule = part.sequence.schedule();
+      auto events   = Sequence::events_at(*schedule, 0);
+      REQUIRE( schedule->size() == 2 );
+      REQUIRE( events.first[0].layer != events.first[1].layer );
+      REQUIRE( part.sequence.layers.mask(kick.id) == layer_mask_t(1) << events.first[0].layer );
+    }
+
+    THEN( "the events of a voice can be viewed on their own" ) {
+      std::vector<step_event_id_t> snares = { snare.id };
+      auto view = part.sequence.events_at(0, snares);
+
+      REQUIRE( view.begin()->id == snare.id );
+      REQUIRE( ++view.begin() == view.end() );
+    }
+
+    WHEN( "the kick is muted" ) {
+      part.mute(kick.id, true);
+
+      THEN( "only the snare is heard" ) {
+        auto audible = part.layers.audible();
+        REQUIRE( !(audible & part.sequence.layers.mask(kick.id)) );
+        REQUIRE( (audible & part.sequence.layers.mask(snare.id)) );
+      }
+
+      AND_WHEN( "the kick is soloed" ) {
+        part.solo(kick.id, true);
+
+        THEN( "only the kick is heard, until it is unsoloed" ) {
+          REQUIRE( part.layers.audible() == part.sequence.layers.mask(kick.id) );
+
+          part.solo(kick.id, false);
+          REQUIRE( !(part.layers.audible() & part.sequence.layers.mask(kick.id)) );
+        }
+      }
+    }
+  }
+}
+
+SCENARIO( "a part with more layers than can be indexed" ) {
+  GIVEN( "a part whose sequence already indexed as many layers as it can" ) {
+    Part part(0);
+
+    for (step_event_id_t id = 0; id < LayerIndex::max_layers; id++) part.sequence.layers.index(id);
+
+    THEN( "a new layer is reported as unindexed, rather than sharing a bit" ) {
+      REQUIRE( part.sequence.layers.index(LayerIndex::max_layers - 1) == LayerIndex::max_layers - 1 );
+      REQUIRE( part.sequence.layers.index(0x9918) == LayerIndex::unindexed );
+      REQUIRE( part.sequence.layers.mask(0x9918) == 0 );
+    }
+
+    WHEN( "the new layer is muted" ) {
+      part.mute(0x9918, true);
+
+      THEN( "it is ignored, and it is still heard" ) {
+        REQUIRE( part.layers.muted.load() == 0 );
+        REQUIRE( ((part.layers.audible() >> LayerIndex::unindexed) & 1) );
+      }
+    }
+
+    WHEN( "another layer is soloed" ) {
+      part.solo(0, true);
+
+      THEN( "the new layer isn't heard" ) {
+        REQUIRE( !((part.layers.audible() >> LayerIndex::unindexed) & 1) );
+      }
+    }
+  }
+}
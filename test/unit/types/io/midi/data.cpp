@@ -0,0 +1,71 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include "anemone/types.hpp"
+
+
+// notes written in the code are translated at compile time.
+static_assert( spn_to_num("c4") == 60 );
+static_assert( spn_to_num("C#4") == 61 );
+static_assert( spn_to_num("cb4") == 59 );
+static_assert( spn_to_num("c-1") == 0 );
+static_assert( midi_note_on(spn_to_num("a4"), 1, 100) == midi_data_t{ 0x90, 69, 100 } );
+
+SCENARIO( "midi messages are kept inline" ) {
+
+  GIVEN( "a note on" ) {
+    auto on = midi_note_on("d#-1", 10, 127);
+
+    THEN( "it is three bytes, with the note parsed from its spn" ) {
+      REQUIRE( on.size() == 3 );
+      REQUIRE( on == midi_data_t{ 0x99, 3, 127 } );
+      REQUIRE( is_midi_on_note_message(on) );
+    }
+
+    THEN( "its note off is on the same channel & note" ) {
+      auto off = midi_note_off_from_on(on);
+
+      REQUIRE( is_midi_off_note_message(off) );
+      REQUIRE( off == midi_data_t{ 0x89, 3, 127 } );
+      REQUIRE( off != on );
+    }
+  }
+
+  GIVEN( "a longer message" ) {
+    std::vector<unsigned char> bytes = { 0xF2, 0x01, 0x02, 0x03 };
+    midi_data_t data(bytes.begin(), bytes.end());
+
+    THEN( "only the first three bytes are kept" ) {
+      REQUIRE( data == make_song_position_message(0x101) );
+    }
+  }
+}
+
+SCENARIO( "sysex messages are stored in an arena" ) {
+
+  GIVEN( "an arena with room for two messages" ) {
+    SysexArena arena(10);
+
+    auto first = arena.store({ 0x41, 0x10, 0x42 });
+
+    THEN( "messages are framed" ) {
+      REQUIRE( std::vector<unsigned char>(first.begin(), first.end()) ==
+               std::vector<unsigned char>{ 0xF0, 0x41, 0x10, 0x42, 0xF7 } );
+    }
+
+    WHEN( "it is full" ) {
+      arena.store({ 0x01, 0x02, 0x03 });
+      auto third = arena.store({ 0x7E });
+
+      THEN( "the oldest message is overwritten" ) {
+        REQUIRE( third.bytes == first.bytes );
+        REQUIRE( third.size == 3 );
+      }
+    }
+
+    THEN( "a message too long for the arena is not stored" ) {
+      REQUIRE( arena.store({ 1, 2, 3, 4, 5, 6, 7, 8, 9 }).empty() );
+    }
+  }
+}
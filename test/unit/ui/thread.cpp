@@ -0,0 +1,58 @@
+#include <catch.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "anemone/ui/thread.hpp"
+
+
+namespace {
+  struct RecordingUI {
+    std::vector<int> rendered;
+
+    void render(int value) { rendered.push_back(value); };
+  };
+}
+
+SCENARIO( "the ui thread sleeps until changes are posted, and renders them in order" ) {
+
+  GIVEN( "a started ui thread with nothing to render" ) {
+    RecordingUI ui;
+    UIThread thread;
+    thread.start();
+
+    // let it fall asleep on the ring.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    WHEN( "changes are posted, then it is stopped" ) {
+      for (int i = 0; i < 100; i++) thread.post<&RecordingUI::render>(&ui, i);
+
+      auto start = std::chrono::steady_clock::now();
+      thread.stop();
+      auto stopping = std::chrono::steady_clock::now() - start;
+
+      THEN( "it renders them all, in order, and stops right away" ) {
+        REQUIRE( ui.rendered.size() == 100 );
+        for (int i = 0; i < 100; i++) REQUIRE( ui.rendered[i] == i );
+        REQUIRE( thread.dropped() == 0 );
+        REQUIRE( stopping < std::chrono::seconds(1) );
+      }
+    }
+
+    WHEN( "it is left idle, then stopped" ) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      auto idle_wakeups = thread.wakeups();
+
+      auto start = std::chrono::steady_clock::now();
+      thread.stop();
+      auto stopping = std::chrono::steady_clock::now() - start;
+
+      THEN( "it doesn't wake up while idle, only to stop" ) {
+        REQUIRE( idle_wakeups == 0 );
+        REQUIRE( ui.rendered.empty() );
+        REQUIRE( stopping < std::chrono::seconds(1) );
+      }
+    }
+  }
+}
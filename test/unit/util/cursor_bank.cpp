@@ -0,0 +1,53 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include "anemone/util/cursor_bank.hpp"
+
+
+SCENARIO( "a CursorBank advances looping cursors together" ) {
+
+  GIVEN( "a bank of two cursors of different lengths & rates" ) {
+    CursorBank bank(4);
+
+    auto slow = bank.add();
+    bank.set_stride(slow, 1);
+    bank.set_end(slow, 8);
+
+    auto fast = bank.add(6);
+    bank.set_stride(fast, 2);
+    bank.set_end(fast, 8);
+
+    WHEN( "it is advanced" ) {
+      std::vector<CursorBank::position_t> slow_at, fast_at;
+      std::vector<bool> slow_moved;
+      for (int tick = 0; tick < 10; tick++) {
+        bank.advance();
+        slow_at.push_back(bank.at(slow));
+        fast_at.push_back(bank.at(fast));
+        slow_moved.push_back(bank.moved(slow));
+      }
+
+      THEN( "each cursor moves by its stride and comes back to the top past its end" ) {
+        REQUIRE( slow_at == std::vector<CursorBank::position_t>{ 1, 2, 3, 4, 5, 6, 7, 8, 0, 1 } );
+        REQUIRE( fast_at == std::vector<CursorBank::position_t>{ 8, 0, 2, 4, 6, 8, 0, 2, 4, 6 } );
+      }
+
+      THEN( "a cursor is flagged as moved only when it lands on a new observable position" ) {
+        REQUIRE( slow_moved == std::vector<bool>{ false, false, false, true, false, false, false, true, true, false } );
+      }
+    }
+
+    WHEN( "a cursor is removed" ) {
+      bank.remove(fast);
+      bank.advance();
+
+      THEN( "it stays put, and its slot is reused" ) {
+        REQUIRE( bank.at(fast) == 6 );
+        REQUIRE( !bank.moved(fast) );
+        REQUIRE( bank.size() == 1 );
+        REQUIRE( bank.add() == fast );
+      }
+    }
+  }
+}
@@ -0,0 +1,106 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "anemone/util/high_frequency.hpp"
+
+
+namespace {
+  /// @brief lets through the values which differ from the previous one.
+  class Changed : public SubscriptionPredicate<int> {
+  public:
+    bool operator()(int value) override {
+      auto changed = value != previous;
+      previous = value;
+
+      return changed;
+    };
+
+    int previous = 0;
+  };
+}
+
+SCENARIO( "a HighFrequencyState tells its observers about each new value" ) {
+
+  GIVEN( "a state observed twice" ) {
+    HighFrequencyState<int> state(1);
+
+    std::vector<int> first, second;
+    auto subscription = state.subscribe([&first] (int value) { first.push_back(value); });
+    state.subscribe([&second] (int value) { second.push_back(value); });
+
+    WHEN( "it is set" ) {
+      state.set(2);
+      state.set(3);
+
+      THEN( "each observer is told, in order" ) {
+        REQUIRE( state.get() == 3 );
+        REQUIRE( first == std::vector<int>{ 2, 3 } );
+        REQUIRE( second == std::vector<int>{ 2, 3 } );
+      }
+    }
+
+    WHEN( "an observer unsubscribes" ) {
+      state.unsubscribe(subscription);
+      state.unsubscribe(subscription);
+      state.set(2);
+
+      THEN( "only the other one is told" ) {
+        REQUIRE( first.empty() );
+        REQUIRE( second == std::vector<int>{ 2 } );
+        REQUIRE( state.observers_count() == 1 );
+      }
+    }
+
+    WHEN( "an observer is guarded by a predicate" ) {
+      std::vector<int> changes;
+      state.subscribe([&changes] (int value) { changes.push_back(value); }, std::make_shared<Changed>());
+
+      for (auto value : { 2, 2, 3, 3, 3, 2 }) state.set(value);
+
+      THEN( "it is only told about the values satisfying the predicate" ) {
+        REQUIRE( changes == std::vector<int>{ 2, 3, 2 } );
+        REQUIRE( second == std::vector<int>{ 2, 2, 3, 3, 3, 2 } );
+      }
+    }
+  }
+}
+
+SCENARIO( "a HighFrequencyState is (un)subscribed to while it is being set" ) {
+
+  GIVEN( "a state set continuously by a writer thread" ) {
+    HighFrequencyState<int> state;
+    std::atomic<bool> writing = { true };
+
+    std::thread writer([&state, &writing] {
+                         for (int i = 0; writing.load(); i++) state.set(i);
+                       });
+
+    WHEN( "observers come and go" ) {
+      bool called_after_unsubscribing = false;
+
+      for (int i = 0; i < 1000; i++) {
+        std::atomic<bool> subscribed = { true };
+
+        auto subscription = state.subscribe([&subscribed, &called_after_unsubscribing] (int) {
+                                              if (!subscribed.load()) called_after_unsubscribing = true;
+                                            });
+        std::this_thread::yield();
+
+        state.unsubscribe(subscription);
+        subscribed.store(false);
+      }
+
+      writing.store(false);
+      writer.join();
+
+      THEN( "observers are never called once unsubscribed" ) {
+        REQUIRE( !called_after_unsubscribing );
+        REQUIRE( state.observers_count() == 0 );
+      }
+    }
+  }
+}
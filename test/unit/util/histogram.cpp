@@ -0,0 +1,67 @@
+#include <catch.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "anemone/util/histogram.hpp"
+
+
+SCENARIO( "a Histogram can summarize recorded values" ) {
+
+  GIVEN( "an empty histogram" ) {
+    Histogram histogram;
+
+    THEN( "it reports nothing" ) {
+      REQUIRE( histogram.count() == 0 );
+      REQUIRE( histogram.max() == 0 );
+      REQUIRE( histogram.percentile(99) == 0 );
+    }
+
+    WHEN( "small values are recorded" ) {
+      for (std::uint64_t v = 1; v <= 10; v++) histogram.record(v);
+
+      THEN( "percentiles are exact" ) {
+        REQUIRE( histogram.count() == 10 );
+        REQUIRE( histogram.percentile(50) == 5 );
+        REQUIRE( histogram.percentile(100) == 10 );
+        REQUIRE( histogram.mean() == Approx(5.5) );
+      }
+    }
+
+    WHEN( "a wide range of values is recorded" ) {
+      for (std::uint64_t v = 1; v <= 1000000; v++) histogram.record(v * 1000);
+
+      THEN( "percentiles are within the bucket precision" ) {
+        REQUIRE( histogram.max() == 1000000000 );
+        REQUIRE( histogram.percentile(50) == Approx(500000000).epsilon(0.04) );
+        REQUIRE( histogram.percentile(99) == Approx(990000000).epsilon(0.04) );
+        REQUIRE( histogram.percentile(100) == 1000000000 );
+      }
+    }
+
+    WHEN( "values are recorded from several threads at once" ) {
+      std::vector<std::thread> threads;
+      for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&histogram] {
+                               for (int i = 0; i < 10000; i++) histogram.record(i);
+                             });
+      }
+      for (auto &thread : threads) thread.join();
+
+      THEN( "no values are lost" ) {
+        REQUIRE( histogram.count() == 40000 );
+        REQUIRE( histogram.max() == 9999 );
+      }
+    }
+
+    WHEN( "it is reset" ) {
+      histogram.record(42);
+      histogram.reset();
+
+      THEN( "it forgets everything" ) {
+        REQUIRE( histogram.count() == 0 );
+        REQUIRE( histogram.max() == 0 );
+      }
+    }
+  }
+}
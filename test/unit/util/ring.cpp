@@ -0,0 +1,115 @@
+#include <catch.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "anemone/util/ring.hpp"
+
+
+SCENARIO( "a SpscRing hands items over in order, up to its capacity" ) {
+
+  GIVEN( "a ring of 4 items" ) {
+    SpscRing<int, 4> ring;
+
+    WHEN( "it is filled past its capacity" ) {
+      std::vector<bool> pushed;
+      for (int i = 0; i < 5; i++) pushed.push_back(ring.try_push(i));
+
+      THEN( "the items past its capacity are refused" ) {
+        REQUIRE( pushed == std::vector<bool>{ true, true, true, true, false } );
+        REQUIRE( ring.size() == 4 );
+      }
+    }
+
+    WHEN( "items are pushed & popped around the ring" ) {
+      std::vector<int> popped;
+      int item;
+      for (int i = 0; i < 10; i++) {
+        ring.try_push(i);
+        if (i % 3 == 2) while (ring.try_pop(item)) popped.push_back(item);
+      }
+
+      THEN( "they come out in order" ) {
+        REQUIRE( popped == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8 } );
+        REQUIRE( ring.try_pop(item) );
+        REQUIRE( item == 9 );
+        REQUIRE( !ring.try_pop(item) );
+      }
+    }
+
+    WHEN( "the next item is peeked at" ) {
+      auto empty = ring.front() == nullptr;
+      ring.try_push(1);
+      ring.try_push(2);
+
+      THEN( "it stays in the ring until it is popped" ) {
+        int item;
+        REQUIRE( empty );
+        REQUIRE( *ring.front() == 1 );
+        REQUIRE( ring.size() == 2 );
+        REQUIRE( ring.try_pop(item) );
+        REQUIRE( item == 1 );
+        REQUIRE( *ring.front() == 2 );
+      }
+    }
+  }
+}
+
+SCENARIO( "a MpscRing hands items over from several producers" ) {
+
+  GIVEN( "a ring of move-only items" ) {
+    MpscRing<std::unique_ptr<int>, 8> ring;
+
+    WHEN( "it is filled past its capacity" ) {
+      std::vector<bool> pushed;
+      for (int i = 0; i < 9; i++) pushed.push_back(ring.try_push(std::make_unique<int>(i)));
+
+      THEN( "the items past its capacity are refused, and the others drained in order" ) {
+        REQUIRE( pushed.back() == false );
+
+        std::vector<int> drained;
+        auto consume = [&drained] (std::unique_ptr<int> item) { drained.push_back(*item); };
+
+        REQUIRE( ring.drain(consume, 5) == 5 );
+        REQUIRE( ring.drain(consume) == 3 );
+        REQUIRE( drained == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 } );
+      }
+    }
+  }
+
+  GIVEN( "a ring pushed to by 4 producers at once" ) {
+    MpscRing<int, 64> ring;
+    const int per_producer = 10000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; p++) {
+      producers.emplace_back([&ring, p] {
+                               for (int i = 0; i < per_producer; i++) {
+                                 while (!ring.try_push(p * per_producer + i)) std::this_thread::yield();
+                               }
+                             });
+    }
+
+    WHEN( "the consumer waits for & drains them" ) {
+      std::vector<int> last = { -1, -1, -1, -1 };
+      bool in_order = true;
+      int  popped   = 0;
+
+      while (popped < 4 * per_producer) {
+        ring.wait(std::chrono::milliseconds(10));
+        popped += ring.drain([&] (int item) {
+                               in_order &= item % per_producer > last[item / per_producer];
+                               last[item / per_producer] = item % per_producer;
+                             });
+      }
+      for (auto& p : producers) p.join();
+
+      THEN( "every item comes out once, in the order each producer pushed them" ) {
+        REQUIRE( popped == 4 * per_producer );
+        REQUIRE( in_order );
+        REQUIRE( last == std::vector<int>{ per_producer - 1, per_producer - 1, per_producer - 1, per_producer - 1 } );
+      }
+    }
+  }
+}
@@ -0,0 +1,118 @@
+#include <catch.hpp>
+
+#include <vector>
+#include <utility>
+
+#include "anemone/util/timing_wheel.hpp"
+
+
+SCENARIO( "a TimingWheel hands out items on the tick they are due" ) {
+
+  GIVEN( "a small wheel with items due within, and beyond, a revolution" ) {
+    TimingWheel<int, 8> wheel;
+    std::vector<std::pair<long, int>> due;
+    auto collect = [&due] (long tick, int item) { due.push_back({ tick, item }); };
+
+    wheel.schedule(3, 1);
+    wheel.schedule(11, 2);  // same slot as tick 3, one revolution later
+    wheel.schedule(5, 3);
+
+    THEN( "nothing is due before its tick" ) {
+      wheel.advance(2, collect);
+      REQUIRE( due.empty() );
+      REQUIRE( wheel.size() == 3 );
+    }
+
+    WHEN( "the wheel is advanced tick by tick" ) {
+      for (long t = 0; t <= 11; t++) wheel.advance(t, collect);
+
+      THEN( "each item is handed out on its tick, including the ones a revolution away" ) {
+        REQUIRE( due == std::vector<std::pair<long, int>>{ { 3, 1 }, { 5, 3 }, { 11, 2 } } );
+        REQUIRE( wheel.empty() );
+      }
+    }
+
+    WHEN( "the wheel jumps past several revolutions" ) {
+      wheel.advance(100, collect);
+
+      THEN( "every item which was due is handed out" ) {
+        REQUIRE( due.size() == 3 );
+        REQUIRE( wheel.empty() );
+        REQUIRE( wheel.tick() == 100 );
+      }
+    }
+
+    WHEN( "the wheel is flushed" ) {
+      wheel.advance(4, collect);
+      wheel.flush(collect);
+
+      THEN( "the pending items are handed out at once" ) {
+        REQUIRE( due.size() == 3 );
+        REQUIRE( wheel.empty() );
+      }
+    }
+
+    WHEN( "the items due on a tick are visited" ) {
+      wheel.visit(3, collect);
+
+      THEN( "only the items due on that tick are handed out, and they stay pending" ) {
+        REQUIRE( due == std::vector<std::pair<long, int>>{ { 3, 1 } } );
+        REQUIRE( wheel.size() == 3 );
+      }
+    }
+
+    WHEN( "some items are removed" ) {
+      wheel.remove_if([] (long tick, int) { return tick > 4; });
+      wheel.advance(100, collect);
+
+      THEN( "the others are still handed out" ) {
+        REQUIRE( due == std::vector<std::pair<long, int>>{ { 3, 1 } } );
+        REQUIRE( wheel.empty() );
+      }
+    }
+
+    WHEN( "an item is scheduled in the past" ) {
+      wheel.advance(6, collect);
+      wheel.schedule(2, 4);
+      wheel.advance(7, collect);
+
+      THEN( "it is due on the next tick" ) {
+        REQUIRE( due.back() == std::pair<long, int>{ 7, 4 } );
+      }
+    }
+  }
+}
+
+SCENARIO( "a TimingWheel reuses the room it was made with" ) {
+
+  GIVEN( "a wheel with room for 4 pending items" ) {
+    TimingWheel<int, 8> wheel(4);
+    std::vector<std::pair<long, int>> due;
+    auto collect = [&due] (long tick, int item) { due.push_back({ tick, item }); };
+
+    WHEN( "items are scheduled and handed out many times over" ) {
+      for (long t = 0; t < 100; t++) {
+        wheel.schedule(t + 2, static_cast<int>(t));
+        wheel.advance(t, collect);
+      }
+
+      THEN( "the room is reused, rather than grown" ) {
+        REQUIRE( wheel.capacity() == 4 );
+        REQUIRE( due.size() == 98 );
+        REQUIRE( due.back() == std::pair<long, int>{ 99, 97 } );
+      }
+    }
+
+    WHEN( "more items than there is room for are pending" ) {
+      for (int i = 0; i < 6; i++) wheel.schedule(3, i);
+      wheel.remove_if([] (long, int item) { return item == 2; });
+      wheel.advance(3, collect);
+
+      THEN( "the room grows, and the items of a tick are handed out in order" ) {
+        REQUIRE( wheel.capacity() >= 6 );
+        REQUIRE( due == std::vector<std::pair<long, int>>{ { 3, 0 }, { 3, 1 }, { 3, 3 }, { 3, 4 }, { 3, 5 } } );
+        REQUIRE( wheel.empty() );
+      }
+    }
+  }
+}